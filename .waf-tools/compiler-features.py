@@ -32,6 +32,16 @@ class B
 B<A> g_b;
 '''
 
+THREAD_LOCAL = '''
+thread_local int g_i = 0;
+
+int
+main()
+{
+  return g_i;
+}
+'''
+
 @conf
 def check_friend_typename(self):
     if self.check_cxx(msg='Checking for friend typename-specifier',
@@ -43,5 +53,13 @@ def check_friend_typename(self):
                       features='cxx', mandatory=True):
         self.define('HAVE_CXX_FRIEND_TYPENAME_WRAPPER', 1)
 
+@conf
+def check_thread_local(self):
+    if self.check_cxx(msg='Checking for thread_local storage class',
+                      fragment=THREAD_LOCAL,
+                      features='cxx cxxprogram', mandatory=False):
+        self.define('HAVE_CXX_THREAD_LOCAL', 1)
+
 def configure(conf):
     conf.check_friend_typename()
+    conf.check_thread_local()
@@ -34,15 +34,18 @@ static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
 
 Data::Data()
   : m_content(tlv::Content) // empty content
+  , m_hasDeferredFields(false)
 {
 }
 
 Data::Data(const Name& name)
   : m_name(name)
+  , m_hasDeferredFields(false)
 {
 }
 
 Data::Data(const Block& wire)
+  : m_hasDeferredFields(false)
 {
   wireDecode(wire);
 }
@@ -53,6 +56,8 @@ Data::wireEncode(EncodingImpl<T>& block, bool unsignedPortion/* = false*/) const
 {
   size_t totalLength = 0;
 
+  decodeDeferredFields();
+
   // Data ::= DATA-TLV TLV-LENGTH
   //            Name
   //            MetaInfo
@@ -131,6 +136,34 @@ Data::wireEncode() const
 
 void
 Data::wireDecode(const Block& wire)
+{
+  lazyWireDecode(wire);
+  wireDecodeDeferredFields();
+}
+
+void
+Data::wireDecodeDeferredFields() const
+{
+  // MetaInfo
+  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+
+  ///////////////
+  // Signature //
+  ///////////////
+
+  // SignatureInfo
+  m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
+
+  // SignatureValue
+  Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
+  if (val != m_wire.elements_end())
+    m_signature.setValue(*val);
+
+  m_hasDeferredFields = false;
+}
+
+void
+Data::lazyWireDecode(const Block& wire)
 {
   m_fullName.clear();
   m_wire = wire;
@@ -145,23 +178,11 @@ Data::wireDecode(const Block& wire)
   // Name
   m_name.wireDecode(m_wire.get(tlv::Name));
 
-  // MetaInfo
-  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
-
   // Content
   m_content = m_wire.get(tlv::Content);
 
-  ///////////////
-  // Signature //
-  ///////////////
-
-  // SignatureInfo
-  m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
-
-  // SignatureValue
-  Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
-  if (val != m_wire.elements_end())
-    m_signature.setValue(*val);
+  // MetaInfo and Signature are decoded by wireDecodeDeferredFields()
+  m_hasDeferredFields = true;
 }
 
 Data&
@@ -306,6 +327,7 @@ Data::onChanged()
   // !!!Note!!! Signature is not invalidated and it is responsibility of
   // the application to do proper re-signing if necessary
 
+  decodeDeferredFields();
   m_wire.reset();
   m_fullName.clear();
 }
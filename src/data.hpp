@@ -135,6 +135,35 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Decode from the wire format, deferring MetaInfo and Signature
+   *
+   * Only the top-level TLV structure, the Name and the Content are decoded immediately.
+   * MetaInfo and Signature are decoded the first time they are accessed or modified,
+   * so a malformed MetaInfo or SignatureInfo is reported by that accessor rather than
+   * by this method.
+   *
+   * This is intended for packets that are dispatched by name and may never be inspected
+   * further, such as Data received by Face.
+   *
+   * @note The deferred elements are decoded in place by const member functions as well,
+   *       such as getSignature(), wireEncode() and operator==.  A packet decoded this way
+   *       must therefore not be accessed from several threads at once, unless
+   *       decodeDeferredFields() has been called before it is shared.  Data delivered by
+   *       a Face with worker threads, and Data returned by InMemoryStorageSharded, are
+   *       fully decoded, so that these member functions do not modify them.
+   */
+  void
+  lazyWireDecode(const Block& wire);
+
+  /**
+   * @brief Decode MetaInfo and Signature if they were skipped by lazyWireDecode()
+   *
+   * Afterwards, const member functions of this packet no longer modify it.
+   */
+  void
+  decodeDeferredFields() const;
+
   /**
    * @brief Check if Data is already has wire encoding
    */
@@ -311,11 +340,15 @@ private:
   void
   onChanged();
 
+  void
+  wireDecodeDeferredFields() const;
+
 private:
   Name m_name;
-  MetaInfo m_metaInfo;
+  mutable MetaInfo m_metaInfo;
   mutable Block m_content;
-  Signature m_signature;
+  mutable Signature m_signature;
+  mutable bool m_hasDeferredFields;
 
   mutable Block m_wire;
   mutable Name m_fullName;
@@ -333,6 +366,13 @@ Data::hasWire() const
   return m_wire.hasWire();
 }
 
+inline void
+Data::decodeDeferredFields() const
+{
+  if (m_hasDeferredFields)
+    wireDecodeDeferredFields();
+}
+
 inline const Name&
 Data::getName() const
 {
@@ -342,30 +382,35 @@ Data::getName() const
 inline const MetaInfo&
 Data::getMetaInfo() const
 {
+  decodeDeferredFields();
   return m_metaInfo;
 }
 
 inline uint32_t
 Data::getContentType() const
 {
+  decodeDeferredFields();
   return m_metaInfo.getType();
 }
 
 inline const time::milliseconds&
 Data::getFreshnessPeriod() const
 {
+  decodeDeferredFields();
   return m_metaInfo.getFreshnessPeriod();
 }
 
 inline const name::Component&
 Data::getFinalBlockId() const
 {
+  decodeDeferredFields();
   return m_metaInfo.getFinalBlockId();
 }
 
 inline const Signature&
 Data::getSignature() const
 {
+  decodeDeferredFields();
   return m_signature;
 }
 
@@ -34,10 +34,16 @@
 #include "../transport/transport.hpp"
 #include "../transport/unix-transport.hpp"
 #include "../transport/tcp-transport.hpp"
+#include "../transport/udp-transport.hpp"
 
 #include "../management/nfd-controller.hpp"
 #include "../management/nfd-command-options.hpp"
 
+#include <boost/functional/hash.hpp>
+
+#include <atomic>
+#include <thread>
+
 namespace ndn {
 
 class Face::Impl : noncopyable
@@ -47,11 +53,12 @@ public:
   typedef std::list<shared_ptr<InterestFilterRecord> > InterestFilterTable;
   typedef std::list<shared_ptr<RegisteredPrefix> > RegisteredPrefixTable;
 
+  class Shard;
+
   explicit
-  Impl(Face& face)
-    : m_face(face)
-  {
-  }
+  Impl(Face& face);
+
+  ~Impl();
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -59,8 +66,18 @@ public:
   void
   satisfyPendingInterests(Data& data)
   {
-    for (PendingInterestTable::iterator i = m_pendingInterestTable.begin();
-         i != m_pendingInterestTable.end();
+    satisfyPendingInterests(m_pendingInterestTable, data);
+  }
+
+  /**
+   * @return number of satisfied pending Interests, which have been removed from @p pit
+   */
+  static size_t
+  satisfyPendingInterests(PendingInterestTable& pit, Data& data)
+  {
+    size_t nSatisfied = 0;
+    for (PendingInterestTable::iterator i = pit.begin();
+         i != pit.end();
          )
       {
         if ((*i)->getInterest()->matchesData(data))
@@ -71,8 +88,9 @@ public:
 
             PendingInterestTable::iterator next = i;
             ++next;
-            m_pendingInterestTable.erase(i);
+            pit.erase(i);
             i = next;
+            ++nSatisfied;
 
             if (static_cast<bool>(onData)) {
               onData(*interest, data);
@@ -81,6 +99,7 @@ public:
         else
           ++i;
       }
+    return nSatisfied;
   }
 
   void
@@ -117,19 +136,15 @@ public:
   {
     this->ensureConnected();
 
-    m_pendingInterestTable.push_back(make_shared<PendingInterest>(interest, onData, onTimeout));
+    shared_ptr<PendingInterest> entry = make_shared<PendingInterest>(interest, onData, onTimeout);
+    bool isAggregated = m_isInterestAggregationEnabled &&
+                        isCoveredByPendingInterest(m_pendingInterestTable, *entry);
+    m_pendingInterestTable.push_back(entry);
 
-    if (!interest->getLocalControlHeader().empty(false, true))
-      {
-        // encode only NextHopFaceId towards the forwarder
-        m_face.m_transport->send(interest->getLocalControlHeader()
-                                   .wireEncode(*interest, false, true),
-                                 interest->wireEncode());
-      }
-    else
-      {
-        m_face.m_transport->send(interest->wireEncode());
-      }
+    if (!isAggregated) {
+      entry->markSent();
+      sendInterest(*interest);
+    }
 
     if (!m_pitTimeoutCheckTimerActive) {
       m_pitTimeoutCheckTimerActive = true;
@@ -138,6 +153,56 @@ public:
     }
   }
 
+  /**
+   * @brief Check whether an Interest sent earlier makes sending the Interest of @p entry
+   *        unnecessary
+   *
+   * That is the case if @p pit has an entry whose Interest was sent to the forwarder, with
+   * the same Name, Selectors, Scope and NextHopFaceId, that does not time out before
+   * @p entry.  The forwarder then keeps a PIT entry for that Interest about as long, and
+   * the Data that satisfies it also satisfies @p entry.
+   *
+   * Timeouts are only checked every 100 ms, so an entry that times out less than that
+   * before @p entry is considered to cover it; otherwise identical Interests with the same
+   * lifetime, expressed one after the other, would never be aggregated.  Entries that were
+   * aggregated themselves are not considered, so this tolerance does not add up along a
+   * stream of such Interests.
+   */
+  static bool
+  isCoveredByPendingInterest(const PendingInterestTable& pit, const PendingInterest& entry)
+  {
+    time::steady_clock::TimePoint expiration = entry.getExpirationTime() -
+                                               time::milliseconds(100);
+    const Interest& interest = *entry.getInterest();
+    for (const shared_ptr<PendingInterest>& other : pit) {
+      const Interest& otherInterest = *other->getInterest();
+      if (other->isSent() &&
+          other->getExpirationTime() > expiration &&
+          otherInterest.getName() == interest.getName() &&
+          otherInterest.getScope() == interest.getScope() &&
+          otherInterest.getNextHopFaceId() == interest.getNextHopFaceId() &&
+          otherInterest.getSelectors() == interest.getSelectors())
+        return true;
+    }
+    return false;
+  }
+
+  void
+  sendInterest(const Interest& interest)
+  {
+    if (!interest.getLocalControlHeader().empty(false, true))
+      {
+        // encode only NextHopFaceId towards the forwarder
+        m_face.m_transport->send(interest.getLocalControlHeader()
+                                   .wireEncode(interest, false, true),
+                                 interest.wireEncode());
+      }
+    else
+      {
+        m_face.m_transport->send(interest.wireEncode());
+      }
+  }
+
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
@@ -166,12 +231,22 @@ public:
   void
   asyncSetInterestFilter(const shared_ptr<InterestFilterRecord>& interestFilterRecord)
   {
+    if (isSharded()) {
+      setShardedInterestFilter(interestFilterRecord);
+      return;
+    }
+
     m_interestFilterTable.push_back(interestFilterRecord);
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
+    if (isSharded()) {
+      unsetShardedInterestFilter(interestFilterId);
+      return;
+    }
+
     InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
                                                    m_interestFilterTable.end(),
                                                    MatchInterestFilterId(interestFilterId));
@@ -233,6 +308,84 @@ public:
     return reinterpret_cast<const RegisteredPrefixId*>(prefixToRegister.get());
   }
 
+  std::vector<const RegisteredPrefixId*>
+  registerPrefixes(const std::vector<Name>& prefixes,
+                   const RegisterPrefixSuccessCallback& onSuccess,
+                   const RegisterPrefixFailureCallback& onFailure,
+                   uint64_t flags,
+                   const nfd::CommandOptions& options)
+  {
+    using namespace nfd;
+
+    typedef void (Controller::*Registrator)
+      (const ControlParameters&,
+       const Controller::CommandSucceedCallback&,
+       const Controller::CommandFailCallback&,
+       const CommandOptions&);
+
+    typedef void (Controller::*BatchRegistrator)
+      (const std::vector<ControlParameters>&,
+       const Controller::BatchCommandSucceedCallback&,
+       const Controller::BatchCommandFailCallback&,
+       const CommandOptions&);
+
+    BatchRegistrator registrator;
+    Registrator unregistrator;
+    if (!m_face.m_isDirectNfdFibManagementRequested) {
+      registrator = static_cast<BatchRegistrator>(&Controller::startBatch<RibRegisterCommand>);
+      unregistrator = static_cast<Registrator>(&Controller::start<RibUnregisterCommand>);
+    }
+    else {
+      registrator = static_cast<BatchRegistrator>(&Controller::startBatch<FibAddNextHopCommand>);
+      unregistrator = static_cast<Registrator>(&Controller::start<FibRemoveNextHopCommand>);
+    }
+
+    std::vector<ControlParameters> registerParametersList;
+    registerParametersList.reserve(prefixes.size());
+    shared_ptr<std::vector<shared_ptr<RegisteredPrefix>>> prefixesToRegister =
+      make_shared<std::vector<shared_ptr<RegisteredPrefix>>>();
+    prefixesToRegister->reserve(prefixes.size());
+    std::vector<const RegisteredPrefixId*> registeredPrefixIds;
+    registeredPrefixIds.reserve(prefixes.size());
+
+    for (const Name& prefix : prefixes) {
+      ControlParameters registerParameters, unregisterParameters;
+      registerParameters.setName(prefix);
+      unregisterParameters.setName(prefix);
+      if (!m_face.m_isDirectNfdFibManagementRequested) {
+        registerParameters.setFlags(flags);
+      }
+      registerParametersList.push_back(registerParameters);
+
+      RegisteredPrefix::Unregistrator bindedUnregistrator =
+        std::bind(unregistrator, m_face.m_nfdController, unregisterParameters, _1, _2,
+                  options);
+      // @todo get rid of "std::" after #2109
+
+      shared_ptr<RegisteredPrefix> prefixToRegister =
+        make_shared<RegisteredPrefix>(prefix, shared_ptr<InterestFilterRecord>(),
+                                      bindedUnregistrator);
+      prefixesToRegister->push_back(prefixToRegister);
+      registeredPrefixIds.push_back(
+        reinterpret_cast<const RegisteredPrefixId*>(prefixToRegister.get()));
+    }
+
+    Controller::BatchCommandSucceedCallback afterRegistered =
+      [this, prefixesToRegister, onSuccess] (size_t index, const ControlParameters&) {
+        this->afterPrefixRegistered((*prefixesToRegister)[index], onSuccess);
+      };
+    Controller::BatchCommandFailCallback afterFailed =
+      [prefixesToRegister, onFailure] (size_t index, uint32_t, const std::string& reason) {
+        if (static_cast<bool>(onFailure))
+          onFailure((*prefixesToRegister)[index]->getPrefix(), reason);
+      };
+
+    ((*m_face.m_nfdController).*registrator)(registerParametersList,
+                                             afterRegistered, afterFailed, options);
+
+    return registeredPrefixIds;
+  }
+
   void
   afterPrefixRegistered(const shared_ptr<RegisteredPrefix>& registeredPrefix,
                         const RegisterPrefixSuccessCallback& onSuccess)
@@ -241,7 +394,7 @@ public:
 
     if (static_cast<bool>(registeredPrefix->getFilter())) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      asyncSetInterestFilter(registeredPrefix->getFilter());
     }
 
     if (static_cast<bool>(onSuccess)) {
@@ -263,7 +416,7 @@ public:
         if (static_cast<bool>(filter))
           {
             // it was a combined operation
-            m_interestFilterTable.remove(filter);
+            asyncUnsetInterestFilter(reinterpret_cast<const InterestFilterId*>(filter.get()));
           }
 
         (*i)->unregister(bind(&Impl::finalizeUnregisterPrefix, this, i, onSuccess),
@@ -284,13 +437,7 @@ public:
   {
     m_registeredPrefixTable.erase(item);
 
-    if (!m_pitTimeoutCheckTimerActive && m_registeredPrefixTable.empty())
-      {
-        m_face.m_transport->pause();
-        if (!m_ioServiceWork) {
-          m_processEventsTimeoutTimer->cancel();
-        }
-      }
+    pauseIfIdle();
 
     if (static_cast<bool>(onSuccess)) {
       onSuccess();
@@ -302,40 +449,145 @@ public:
 
   void
   checkPitExpire()
+  {
+    expirePendingInterests(m_pendingInterestTable);
+
+    if (!m_pendingInterestTable.empty()) {
+      m_pitTimeoutCheckTimerActive = true;
+
+      m_pitTimeoutCheckTimer->expires_from_now(time::milliseconds(100));
+      m_pitTimeoutCheckTimer->async_wait(bind(&Impl::checkPitExpire, this));
+    }
+    else {
+      m_pitTimeoutCheckTimerActive = false;
+      pauseIfIdle();
+    }
+  }
+
+  /**
+   * @brief Remove timed out entries from @p pit and call their timeout callbacks
+   * @return number of removed entries
+   */
+  static size_t
+  expirePendingInterests(PendingInterestTable& pit)
   {
     // Check for PIT entry timeouts.
     time::steady_clock::TimePoint now = time::steady_clock::now();
 
-    PendingInterestTable::iterator i = m_pendingInterestTable.begin();
-    while (i != m_pendingInterestTable.end())
+    size_t nExpired = 0;
+    PendingInterestTable::iterator i = pit.begin();
+    while (i != pit.end())
       {
         if ((*i)->isTimedOut(now))
           {
             // Save the PendingInterest and remove it from the PIT.  Then call the callback.
             shared_ptr<PendingInterest> pendingInterest = *i;
 
-            i = m_pendingInterestTable.erase(i);
+            i = pit.erase(i);
+            ++nExpired;
 
             pendingInterest->callTimeout();
           }
         else
           ++i;
       }
+    return nExpired;
+  }
 
-    if (!m_pendingInterestTable.empty()) {
-      m_pitTimeoutCheckTimerActive = true;
+  /**
+   * @brief Pause the transport, and let processEvents() return, if no more packets are expected
+   */
+  void
+  pauseIfIdle()
+  {
+    if (m_pitTimeoutCheckTimerActive || m_nShardedPendingInterests > 0 ||
+        !m_registeredPrefixTable.empty())
+      return;
 
-      m_pitTimeoutCheckTimer->expires_from_now(time::milliseconds(100));
-      m_pitTimeoutCheckTimer->async_wait(bind(&Impl::checkPitExpire, this));
+    m_face.m_transport->pause();
+    if (!m_ioServiceWork) {
+      m_processEventsTimeoutTimer->cancel();
     }
-    else {
-      m_pitTimeoutCheckTimerActive = false;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////////////////////
+
+  bool
+  isSharded() const
+  {
+    return !m_shards.empty();
+  }
 
-      if (m_registeredPrefixTable.empty()) {
-        m_face.m_transport->pause();
-        if (!m_ioServiceWork) {
-          m_processEventsTimeoutTimer->cancel();
-        }
+  void
+  startWorkers(size_t nWorkers, size_t nShards, size_t prefixLength);
+
+  void
+  stopWorkers();
+
+  /**
+   * @brief Select the shard of an Interest or InterestFilter
+   *
+   * The shard is chosen by the hash of the first m_shardPrefixLength components, which is
+   * also the hash of the corresponding prefix in the sense of std::hash<Name>.
+   */
+  size_t
+  getShardIndex(const Name& name) const
+  {
+    std::hash<name::Component> hashComponent;
+    size_t seed = 0;
+    size_t length = std::min(name.size(), m_shardPrefixLength);
+    for (size_t i = 0; i < length; ++i) {
+      boost::hash_combine(seed, hashComponent(name.get(i)));
+    }
+    return seed % m_shards.size();
+  }
+
+  void
+  expressShardedInterest(const shared_ptr<const Interest>& interest,
+                         const OnData& onData, const OnTimeout& onTimeout);
+
+  void
+  asyncSendInterest(const shared_ptr<const Interest>& interest)
+  {
+    this->ensureConnected();
+    sendInterest(*interest);
+  }
+
+  void
+  removeShardedPendingInterest(const PendingInterestId* pendingInterestId);
+
+  void
+  setShardedInterestFilter(const shared_ptr<InterestFilterRecord>& interestFilterRecord);
+
+  void
+  unsetShardedInterestFilter(const InterestFilterId* interestFilterId);
+
+  void
+  dispatchInterest(const shared_ptr<Interest>& interest);
+
+  void
+  dispatchData(const shared_ptr<Data>& data);
+
+  /**
+   * @brief Drop the pending Interests of all shards, like on shutdown of a single-threaded Face
+   */
+  void
+  clearShards();
+
+private:
+  void
+  runWorker()
+  {
+    for (;;) {
+      try {
+        m_workerIoService->run();
+        return;
+      }
+      catch (...) {
+        // report the failure to the application through processEvents()
+        std::exception_ptr exception = std::current_exception();
+        m_face.m_ioService.post([exception] { std::rethrow_exception(exception); });
       }
     }
   }
@@ -354,9 +606,336 @@ private:
   bool m_pitTimeoutCheckTimerActive;
   shared_ptr<monotonic_deadline_timer> m_processEventsTimeoutTimer;
 
+  // multi-threaded dispatch, see Face::startWorkers
+  unique_ptr<boost::asio::io_service> m_workerIoService;
+  unique_ptr<boost::asio::io_service::work> m_workerIoServiceWork;
+  std::vector<unique_ptr<Shard>> m_shards;
+  std::vector<std::thread> m_workers;
+  size_t m_shardPrefixLength;
+  std::atomic<size_t> m_nShardedPendingInterests;
+
+  bool m_isInterestAggregationEnabled;
+
   friend class Face;
 };
 
+/**
+ * @brief Part of the pending Interest and InterestFilter tables, processed by one strand
+ *
+ * Except for the constructor, all methods must be invoked through the strand.
+ */
+class Face::Impl::Shard : noncopyable
+{
+public:
+  Shard(Impl& impl, boost::asio::io_service& ioService)
+    : m_impl(impl)
+    , m_strand(ioService)
+    , m_pitTimeoutCheckTimer(ioService)
+    , m_isPitTimeoutCheckTimerActive(false)
+  {
+  }
+
+  boost::asio::io_service::strand&
+  getStrand()
+  {
+    return m_strand;
+  }
+
+  void
+  addPendingInterest(const shared_ptr<PendingInterest>& pendingInterest)
+  {
+    m_pendingInterestTable.push_back(pendingInterest);
+
+    if (!m_isPitTimeoutCheckTimerActive) {
+      m_isPitTimeoutCheckTimerActive = true;
+      m_pitTimeoutCheckTimer.expires_from_now(time::milliseconds(100));
+      m_pitTimeoutCheckTimer.async_wait(m_strand.wrap(bind(&Shard::checkPitExpire, this, _1)));
+    }
+  }
+
+  /**
+   * @brief Add @p pendingInterest, and send its Interest unless an Interest sent earlier
+   *        covers it
+   */
+  void
+  aggregatePendingInterest(const shared_ptr<PendingInterest>& pendingInterest)
+  {
+    bool isAggregated = Impl::isCoveredByPendingInterest(m_pendingInterestTable,
+                                                         *pendingInterest);
+    addPendingInterest(pendingInterest);
+
+    if (!isAggregated) {
+      pendingInterest->markSent();
+      m_impl.m_face.m_ioService.post(bind(&Impl::asyncSendInterest, &m_impl,
+                                          pendingInterest->getInterest()));
+    }
+  }
+
+  void
+  removePendingInterest(const PendingInterestId* pendingInterestId)
+  {
+    size_t nBefore = m_pendingInterestTable.size();
+    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    onPendingInterestsRemoved(nBefore - m_pendingInterestTable.size());
+  }
+
+  void
+  satisfyPendingInterests(const shared_ptr<Data>& data)
+  {
+    onPendingInterestsRemoved(Impl::satisfyPendingInterests(m_pendingInterestTable, *data));
+  }
+
+  void
+  addInterestFilter(const InterestFilterId* interestFilterId,
+                    const shared_ptr<InterestFilterRecord>& interestFilterRecord)
+  {
+    m_interestFilterTable.push_back(std::make_pair(interestFilterId, interestFilterRecord));
+  }
+
+  void
+  removeInterestFilter(const InterestFilterId* interestFilterId)
+  {
+    for (InterestFilterTable::iterator i = m_interestFilterTable.begin();
+         i != m_interestFilterTable.end(); ++i) {
+      if (i->first == interestFilterId) {
+        m_interestFilterTable.erase(i);
+        return;
+      }
+    }
+  }
+
+  void
+  processInterestFilters(const shared_ptr<Interest>& interest)
+  {
+    for (const auto& entry : m_interestFilterTable) {
+      if (entry.second->doesMatch(interest->getName())) {
+        (*entry.second)(*interest);
+      }
+    }
+  }
+
+  /**
+   * @brief Drop all pending Interests without invoking their callbacks
+   *
+   * InterestFilters are kept, as in the pending Interest table of Face::Impl.
+   */
+  void
+  clearPendingInterests()
+  {
+    m_pitTimeoutCheckTimer.cancel();
+    m_isPitTimeoutCheckTimerActive = false;
+
+    size_t nPendingInterests = m_pendingInterestTable.size();
+    m_pendingInterestTable.clear();
+    onPendingInterestsRemoved(nPendingInterests);
+  }
+
+private:
+  void
+  checkPitExpire(const boost::system::error_code& error)
+  {
+    if (error) // cancelled
+      return;
+
+    onPendingInterestsRemoved(Impl::expirePendingInterests(m_pendingInterestTable));
+
+    if (!m_pendingInterestTable.empty()) {
+      m_pitTimeoutCheckTimer.expires_from_now(time::milliseconds(100));
+      m_pitTimeoutCheckTimer.async_wait(m_strand.wrap(bind(&Shard::checkPitExpire, this, _1)));
+    }
+    else {
+      m_isPitTimeoutCheckTimerActive = false;
+    }
+  }
+
+  void
+  onPendingInterestsRemoved(size_t nRemoved)
+  {
+    if (nRemoved > 0 && m_impl.m_nShardedPendingInterests.fetch_sub(nRemoved) == nRemoved) {
+      m_impl.m_face.m_ioService.post(bind(&Impl::pauseIfIdle, &m_impl));
+    }
+  }
+
+private:
+  typedef std::list<std::pair<const InterestFilterId*,
+                              shared_ptr<InterestFilterRecord>>> InterestFilterTable;
+
+  Impl& m_impl;
+  boost::asio::io_service::strand m_strand;
+
+  PendingInterestTable m_pendingInterestTable;
+  InterestFilterTable m_interestFilterTable;
+
+  monotonic_deadline_timer m_pitTimeoutCheckTimer;
+  bool m_isPitTimeoutCheckTimerActive;
+};
+
+inline
+Face::Impl::Impl(Face& face)
+  : m_face(face)
+  , m_shardPrefixLength(0)
+  , m_nShardedPendingInterests(0)
+  , m_isInterestAggregationEnabled(false)
+{
+}
+
+inline
+Face::Impl::~Impl()
+{
+  stopWorkers();
+}
+
+inline void
+Face::Impl::startWorkers(size_t nWorkers, size_t nShards, size_t prefixLength)
+{
+  if (isSharded())
+    throw Error("Worker threads are already started");
+  if (nWorkers == 0 || nShards == 0)
+    throw Error("Number of worker threads and of shards must be positive");
+
+  m_workerIoService.reset(new boost::asio::io_service());
+  m_workerIoServiceWork.reset(new boost::asio::io_service::work(*m_workerIoService));
+
+  m_shardPrefixLength = prefixLength;
+  for (size_t i = 0; i < nShards; ++i) {
+    m_shards.push_back(unique_ptr<Shard>(new Shard(*this, *m_workerIoService)));
+  }
+
+  for (size_t i = 0; i < nWorkers; ++i) {
+    m_workers.push_back(std::thread(&Impl::runWorker, this));
+  }
+}
+
+inline void
+Face::Impl::stopWorkers()
+{
+  if (m_workers.empty())
+    return;
+
+  m_workerIoServiceWork.reset();
+  m_workerIoService->stop();
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+  m_workers.clear();
+}
+
+inline void
+Face::Impl::expressShardedInterest(const shared_ptr<const Interest>& interest,
+                                   const OnData& onData, const OnTimeout& onTimeout)
+{
+  ++m_nShardedPendingInterests;
+
+  // the entry is queued on the strand before the Interest is sent, so it is in place
+  // before any Data for it can be dispatched to the shard
+  Shard& shard = *m_shards[getShardIndex(interest->getName())];
+  shared_ptr<PendingInterest> entry = make_shared<PendingInterest>(interest, onData, onTimeout);
+
+  if (m_isInterestAggregationEnabled) {
+    // identical Interests are in the same shard, which decides whether to send this one
+    shard.getStrand().post(bind(&Shard::aggregatePendingInterest, &shard, entry));
+    return;
+  }
+
+  shard.getStrand().post(bind(&Shard::addPendingInterest, &shard, entry));
+  m_face.m_ioService.dispatch(bind(&Impl::asyncSendInterest, this, interest));
+}
+
+inline void
+Face::Impl::removeShardedPendingInterest(const PendingInterestId* pendingInterestId)
+{
+  for (unique_ptr<Shard>& shard : m_shards) {
+    shard->getStrand().post(bind(&Shard::removePendingInterest, shard.get(), pendingInterestId));
+  }
+}
+
+inline void
+Face::Impl::setShardedInterestFilter(const shared_ptr<InterestFilterRecord>& interestFilterRecord)
+{
+  const InterestFilterId* interestFilterId =
+    reinterpret_cast<const InterestFilterId*>(interestFilterRecord.get());
+  const Name& prefix = interestFilterRecord->getFilter().getPrefix();
+
+  if (prefix.size() >= m_shardPrefixLength) {
+    Shard& shard = *m_shards[getShardIndex(prefix)];
+    shard.getStrand().post(bind(&Shard::addInterestFilter, &shard,
+                                interestFilterId, interestFilterRecord));
+    return;
+  }
+
+  // Interests of any shard can match a filter that is shorter than the shard prefix
+  for (unique_ptr<Shard>& shard : m_shards) {
+    shard->getStrand().post(bind(&Shard::addInterestFilter, shard.get(), interestFilterId,
+                                 interestFilterRecord->makeThreadLocalCopy()));
+  }
+}
+
+inline void
+Face::Impl::unsetShardedInterestFilter(const InterestFilterId* interestFilterId)
+{
+  for (unique_ptr<Shard>& shard : m_shards) {
+    shard->getStrand().post(bind(&Shard::removeInterestFilter, shard.get(), interestFilterId));
+  }
+}
+
+inline void
+Face::Impl::dispatchInterest(const shared_ptr<Interest>& interest)
+{
+  Shard& shard = *m_shards[getShardIndex(interest->getName())];
+  shard.getStrand().post(bind(&Shard::processInterestFilters, &shard, interest));
+}
+
+inline void
+Face::Impl::dispatchData(const shared_ptr<Data>& data)
+{
+  // Data can satisfy Interests in the shard of each of its prefixes up to the shard prefix
+  // length; an Interest shorter than that is in the shard of its whole name
+  const Name& name = data->getName();
+  size_t length = std::min(name.size(), m_shardPrefixLength);
+
+  std::vector<size_t> shardIndices;
+  shardIndices.reserve(length + 2);
+  std::hash<name::Component> hashComponent;
+  size_t seed = 0;
+  for (size_t i = 0; ; ++i) {
+    size_t index = seed % m_shards.size();
+    if (std::find(shardIndices.begin(), shardIndices.end(), index) == shardIndices.end())
+      shardIndices.push_back(index);
+    if (i == length)
+      break;
+    boost::hash_combine(seed, hashComponent(name.get(i)));
+  }
+  if (name.size() < m_shardPrefixLength) {
+    // an Interest for the full name ends with the implicit digest component
+    boost::hash_combine(seed, hashComponent(data->getFullName().get(-1)));
+    size_t index = seed % m_shards.size();
+    if (std::find(shardIndices.begin(), shardIndices.end(), index) == shardIndices.end())
+      shardIndices.push_back(index);
+  }
+
+  // each shard gets its own copy, because callbacks receive a mutable Data, and lazily
+  // decoded fields are materialized on first access; copies are made before any shard
+  // can touch the original
+  std::vector<shared_ptr<Data>> copies(shardIndices.size());
+  copies[0] = data;
+  for (size_t i = 1; i < copies.size(); ++i) {
+    copies[i] = make_shared<Data>(*data);
+  }
+
+  for (size_t i = 0; i < shardIndices.size(); ++i) {
+    Shard& shard = *m_shards[shardIndices[i]];
+    shard.getStrand().post(bind(&Shard::satisfyPendingInterests, &shard, copies[i]));
+  }
+}
+
+inline void
+Face::Impl::clearShards()
+{
+  for (unique_ptr<Shard>& shard : m_shards) {
+    shard->getStrand().post(bind(&Shard::clearPendingInterests, shard.get()));
+  }
+}
+
 } // namespace ndn
 
 #endif // NDN_DETAIL_FACE_IMPL_HPP
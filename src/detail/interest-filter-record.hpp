@@ -25,6 +25,7 @@
 #include "../common.hpp"
 #include "../name.hpp"
 #include "../interest.hpp"
+#include "../util/regex/regex-pattern-list-matcher.hpp"
 
 namespace ndn {
 
@@ -61,6 +62,23 @@ public:
     return m_filter;
   }
 
+  /**
+   * @brief Create a record with the same filter and callback that can be used on another thread
+   *
+   * A regular expression matcher keeps the state of the last match, so the copy gets its own
+   * matcher instead of sharing it with this record.
+   */
+  shared_ptr<InterestFilterRecord>
+  makeThreadLocalCopy() const
+  {
+    if (!m_filter.hasRegexFilter())
+      return make_shared<InterestFilterRecord>(m_filter, m_onInterest);
+
+    return make_shared<InterestFilterRecord>(InterestFilter(m_filter.getPrefix(),
+                                                            m_filter.getRegexFilter().getExpr()),
+                                             m_onInterest);
+  }
+
 private:
   InterestFilter m_filter;
   OnInterest m_onInterest;
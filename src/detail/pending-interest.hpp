@@ -49,6 +49,7 @@ public:
     : m_interest(interest)
     , m_onData(onData)
     , m_onTimeout(onTimeout)
+    , m_isSent(false)
   {
     if (m_interest->getInterestLifetime() >= time::milliseconds::zero())
       m_timeout = time::steady_clock::now() + m_interest->getInterestLifetime();
@@ -68,6 +69,31 @@ public:
     return m_onData;
   }
 
+  /**
+   * @brief Get the time when this interest times out
+   */
+  const time::steady_clock::TimePoint&
+  getExpirationTime() const
+  {
+    return m_timeout;
+  }
+
+  /**
+   * @brief Record that the interest was sent to the forwarder, rather than aggregated
+   *        with an interest sent earlier
+   */
+  void
+  markSent()
+  {
+    m_isSent = true;
+  }
+
+  bool
+  isSent() const
+  {
+    return m_isSent;
+  }
+
   /**
    * Check if this interest is timed out.
    * @return true if this interest timed out, otherwise false.
@@ -94,6 +120,7 @@ private:
   const OnData m_onData;
   const OnTimeout m_onTimeout;
   time::steady_clock::TimePoint m_timeout;
+  bool m_isSent;
 };
 
 
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-stream-reader.hpp"
+
+#include <algorithm>
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+
+const size_t BlockStreamReader::DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+/** @brief maximum size of TLV-TYPE and TLV-LENGTH together
+ */
+static const size_t MAX_SIZE_OF_TLV_HEADER = 18;
+
+BlockStreamReader::BlockStreamReader(std::istream& is, size_t chunkSize)
+  : m_is(is)
+  , m_chunkSize(chunkSize)
+  , m_buffer(make_shared<Buffer>())
+  , m_offset(0)
+{
+  if (m_chunkSize == 0) {
+    throw std::invalid_argument("chunkSize must be positive");
+  }
+}
+
+bool
+BlockStreamReader::read(Block& block)
+{
+  while (true) {
+    Buffer::const_iterator begin = m_buffer->begin() + m_offset;
+    Buffer::const_iterator valueBegin = begin;
+    size_t nAvailable = m_buffer->size() - m_offset;
+    size_t nRequired = nAvailable + 1;
+
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (tlv::readType(valueBegin, m_buffer->cend(), type) &&
+        tlv::readVarNumber(valueBegin, m_buffer->cend(), length)) {
+      size_t headerSize = valueBegin - begin;
+      if (length > m_chunkSize - std::min(headerSize, m_chunkSize)) {
+        throw Error("TLV block is larger than the chunk size (" +
+                    boost::lexical_cast<std::string>(m_chunkSize) + " octets)");
+      }
+
+      if (length <= static_cast<uint64_t>(m_buffer->cend() - valueBegin)) {
+        Buffer::const_iterator valueEnd = valueBegin + length;
+        block = Block(m_buffer, type, begin, valueEnd, valueBegin, valueEnd);
+        m_offset += headerSize + length;
+        return true;
+      }
+      nRequired = headerSize + length;
+    }
+    else if (nAvailable >= MAX_SIZE_OF_TLV_HEADER) {
+      throw Error("Malformed TLV header");
+    }
+
+    if (!fill(nRequired)) {
+      if (m_offset == m_buffer->size()) {
+        return false;
+      }
+      throw Error("Stream ended in the middle of a TLV block");
+    }
+  }
+}
+
+bool
+BlockStreamReader::fill(size_t nRequired)
+{
+  size_t nLeftover = m_buffer->size() - m_offset;
+  if (!m_is.good()) {
+    return nLeftover >= nRequired;
+  }
+
+  // the current chunk may still be referenced by returned blocks, so it is never modified
+  BufferPtr chunk = make_shared<Buffer>(std::max(m_chunkSize, nRequired));
+  std::copy(m_buffer->begin() + m_offset, m_buffer->end(), chunk->begin());
+
+  m_is.read(reinterpret_cast<char*>(chunk->buf()) + nLeftover, chunk->size() - nLeftover);
+  size_t nTotal = nLeftover + static_cast<size_t>(m_is.gcount());
+  chunk->resize(nTotal);
+  if (nTotal < chunk->capacity() / 2) {
+    // don't pin a mostly empty chunk in memory through the blocks of a short stream
+    chunk->shrink_to_fit();
+  }
+
+  m_buffer = chunk;
+  m_offset = 0;
+  return nTotal >= nRequired;
+}
+
+} // namespace ndn
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_STREAM_READER_HPP
+#define NDN_ENCODING_BLOCK_STREAM_READER_HPP
+
+#include "../common.hpp"
+
+#include "block.hpp"
+
+#include <istream>
+
+namespace ndn {
+
+/** @brief Reads a sequence of TLV blocks from an input stream
+ *
+ *  The stream is consumed in large chunks, and every Block returned by read() references
+ *  the chunk it was found in, so no per-block copy or allocation takes place.  Only the
+ *  incomplete tail of a chunk is copied into the next one.
+ *
+ *  A chunk stays allocated as long as any Block referencing it is alive.  A caller that
+ *  retains a few small blocks out of a large trace should copy them into their own buffers.
+ */
+class BlockStreamReader : noncopyable
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : tlv::Error(what)
+    {
+    }
+  };
+
+  /** @brief Create a reader over @p is
+   *  @param is input stream, which should be opened in binary mode
+   *  @param chunkSize size of each read from @p is; this is also the maximum size of a block
+   *  @throw std::invalid_argument @p chunkSize is zero
+   */
+  explicit
+  BlockStreamReader(std::istream& is, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+  /** @brief Read the next block from the stream
+   *  @return true if @p block has been assigned,
+   *          false if the stream has ended at a block boundary
+   *  @throw Error the stream ends in the middle of a block,
+   *               or a block is malformed or larger than the chunk size
+   */
+  bool
+  read(Block& block);
+
+public:
+  static const size_t DEFAULT_CHUNK_SIZE;
+
+private:
+  /** @brief Start a new chunk, carrying over the unconsumed bytes of the current one
+   *  @return whether at least @p nRequired bytes are available afterwards
+   */
+  bool
+  fill(size_t nRequired);
+
+private:
+  std::istream& m_is;
+  size_t m_chunkSize;
+  BufferPtr m_buffer;
+  size_t m_offset;
+};
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_STREAM_READER_HPP
@@ -175,6 +175,14 @@ public: // wire format
   size_t
   size() const;
 
+  /** @brief Get the buffer that holds the wire encoding
+   *
+   *  Blocks that refer to parts of this buffer, such as sub-elements, can be created with
+   *  the constructor that takes explicit boundaries, without copying.
+   */
+  const ConstBufferPtr&
+  getBuffer() const;
+
 public: // type and value
   uint32_t
   type() const;
@@ -316,6 +324,12 @@ Block::wire() const
   return &*m_begin;
 }
 
+inline const ConstBufferPtr&
+Block::getBuffer() const
+{
+  return m_buffer;
+}
+
 inline size_t
 Block::size() const
 {
@@ -22,6 +22,7 @@
 #ifndef NDN_ENCODING_TLV_HPP
 #define NDN_ENCODING_TLV_HPP
 
+#include <cstring>
 #include <stdexcept>
 #include <iostream>
 #include <iterator>
@@ -188,6 +189,15 @@ sizeOfVarNumber(uint64_t varNumber);
 inline size_t
 writeVarNumber(std::ostream& os, uint64_t varNumber);
 
+/**
+ * @brief Write VAR-NUMBER to the specified memory location
+ *
+ * @param buffer must have room for sizeOfVarNumber(varNumber) octets
+ * @return number of octets written
+ */
+inline size_t
+writeVarNumber(uint8_t* buffer, uint64_t varNumber);
+
 /**
  * @brief Read nonNegativeInteger in NDN-TLV encoding
  *
@@ -414,6 +424,33 @@ writeVarNumber(std::ostream& os, uint64_t varNumber)
   }
 }
 
+inline size_t
+writeVarNumber(uint8_t* buffer, uint64_t varNumber)
+{
+  if (varNumber < 253) {
+    buffer[0] = static_cast<uint8_t>(varNumber);
+    return 1;
+  }
+  else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
+    buffer[0] = 253;
+    uint16_t value = htobe16(static_cast<uint16_t>(varNumber));
+    std::memcpy(buffer + 1, &value, 2);
+    return 3;
+  }
+  else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
+    buffer[0] = 254;
+    uint32_t value = htobe32(static_cast<uint32_t>(varNumber));
+    std::memcpy(buffer + 1, &value, 4);
+    return 5;
+  }
+  else {
+    buffer[0] = 255;
+    uint64_t value = htobe64(varNumber);
+    std::memcpy(buffer + 1, &value, 8);
+    return 9;
+  }
+}
+
 template<class InputIterator>
 inline uint64_t
 readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end)
@@ -24,6 +24,8 @@
 #include "exclude.hpp"
 #include "util/concepts.hpp"
 
+#include <algorithm>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Exclude>));
@@ -54,7 +56,7 @@ Exclude::wireEncode(EncodingImpl<T>& block) const
   // Exclude ::= EXCLUDE-TYPE TLV-LENGTH Any? (NameComponent (Any)?)+
   // Any     ::= ANY-TYPE TLV-LENGTH(=0)
 
-  for (Exclude::const_iterator i = m_exclude.begin(); i != m_exclude.end(); i++)
+  for (Exclude::const_iterator i = begin(); i != end(); i++)
     {
       if (i->second)
         {
@@ -111,6 +113,8 @@ Exclude::wireDecode(const Block& wire)
   // Exclude ::= EXCLUDE-TYPE TLV-LENGTH Any? (NameComponent (Any)?)+
   // Any     ::= ANY-TYPE TLV-LENGTH(=0)
 
+  m_exclude.reserve(m_wire.elements_size());
+
   Block::element_const_iterator i = m_wire.elements_begin();
   if (i->type() == tlv::Any)
     {
@@ -123,7 +127,7 @@ Exclude::wireDecode(const Block& wire)
       if (i->type() != tlv::NameComponent)
         throw Error("Incorrect format of Exclude filter");
 
-      name::Component excludedComponent(i->value(), i->value_size());
+      name::Component excludedComponent(*i);
       ++i;
 
       if (i != m_wire.elements_end())
@@ -145,31 +149,61 @@ Exclude::wireDecode(const Block& wire)
     }
 }
 
+void
+Exclude::appendExclude(const name::Component& name, bool any)
+{
+  if (m_exclude.empty() || m_exclude.back().first < name) {
+    m_exclude.push_back(std::make_pair(name, any));
+    return;
+  }
+
+  size_t pos = findLowerBound(name);
+  if (pos != m_exclude.size() && m_exclude[pos].first == name) {
+    m_exclude[pos].second = any;
+  }
+  else {
+    size_t insertPos = pos == m_exclude.size() ? 0 : pos + 1;
+    m_exclude.insert(m_exclude.begin() + insertPos, std::make_pair(name, any));
+  }
+}
+
+size_t
+Exclude::findLowerBound(const name::Component& comp) const
+{
+  exclude_type::const_iterator upperBound =
+    std::upper_bound(m_exclude.begin(), m_exclude.end(), comp,
+                     [] (const name::Component& c, const exclude_type::value_type& term) {
+                       return c < term.first;
+                     });
+  if (upperBound == m_exclude.begin())
+    return m_exclude.size();
+
+  return (upperBound - m_exclude.begin()) - 1;
+}
+
 // example: ANY /b /d ANY /f
 //
-// ordered in map as:
+// stored as:
 //
-// /f (false); /d (true); /b (false); / (true)
+// / (true); /b (false); /d (true); /f (false)
 //
-// lower_bound(/)  -> / (true) <-- excluded (equal)
-// lower_bound(/a) -> / (true) <-- excluded (any)
-// lower_bound(/b) -> /b (false) <--- excluded (equal)
-// lower_bound(/c) -> /b (false) <--- not excluded (not equal and no ANY)
-// lower_bound(/d) -> /d (true) <- excluded
-// lower_bound(/e) -> /d (true) <- excluded
+// findLowerBound(/)  -> / (true) <-- excluded (equal)
+// findLowerBound(/a) -> / (true) <-- excluded (any)
+// findLowerBound(/b) -> /b (false) <--- excluded (equal)
+// findLowerBound(/c) -> /b (false) <--- not excluded (not equal and no ANY)
+// findLowerBound(/d) -> /d (true) <- excluded
+// findLowerBound(/e) -> /d (true) <- excluded
 bool
 Exclude::isExcluded(const name::Component& comp) const
 {
-  const_iterator lowerBound = m_exclude.lower_bound(comp);
-  if (lowerBound == end())
+  size_t pos = findLowerBound(comp);
+  if (pos == m_exclude.size())
     return false;
 
-  if (lowerBound->second)
+  if (m_exclude[pos].second)
     return true;
   else
-    return lowerBound->first == comp;
-
-  return false;
+    return m_exclude[pos].first == comp;
 }
 
 Exclude&
@@ -177,38 +211,61 @@ Exclude::excludeOne(const name::Component& comp)
 {
   if (!isExcluded(comp))
     {
-      m_exclude.insert(std::make_pair(comp, false));
+      size_t pos = findLowerBound(comp);
+      size_t insertPos = pos == m_exclude.size() ? 0 : pos + 1;
+      m_exclude.insert(m_exclude.begin() + insertPos, std::make_pair(comp, false));
       m_wire.reset();
     }
   return *this;
 }
 
+size_t
+Exclude::excludeFrom(const name::Component& comp)
+{
+  size_t pos = findLowerBound(comp);
+  if (pos != m_exclude.size()) {
+    if (m_exclude[pos].second) {
+      // nothing special if start of the range already exists with ANY flag set
+      return pos;
+    }
+    if (m_exclude[pos].first == comp) {
+      // the lower bound is equal to the item itself, so just update ANY flag
+      m_exclude[pos].second = true;
+      return pos;
+    }
+  }
+
+  size_t insertPos = pos == m_exclude.size() ? 0 : pos + 1;
+  m_exclude.insert(m_exclude.begin() + insertPos, std::make_pair(comp, true));
+  return insertPos;
+}
+
 // example: ANY /b0 /d0 ANY /f0
 //
-// ordered in map as:
+// stored as:
 //
-// /f0 (false); /d0 (true); /b0 (false); / (true)
+// / (true); /b0 (false); /d0 (true); /f0 (false)
 //
-// lower_bound(/)  -> / (true) <-- excluded (equal)
-// lower_bound(/a0) -> / (true) <-- excluded (any)
-// lower_bound(/b0) -> /b0 (false) <--- excluded (equal)
-// lower_bound(/c0) -> /b0 (false) <--- not excluded (not equal and no ANY)
-// lower_bound(/d0) -> /d0 (true) <- excluded
-// lower_bound(/e0) -> /d0 (true) <- excluded
+// findLowerBound(/)  -> / (true) <-- excluded (equal)
+// findLowerBound(/a0) -> / (true) <-- excluded (any)
+// findLowerBound(/b0) -> /b0 (false) <--- excluded (equal)
+// findLowerBound(/c0) -> /b0 (false) <--- not excluded (not equal and no ANY)
+// findLowerBound(/d0) -> /d0 (true) <- excluded
+// findLowerBound(/e0) -> /d0 (true) <- excluded
 
 
 // examples with desired outcomes
 // excludeRange(/, /f0) ->  ANY /f0
-//                          /f0 (false); / (true)
+//                          / (true); /f0 (false)
 // excludeRange(/, /f1) ->  ANY /f1
-//                          /f1 (false); / (true)
+//                          / (true); /f1 (false)
 // excludeRange(/a0, /e0) ->  ANY /f0
-//                          /f0 (false); / (true)
+//                          / (true); /f0 (false)
 // excludeRange(/a0, /e0) ->  ANY /f0
-//                          /f0 (false); / (true)
+//                          / (true); /f0 (false)
 
 // excludeRange(/b1, /c0) ->  ANY /b0 /b1 ANY /c0 /d0 ANY /f0
-//                          /f0 (false); /d0 (true); /c0 (false); /b1 (true); /b0 (false); / (true)
+//                          / (true); /b0 (false); /b1 (true); /c0 (false); /d0 (true); /f0 (false)
 
 Exclude&
 Exclude::excludeRange(const name::Component& from, const name::Component& to)
@@ -218,28 +275,23 @@ Exclude::excludeRange(const name::Component& from, const name::Component& to)
                 "(for single name exclude use Exclude::excludeOne)");
   }
 
-  iterator newFrom = m_exclude.lower_bound(from);
-  if (newFrom == end() || !newFrom->second /*without ANY*/) {
-    std::pair<iterator, bool> fromResult = m_exclude.insert(std::make_pair(from, true));
-    newFrom = fromResult.first;
-    if (!fromResult.second) {
-      // this means that the lower bound is equal to the item itself. So, just update ANY flag
-      newFrom->second = true;
-    }
-  }
-  // else
-  // nothing special if start of the range already exists with ANY flag set
+  size_t fromPos = excludeFrom(from);
 
-  iterator newTo = m_exclude.lower_bound(to); // !newTo cannot be end()
-  if (newTo == newFrom || !newTo->second) {
-      std::pair<iterator, bool> toResult = m_exclude.insert(std::make_pair(to, false));
-      newTo = toResult.first;
-      ++ newTo;
+  size_t toPos = findLowerBound(to); // cannot be m_exclude.size(), because fromPos precedes to
+  size_t eraseEnd = toPos + 1;
+  if (toPos == fromPos || !m_exclude[toPos].second) {
+    if (m_exclude[toPos].first != to) {
+      m_exclude.insert(m_exclude.begin() + toPos + 1, std::make_pair(to, false));
+    }
+    else {
+      eraseEnd = toPos;
+    }
   }
   // else
   // nothing to do really
 
-  m_exclude.erase(newTo, newFrom); // remove any intermediate node, since all of the are excluded
+  // remove any intermediate term, since all of them are excluded
+  m_exclude.erase(m_exclude.begin() + fromPos + 1, m_exclude.begin() + eraseEnd);
 
   m_wire.reset();
   return *this;
@@ -248,22 +300,10 @@ Exclude::excludeRange(const name::Component& from, const name::Component& to)
 Exclude&
 Exclude::excludeAfter(const name::Component& from)
 {
-  iterator newFrom = m_exclude.lower_bound(from);
-  if (newFrom == end() || !newFrom->second /*without ANY*/) {
-    std::pair<iterator, bool> fromResult = m_exclude.insert(std::make_pair(from, true));
-    newFrom = fromResult.first;
-    if (!fromResult.second) {
-      // this means that the lower bound is equal to the item itself. So, just update ANY flag
-      newFrom->second = true;
-    }
-  }
-  // else
-  // nothing special if start of the range already exists with ANY flag set
+  size_t fromPos = excludeFrom(from);
 
-  if (newFrom != m_exclude.begin()) {
-    // remove any intermediate node, since all of the are excluded
-    m_exclude.erase(m_exclude.begin(), newFrom);
-  }
+  // remove any intermediate term, since all of them are excluded
+  m_exclude.erase(m_exclude.begin() + fromPos + 1, m_exclude.end());
 
   m_wire.reset();
   return *this;
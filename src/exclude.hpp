@@ -28,7 +28,7 @@
 #include "encoding/encoding-buffer.hpp"
 
 #include <sstream>
-#include <map>
+#include <vector>
 
 namespace ndn {
 
@@ -145,19 +145,27 @@ public: // EqualityComparable concept
   operator!=(const Exclude& other) const;
 
 public: // low-level exclude element API
-  typedef std::map< name::Component, bool /*any*/, std::greater<name::Component> > exclude_type;
+  /** \brief exclude terms, sorted in ascending order of name component
+   *
+   *  Each term is a name component and a flag indicating whether ANY follows it.
+   *  A contiguous sorted array is used instead of a tree, so that isExcluded is a binary search
+   *  without allocation, and decoding from wire does not allocate a node per component.
+   */
+  typedef std::vector<std::pair<name::Component, bool/*any*/>> exclude_type;
 
-  typedef exclude_type::iterator iterator;
-  typedef exclude_type::const_iterator const_iterator;
-  typedef exclude_type::reverse_iterator reverse_iterator;
-  typedef exclude_type::const_reverse_iterator const_reverse_iterator;
+  // exclude terms are enumerated in descending order of name component
+  typedef exclude_type::reverse_iterator iterator;
+  typedef exclude_type::const_reverse_iterator const_iterator;
+  typedef exclude_type::iterator reverse_iterator;
+  typedef exclude_type::const_iterator const_reverse_iterator;
 
   /**
    * @brief Method to directly append exclude element
    * @param name excluded name component
    * @param any  flag indicating if there is a postfix ANY component after the name
    *
-   * This method is used during conversion from wire format of exclude filter
+   * This method is used during conversion from wire format of exclude filter.
+   * It takes amortized constant time when elements are appended in ascending order.
    *
    * If there is an error with ranges (e.g., order of components is wrong) an exception is thrown
    */
@@ -195,8 +203,17 @@ public: // low-level exclude element API
   rend() const;
 
 private:
-  Exclude&
-  excludeRange(iterator fromLowerBound, iterator toLowerBound);
+  /** \brief find the last term whose name component is less than or equal to comp
+   *  \return position of the term in m_exclude, or m_exclude.size() if there is no such term
+   */
+  size_t
+  findLowerBound(const name::Component& comp) const;
+
+  /** \brief ensure comp is excluded together with everything up to the next term
+   *  \return position of the term that covers comp, which has ANY flag set
+   */
+  size_t
+  excludeFrom(const name::Component& comp);
 
 private:
   exclude_type m_exclude;
@@ -213,12 +230,6 @@ Exclude::excludeBefore(const name::Component& to)
   return excludeRange(name::Component(), to);
 }
 
-inline void
-Exclude::appendExclude(const name::Component& name, bool any)
-{
-  m_exclude[name] = any;
-}
-
 inline bool
 Exclude::empty() const
 {
@@ -241,25 +252,25 @@ Exclude::size() const
 inline Exclude::const_iterator
 Exclude::begin() const
 {
-  return m_exclude.begin();
+  return m_exclude.rbegin();
 }
 
 inline Exclude::const_iterator
 Exclude::end() const
 {
-  return m_exclude.end();
+  return m_exclude.rend();
 }
 
 inline Exclude::const_reverse_iterator
 Exclude::rbegin() const
 {
-  return m_exclude.rbegin();
+  return m_exclude.begin();
 }
 
 inline Exclude::const_reverse_iterator
 Exclude::rend() const
 {
-  return m_exclude.rend();
+  return m_exclude.end();
 }
 
 inline bool
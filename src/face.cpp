@@ -100,6 +100,7 @@ Face::construct(KeyChain* keyChain)
 {
   // transport=unix:///var/run/nfd.sock
   // transport=tcp://localhost:6363
+  // transport=udp://localhost:6363
 
   const ConfigFile::Parsed& parsed = m_impl->m_config.getParsedConfiguration();
 
@@ -133,6 +134,10 @@ Face::construct(KeyChain* keyChain)
     {
       construct(TcpTransport::create(m_impl->m_config), keyChain);
     }
+  else if (protocol == "udp" || protocol == "udp4" || protocol == "udp6")
+    {
+      construct(UdpTransport::create(m_impl->m_config), keyChain);
+    }
   else
     {
       throw ConfigFile::Error("Unsupported transport protocol \"" + protocol + "\"");
@@ -183,6 +188,9 @@ Face::construct(shared_ptr<Transport> transport,
 
 Face::~Face()
 {
+  // callbacks running on worker threads may still use this Face
+  m_impl->stopWorkers();
+
   if (m_internalKeyChain != nullptr) {
     delete m_internalKeyChain;
   }
@@ -200,9 +208,14 @@ Face::expressInterest(const Interest& interest, const OnData& onData, const OnTi
   if (interestToExpress->wireEncode().size() > MAX_NDN_PACKET_SIZE)
     throw Error("Interest size exceeds maximum limit");
 
-  // If the same ioService thread, dispatch directly calls the method
-  m_ioService.dispatch(bind(&Impl::asyncExpressInterest, m_impl,
-                            interestToExpress, onData, onTimeout));
+  if (m_impl->isSharded()) {
+    m_impl->expressShardedInterest(interestToExpress, onData, onTimeout);
+  }
+  else {
+    // If the same ioService thread, dispatch directly calls the method
+    m_ioService.dispatch(bind(&Impl::asyncExpressInterest, m_impl,
+                              interestToExpress, onData, onTimeout));
+  }
 
   return reinterpret_cast<const PendingInterestId*>(interestToExpress.get());
 }
@@ -242,12 +255,27 @@ Face::put(const Data& data)
 void
 Face::removePendingInterest(const PendingInterestId* pendingInterestId)
 {
+  if (m_impl->isSharded()) {
+    m_impl->removeShardedPendingInterest(pendingInterestId);
+    return;
+  }
+
   m_ioService.post(bind(&Impl::asyncRemovePendingInterest, m_impl, pendingInterestId));
 }
 
+void
+Face::setInterestAggregation(bool isEnabled)
+{
+  m_impl->m_isInterestAggregationEnabled = isEnabled;
+}
+
 size_t
 Face::getNPendingInterests() const
 {
+  if (m_impl->isSharded()) {
+    return m_impl->m_nShardedPendingInterests;
+  }
+
   return m_impl->m_pendingInterestTable.size();
 }
 
@@ -383,6 +411,37 @@ Face::registerPrefix(const Name& prefix,
                                 flags, options);
 }
 
+std::vector<const RegisteredPrefixId*>
+Face::registerPrefixes(const std::vector<Name>& prefixes,
+                       const RegisterPrefixSuccessCallback& onSuccess,
+                       const RegisterPrefixFailureCallback& onFailure,
+                       const IdentityCertificate& certificate,
+                       uint64_t flags)
+{
+  nfd::CommandOptions options;
+  if (certificate.getName().empty()) {
+    options.setSigningDefault();
+  }
+  else {
+    options.setSigningCertificate(certificate);
+  }
+
+  return m_impl->registerPrefixes(prefixes, onSuccess, onFailure, flags, options);
+}
+
+std::vector<const RegisteredPrefixId*>
+Face::registerPrefixes(const std::vector<Name>& prefixes,
+                       const RegisterPrefixSuccessCallback& onSuccess,
+                       const RegisterPrefixFailureCallback& onFailure,
+                       const Name& identity,
+                       uint64_t flags)
+{
+  nfd::CommandOptions options;
+  options.setSigningIdentity(identity);
+
+  return m_impl->registerPrefixes(prefixes, onSuccess, onFailure, flags, options);
+}
+
 void
 Face::unsetInterestFilter(const RegisteredPrefixId* registeredPrefixId)
 {
@@ -442,10 +501,17 @@ Face::processEvents(const time::milliseconds& timeout/* = time::milliseconds::ze
     m_impl->m_ioServiceWork.reset();
     m_impl->m_pendingInterestTable.clear();
     m_impl->m_registeredPrefixTable.clear();
+    m_impl->clearShards();
     throw;
   }
 }
 
+void
+Face::startWorkers(size_t nWorkers, size_t nShards, size_t prefixLength/* = 1*/)
+{
+  m_impl->startWorkers(nWorkers, nShards, prefixLength);
+}
+
 void
 Face::shutdown()
 {
@@ -457,6 +523,7 @@ Face::asyncShutdown()
 {
   m_impl->m_pendingInterestTable.clear();
   m_impl->m_registeredPrefixTable.clear();
+  m_impl->clearShards();
 
   if (m_transport->isConnected())
     m_transport->close();
@@ -484,19 +551,37 @@ Face::onReceiveElement(const Block& blockFromDaemon)
   if (block.type() == tlv::Interest)
     {
       shared_ptr<Interest> interest = make_shared<Interest>();
-      interest->wireDecode(block);
+      // callbacks of a sharded Face run on worker threads, which must not share a lazily
+      // decoded packet
+      if (m_impl->isSharded())
+        interest->wireDecode(block);
+      else
+        interest->lazyWireDecode(block);
       if (&block != &blockFromDaemon)
         interest->getLocalControlHeader().wireDecode(blockFromDaemon);
 
+      if (m_impl->isSharded()) {
+        m_impl->dispatchInterest(interest);
+        return;
+      }
+
       m_impl->processInterestFilters(*interest);
     }
   else if (block.type() == tlv::Data)
     {
       shared_ptr<Data> data = make_shared<Data>();
-      data->wireDecode(block);
+      if (m_impl->isSharded())
+        data->wireDecode(block);
+      else
+        data->lazyWireDecode(block);
       if (&block != &blockFromDaemon)
         data->getLocalControlHeader().wireDecode(blockFromDaemon);
 
+      if (m_impl->isSharded()) {
+        m_impl->dispatchData(data);
+        return;
+      }
+
       m_impl->satisfyPendingInterests(*data);
 
       if (m_impl->m_pendingInterestTable.empty()) {
@@ -422,6 +422,55 @@ public: // producer
                  const Name& identity,
                  uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT);
 
+  /**
+   * @brief Register many prefixes with the connected NDN forwarder
+   *
+   * This is equivalent to calling registerPrefix for each prefix, except that the
+   * registration commands are pipelined with a bounded window (see
+   * nfd::Controller::BATCH_WINDOW_SIZE), and the signing certificate is looked up only once.
+   * onSuccess or onFailure is called once for each prefix.
+   *
+   * @param prefixes    Prefixes to register with the connected NDN forwarder
+   * @param onSuccess   A callback to be called when registration of a prefix succeeds
+   * @param onFailure   A callback to be called when registration of a prefix fails
+   * @param certificate (optional) A certificate under which the prefix registration
+   *                    commands are signed.  When omitted, a default certificate of
+   *                    the default identity is used to sign the registration commands
+   * @param flags       (optional) RIB flags (not used when direct FIB management is requested)
+   *
+   * @return The registered prefix IDs, in the same order as prefixes,
+   *         which can be used with unregisterPrefix
+   */
+  std::vector<const RegisteredPrefixId*>
+  registerPrefixes(const std::vector<Name>& prefixes,
+                   const RegisterPrefixSuccessCallback& onSuccess,
+                   const RegisterPrefixFailureCallback& onFailure,
+                   const IdentityCertificate& certificate = IdentityCertificate(),
+                   uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT);
+
+  /**
+   * @brief Register many prefixes with the connected NDN forwarder
+   *
+   * @param prefixes  Prefixes to register with the connected NDN forwarder
+   * @param onSuccess A callback to be called when registration of a prefix succeeds
+   * @param onFailure A callback to be called when registration of a prefix fails
+   * @param identity  A signing identity. The prefix registration commands are signed
+   *                  under the default certificate of this identity
+   * @param flags     (optional) RIB flags (not used when direct FIB management is requested)
+   *
+   * @return The registered prefix IDs, in the same order as prefixes,
+   *         which can be used with unregisterPrefix
+   * @sa registerPrefixes(const std::vector<Name>&, const RegisterPrefixSuccessCallback&,
+   *                      const RegisterPrefixFailureCallback&, const IdentityCertificate&,
+   *                      uint64_t)
+   */
+  std::vector<const RegisteredPrefixId*>
+  registerPrefixes(const std::vector<Name>& prefixes,
+                   const RegisterPrefixSuccessCallback& onSuccess,
+                   const RegisterPrefixFailureCallback& onFailure,
+                   const Name& identity,
+                   uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT);
+
   /**
    * @brief Remove the registered prefix entry with the registeredPrefixId
    *
@@ -472,6 +521,22 @@ public: // producer
   void
   setDirectFibManagement(bool isDirectFibManagementRequested = false);
 
+  /**
+   * @brief Enable or disable client-side aggregation of expressed Interests
+   *
+   * When enabled, an Interest is not sent to the forwarder if an Interest with the same Name,
+   * Selectors, Scope and NextHopFaceId, which does not time out more than 100 ms earlier,
+   * was sent by this Face and is still pending.  The new Interest is still added to the
+   * pending Interest table with its own callbacks, so that the single Data returned for the
+   * earlier Interest satisfies both.
+   * Timeouts and removePendingInterest() keep applying to each expressed Interest separately.
+   *
+   * Aggregation is disabled by default.  It should be enabled before any Interest is
+   * expressed, and it affects only Interests expressed afterwards.
+   */
+  void
+  setInterestAggregation(bool isEnabled);
+
    /**
    * @brief Publish data packet
    *
@@ -534,6 +599,35 @@ public: // IO routine
     return m_ioService;
   }
 
+public: // multi-threaded dispatch
+  /**
+   * @brief Dispatch incoming packets to a pool of worker threads
+   *
+   * The pending Interest table and the InterestFilter table are split into @p nShards
+   * shards.  An Interest (expressed or incoming) and a Data packet are assigned to the shard
+   * selected by the hash of the first @p prefixLength components of their names.  Each shard
+   * is a strand of an internal io_service run by @p nWorkers threads, so that the callbacks
+   * of names in one shard are invoked one at a time in arrival order, while different shards
+   * are processed in parallel.
+   *
+   * OnData, OnTimeout and OnInterest callbacks are invoked on the worker threads.
+   * The transport keeps using the io_service of this Face, so processEvents() (or the
+   * io_service run by the application) still needs to be running to send and receive
+   * packets.  An exception thrown by a callback on a worker thread is rethrown from
+   * processEvents().
+   *
+   * An InterestFilter whose prefix is shorter than @p prefixLength is installed in every
+   * shard, and its callback can therefore be invoked concurrently for Interests of
+   * different shards.
+   *
+   * Worker threads are stopped when the Face is destroyed.
+   *
+   * @pre No Interest has been expressed and no InterestFilter has been set on this Face.
+   * @throw Error workers are already started, or @p nWorkers or @p nShards is zero
+   */
+  void
+  startWorkers(size_t nWorkers, size_t nShards, size_t prefixLength = 1);
+
 private:
 
   /**
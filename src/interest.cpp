@@ -303,6 +303,13 @@ Interest::wireEncode() const
 
 void
 Interest::wireDecode(const Block& wire)
+{
+  lazyWireDecode(wire);
+  decodeDeferredSelectors();
+}
+
+void
+Interest::lazyWireDecode(const Block& wire)
 {
   m_wire = wire;
   m_wire.parse();
@@ -324,10 +331,13 @@ Interest::wireDecode(const Block& wire)
   Block::element_const_iterator val = m_wire.find(tlv::Selectors);
   if (val != m_wire.elements_end())
     {
-      m_selectors.wireDecode(*val);
+      m_deferredSelectors = *val;
     }
   else
-    m_selectors = Selectors();
+    {
+      m_deferredSelectors.reset();
+      m_selectors = Selectors();
+    }
 
   // Nonce
   m_nonce = m_wire.get(tlv::Nonce);
@@ -114,6 +114,23 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Decode from the wire format, deferring Selectors
+   *
+   * Selectors, including Exclude and PublisherPublicKeyLocator, are decoded the first time
+   * they are accessed or modified, so malformed Selectors are reported by that accessor
+   * rather than by this method.  All other elements are decoded immediately.
+   *
+   * This is intended for packets that are dispatched by name and may never be inspected
+   * further, such as Interests received by Face.
+   *
+   * @note The Selectors are decoded in place by const member functions as well, so an
+   *       Interest decoded this way must not be accessed from several threads at once.
+   *       Interests delivered by a Face with worker threads are fully decoded.
+   */
+  void
+  lazyWireDecode(const Block& wire);
+
   /**
    * @brief Check if already has wire
    */
@@ -276,12 +293,13 @@ public: // Selectors
   bool
   hasSelectors() const
   {
-    return !m_selectors.empty();
+    return !getSelectors().empty();
   }
 
   const Selectors&
   getSelectors() const
   {
+    decodeDeferredSelectors();
     return m_selectors;
   }
 
@@ -289,6 +307,7 @@ public: // Selectors
   setSelectors(const Selectors& selectors)
   {
     m_selectors = selectors;
+    m_deferredSelectors.reset();
     m_wire.reset();
     return *this;
   }
@@ -296,12 +315,13 @@ public: // Selectors
   int
   getMinSuffixComponents() const
   {
-    return m_selectors.getMinSuffixComponents();
+    return getSelectors().getMinSuffixComponents();
   }
 
   Interest&
   setMinSuffixComponents(int minSuffixComponents)
   {
+    decodeDeferredSelectors();
     m_selectors.setMinSuffixComponents(minSuffixComponents);
     m_wire.reset();
     return *this;
@@ -310,12 +330,13 @@ public: // Selectors
   int
   getMaxSuffixComponents() const
   {
-    return m_selectors.getMaxSuffixComponents();
+    return getSelectors().getMaxSuffixComponents();
   }
 
   Interest&
   setMaxSuffixComponents(int maxSuffixComponents)
   {
+    decodeDeferredSelectors();
     m_selectors.setMaxSuffixComponents(maxSuffixComponents);
     m_wire.reset();
     return *this;
@@ -324,12 +345,13 @@ public: // Selectors
   const KeyLocator&
   getPublisherPublicKeyLocator() const
   {
-    return m_selectors.getPublisherPublicKeyLocator();
+    return getSelectors().getPublisherPublicKeyLocator();
   }
 
   Interest&
   setPublisherPublicKeyLocator(const KeyLocator& keyLocator)
   {
+    decodeDeferredSelectors();
     m_selectors.setPublisherPublicKeyLocator(keyLocator);
     m_wire.reset();
     return *this;
@@ -338,12 +360,13 @@ public: // Selectors
   const Exclude&
   getExclude() const
   {
-    return m_selectors.getExclude();
+    return getSelectors().getExclude();
   }
 
   Interest&
   setExclude(const Exclude& exclude)
   {
+    decodeDeferredSelectors();
     m_selectors.setExclude(exclude);
     m_wire.reset();
     return *this;
@@ -352,12 +375,13 @@ public: // Selectors
   int
   getChildSelector() const
   {
-    return m_selectors.getChildSelector();
+    return getSelectors().getChildSelector();
   }
 
   Interest&
   setChildSelector(int childSelector)
   {
+    decodeDeferredSelectors();
     m_selectors.setChildSelector(childSelector);
     m_wire.reset();
     return *this;
@@ -366,12 +390,13 @@ public: // Selectors
   int
   getMustBeFresh() const
   {
-    return m_selectors.getMustBeFresh();
+    return getSelectors().getMustBeFresh();
   }
 
   Interest&
   setMustBeFresh(bool mustBeFresh)
   {
+    decodeDeferredSelectors();
     m_selectors.setMustBeFresh(mustBeFresh);
     m_wire.reset();
     return *this;
@@ -390,9 +415,16 @@ public: // EqualityComparable concept
     return !(*this == other);
   }
 
+private:
+  /** @brief Decode Selectors if they were skipped by lazyWireDecode()
+   */
+  void
+  decodeDeferredSelectors() const;
+
 private:
   Name m_name;
-  Selectors m_selectors;
+  mutable Selectors m_selectors;
+  mutable Block m_deferredSelectors;
   mutable Block m_nonce;
   int m_scope;
   time::milliseconds m_interestLifetime;
@@ -406,6 +438,15 @@ private:
 std::ostream&
 operator<<(std::ostream& os, const Interest& interest);
 
+inline void
+Interest::decodeDeferredSelectors() const
+{
+  if (m_deferredSelectors.hasWire()) {
+    m_selectors.wireDecode(m_deferredSelectors);
+    m_deferredSelectors.reset();
+  }
+}
+
 inline std::string
 Interest::toUri() const
 {
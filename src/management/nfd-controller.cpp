@@ -22,12 +22,272 @@
 #include "nfd-controller.hpp"
 #include "nfd-control-response.hpp"
 
+#include <map>
+
 namespace ndn {
 namespace nfd {
 
 const uint32_t Controller::ERROR_TIMEOUT = 10060;
 const uint32_t Controller::ERROR_SERVER = 500;
 const uint32_t Controller::ERROR_LBOUND = 400;
+const size_t Controller::BATCH_WINDOW_SIZE = 32;
+const size_t Controller::DATASET_WINDOW_SIZE = 8;
+
+/** \brief state of a command batch
+ */
+struct Controller::CommandBatch
+{
+  shared_ptr<ControlCommand> command;
+  std::vector<Name> requestNames;
+  shared_ptr<IdentityCertificate> signingCertificate;
+  time::milliseconds timeout;
+  BatchCommandSucceedCallback onSuccess;
+  BatchCommandFailCallback onFailure;
+  size_t nextIndex; ///< position of the next command to send
+  size_t nOutstanding;
+};
+
+/** \brief retrieves a segmented status dataset and delivers its items incrementally
+ *
+ *  The first Interest discovers the latest version of the dataset.  Afterwards, up to
+ *  Controller::DATASET_WINDOW_SIZE segment Interests are kept outstanding.  Segments are
+ *  decoded in order; an item spanning a segment boundary is carried over to the next segment.
+ */
+class DatasetFetcher : noncopyable
+{
+public:
+  DatasetFetcher(Face& face,
+                 const function<void(const Block&)>& onItemBlock,
+                 const Controller::DatasetSucceedCallback& onSuccess,
+                 const Controller::DatasetFailCallback& onFailure,
+                 const time::milliseconds& interestLifetime)
+    : m_face(face)
+    , m_onItemBlock(onItemBlock)
+    , m_onSuccess(onSuccess)
+    , m_onFailure(onFailure)
+    , m_interestLifetime(interestLifetime)
+    , m_isDone(false)
+    , m_nextSegmentNo(0)
+    , m_nextRequestedSegmentNo(0)
+    , m_finalSegmentNo(std::numeric_limits<uint64_t>::max())
+  {
+  }
+
+  void
+  start(const Name& prefix, const shared_ptr<DatasetFetcher>& self)
+  {
+    Interest interest(prefix);
+    interest.setChildSelector(1);
+    interest.setMustBeFresh(true);
+    interest.setInterestLifetime(m_interestLifetime);
+
+    // recorded under segment 0 until the reply reveals the version, so that cancel() can
+    // remove it
+    m_pendingInterests[0] =
+      m_face.expressInterest(interest,
+                             bind(&DatasetFetcher::afterSegment, this, _2, self),
+                             bind(&DatasetFetcher::afterTimeout, this, self));
+  }
+
+private:
+  void
+  requestSegments(const shared_ptr<DatasetFetcher>& self)
+  {
+    while (!m_isDone &&
+           m_pendingInterests.size() < Controller::DATASET_WINDOW_SIZE &&
+           m_nextRequestedSegmentNo <= m_finalSegmentNo) {
+      uint64_t segmentNo = m_nextRequestedSegmentNo++;
+      if (segmentNo < m_nextSegmentNo || m_receivedSegments.count(segmentNo) > 0)
+        continue;
+
+      Interest interest(Name(m_versionedPrefix).appendSegment(segmentNo));
+      interest.setInterestLifetime(m_interestLifetime);
+
+      m_pendingInterests[segmentNo] =
+        m_face.expressInterest(interest,
+                               bind(&DatasetFetcher::afterSegment, this, _2, self),
+                               bind(&DatasetFetcher::afterTimeout, this, self));
+    }
+  }
+
+  void
+  afterSegment(const Data& data, const shared_ptr<DatasetFetcher>& self)
+  {
+    if (m_isDone)
+      return;
+
+    uint64_t segmentNo = 0;
+    try {
+      segmentNo = data.getName().at(-1).toSegment();
+
+      const name::Component& finalBlockId = data.getMetaInfo().getFinalBlockId();
+      if (!finalBlockId.empty())
+        m_finalSegmentNo = finalBlockId.toSegment();
+    }
+    catch (const tlv::Error& e) {
+      return this->fail(Controller::ERROR_SERVER, e.what());
+    }
+
+    if (m_versionedPrefix.empty()) {
+      // reply to the initial Interest
+      m_versionedPrefix = data.getName().getPrefix(-1);
+      m_pendingInterests.erase(0);
+    }
+    else {
+      m_pendingInterests.erase(segmentNo);
+    }
+
+    if (segmentNo >= m_nextSegmentNo)
+      m_receivedSegments[segmentNo] = data.getContent();
+
+    while (!m_isDone && !m_receivedSegments.empty() &&
+           m_receivedSegments.begin()->first == m_nextSegmentNo) {
+      try {
+        this->decodeSegment(m_receivedSegments.begin()->second);
+      }
+      catch (const tlv::Error& e) {
+        return this->fail(Controller::ERROR_SERVER, e.what());
+      }
+      m_receivedSegments.erase(m_receivedSegments.begin());
+
+      if (m_nextSegmentNo == m_finalSegmentNo) {
+        if (!m_partialItem.empty())
+          return this->fail(Controller::ERROR_SERVER, "dataset ends with an incomplete item");
+        return this->succeed();
+      }
+      ++m_nextSegmentNo;
+    }
+
+    this->requestSegments(self);
+  }
+
+  /** \brief decode all complete items in segment content, after completing the item
+   *         carried over from previous segments
+   *
+   *  Items are decoded in place and share the buffer of the segment; only the octets of an
+   *  item that continues in the next segment are copied.
+   *  \throw tlv::Error an item cannot be decoded
+   */
+  void
+  decodeSegment(const Block& content)
+  {
+    Buffer::const_iterator begin = content.value_begin();
+    Buffer::const_iterator end = content.value_end();
+
+    if (!m_partialItem.empty() && !this->completePartialItem(begin, end))
+      return;
+
+    while (begin != end) {
+      Buffer::const_iterator valueBegin = begin;
+      uint32_t type = 0;
+      uint64_t length = 0;
+      if (!tlv::readType(valueBegin, end, type) ||
+          !tlv::readVarNumber(valueBegin, end, length) ||
+          length > static_cast<uint64_t>(end - valueBegin))
+        break;
+
+      Buffer::const_iterator itemEnd = valueBegin + length;
+      Block item(content.getBuffer(), type, begin, itemEnd, valueBegin, itemEnd);
+      begin = itemEnd;
+      m_onItemBlock(item);
+    }
+
+    m_partialItem.assign(begin, end);
+  }
+
+  /** \brief append to the carried-over item the octets of [begin, end) that belong to it,
+   *         and decode the item if it is then complete
+   *  \param[in,out] begin advanced past the appended octets
+   *  \return whether the item was complete
+   *  \throw tlv::Error the item cannot be decoded
+   */
+  bool
+  completePartialItem(Buffer::const_iterator& begin, const Buffer::const_iterator& end)
+  {
+    // the header itself can be split, so it is completed one octet at a time
+    uint32_t type = 0;
+    uint64_t length = 0;
+    size_t headerSize = 0;
+    for (;;) {
+      Buffer::const_iterator headerBegin = m_partialItem.begin();
+      Buffer::const_iterator headerEnd = headerBegin;
+      Buffer::const_iterator partialEnd = m_partialItem.end();
+      if (tlv::readType(headerEnd, partialEnd, type) &&
+          tlv::readVarNumber(headerEnd, partialEnd, length)) {
+        headerSize = headerEnd - headerBegin;
+        break;
+      }
+      if (begin == end)
+        return false;
+      m_partialItem.push_back(*begin++);
+    }
+
+    uint64_t nMissing = headerSize + length - m_partialItem.size();
+    size_t nAppended = static_cast<size_t>(std::min<uint64_t>(nMissing, end - begin));
+    m_partialItem.insert(m_partialItem.end(), begin, begin + nAppended);
+    begin += nAppended;
+    if (nAppended < nMissing)
+      return false;
+
+    BufferPtr buffer = make_shared<Buffer>();
+    buffer->swap(m_partialItem);
+    m_onItemBlock(Block(buffer));
+    return true;
+  }
+
+  void
+  afterTimeout(const shared_ptr<DatasetFetcher>& self)
+  {
+    this->fail(Controller::ERROR_TIMEOUT, "request timed out");
+  }
+
+  void
+  succeed()
+  {
+    this->cancel();
+    if (static_cast<bool>(m_onSuccess))
+      m_onSuccess();
+  }
+
+  void
+  fail(uint32_t code, const std::string& reason)
+  {
+    if (m_isDone)
+      return;
+
+    this->cancel();
+    if (static_cast<bool>(m_onFailure))
+      m_onFailure(code, reason);
+  }
+
+  void
+  cancel()
+  {
+    m_isDone = true;
+
+    for (const auto& pending : m_pendingInterests) {
+      m_face.removePendingInterest(pending.second);
+    }
+    m_pendingInterests.clear();
+    m_receivedSegments.clear();
+  }
+
+private:
+  Face& m_face;
+  function<void(const Block&)> m_onItemBlock;
+  Controller::DatasetSucceedCallback m_onSuccess;
+  Controller::DatasetFailCallback m_onFailure;
+  time::milliseconds m_interestLifetime;
+
+  bool m_isDone;
+  Name m_versionedPrefix;
+  uint64_t m_nextSegmentNo; ///< next segment to decode
+  uint64_t m_nextRequestedSegmentNo; ///< next segment to request
+  uint64_t m_finalSegmentNo; ///< last segment number, or max if unknown
+  std::map<uint64_t, const PendingInterestId*> m_pendingInterests;
+  std::map<uint64_t, Block> m_receivedSegments; ///< segment contents waiting to be decoded
+  Buffer m_partialItem; ///< leading bytes of an item that continues in the next segment
+};
 
 Controller::Controller(Face& face)
   : m_face(face)
@@ -95,6 +355,113 @@ Controller::startCommand(const shared_ptr<ControlCommand>& command,
                          bind(onFailure, ERROR_TIMEOUT, "request timed out"));
 }
 
+void
+Controller::startCommandBatch(const shared_ptr<ControlCommand>& command,
+                              const std::vector<ControlParameters>& parametersList,
+                              const BatchCommandSucceedCallback& onSuccess,
+                              const BatchCommandFailCallback& onFailure,
+                              const CommandOptions& options)
+{
+  shared_ptr<CommandBatch> batch = make_shared<CommandBatch>();
+  batch->command = command;
+  batch->timeout = options.getTimeout();
+  batch->onSuccess = onSuccess;
+  batch->onFailure = onFailure;
+  batch->nextIndex = 0;
+  batch->nOutstanding = 0;
+
+  // validate all parameters before sending anything
+  batch->requestNames.reserve(parametersList.size());
+  for (const ControlParameters& parameters : parametersList) {
+    batch->requestNames.push_back(command->getRequestName(options.getPrefix(), parameters));
+  }
+
+  switch (options.getSigningParamsKind()) {
+  case CommandOptions::SIGNING_PARAMS_DEFAULT:
+    batch->signingCertificate = m_keyChain.getDefaultCertificate();
+    break;
+  case CommandOptions::SIGNING_PARAMS_IDENTITY: {
+    Name certificateName;
+    try {
+      certificateName = m_keyChain.getDefaultCertificateNameForIdentity(
+                          options.getSigningIdentity());
+    }
+    catch (const SecPublicInfo::Error&) {
+      certificateName = m_keyChain.createIdentity(options.getSigningIdentity());
+    }
+    batch->signingCertificate = m_keyChain.getCertificate(certificateName);
+    break;
+  }
+  case CommandOptions::SIGNING_PARAMS_CERTIFICATE:
+    batch->signingCertificate = m_keyChain.getCertificate(options.getSigningCertificate());
+    break;
+  default:
+    BOOST_ASSERT(false);
+    break;
+  }
+
+  this->sendBatchCommands(batch);
+}
+
+void
+Controller::sendBatchCommands(const shared_ptr<CommandBatch>& batch)
+{
+  while (batch->nOutstanding < BATCH_WINDOW_SIZE &&
+         batch->nextIndex < batch->requestNames.size()) {
+    size_t index = batch->nextIndex++;
+
+    Interest interest(batch->requestNames[index]);
+    interest.setInterestLifetime(batch->timeout);
+    m_keyChain.sign(interest, *batch->signingCertificate);
+
+    CommandSucceedCallback onSuccess =
+      bind(&Controller::afterBatchCommandSucceed, this, batch, index, _1);
+    CommandFailCallback onFailure =
+      bind(&Controller::afterBatchCommandFail, this, batch, index, _1, _2);
+
+    ++batch->nOutstanding;
+    m_face.expressInterest(interest,
+                           bind(&Controller::processCommandResponse, this, _2,
+                                batch->command, onSuccess, onFailure),
+                           bind(onFailure, ERROR_TIMEOUT, "request timed out"));
+  }
+}
+
+void
+Controller::afterBatchCommandSucceed(const shared_ptr<CommandBatch>& batch, size_t index,
+                                     const ControlParameters& parameters)
+{
+  --batch->nOutstanding;
+  if (static_cast<bool>(batch->onSuccess))
+    batch->onSuccess(index, parameters);
+
+  this->sendBatchCommands(batch);
+}
+
+void
+Controller::afterBatchCommandFail(const shared_ptr<CommandBatch>& batch, size_t index,
+                                  uint32_t code, const std::string& reason)
+{
+  --batch->nOutstanding;
+  if (static_cast<bool>(batch->onFailure))
+    batch->onFailure(index, code, reason);
+
+  this->sendBatchCommands(batch);
+}
+
+void
+Controller::fetchDataset(const Name& prefix,
+                         const function<void(const Block&)>& onItemBlock,
+                         const DatasetSucceedCallback& onSuccess,
+                         const DatasetFailCallback& onFailure,
+                         const CommandOptions& options)
+{
+  shared_ptr<DatasetFetcher> fetcher = make_shared<DatasetFetcher>(m_face, onItemBlock,
+                                                                   onSuccess, onFailure,
+                                                                   options.getTimeout());
+  fetcher->start(prefix, fetcher);
+}
+
 void
 Controller::processCommandResponse(const Data& data,
                                    const shared_ptr<ControlCommand>& command,
@@ -26,6 +26,7 @@
 #include "../face.hpp"
 #include "../security/key-chain.hpp"
 #include "nfd-command-options.hpp"
+#include "nfd-status-dataset.hpp"
 
 namespace ndn {
 namespace nfd {
@@ -36,7 +37,7 @@ namespace nfd {
  */
 /**
  * \ingroup management
- * \brief NFD Management protocol - ControlCommand client
+ * \brief NFD Management protocol - ControlCommand and StatusDataset client
  */
 class Controller : noncopyable
 {
@@ -49,6 +50,25 @@ public:
    */
   typedef function<void(uint32_t/*code*/,const std::string&/*reason*/)> CommandFailCallback;
 
+  /** \brief a callback on success of a command in a batch
+   *  \param index position of the command in the batch
+   */
+  typedef function<void(size_t/*index*/,const ControlParameters&)> BatchCommandSucceedCallback;
+
+  /** \brief a callback on failure of a command in a batch
+   *  \param index position of the command in the batch
+   */
+  typedef function<void(size_t/*index*/,uint32_t/*code*/,const std::string&/*reason*/)>
+          BatchCommandFailCallback;
+
+  /** \brief a callback on dataset retrieval completion
+   */
+  typedef function<void()> DatasetSucceedCallback;
+
+  /** \brief a callback on dataset retrieval failure
+   */
+  typedef CommandFailCallback DatasetFailCallback;
+
   /** \brief a function to sign the request Interest
    *  \deprecated arbitrary signing function is no longer supported
    */
@@ -136,6 +156,53 @@ public:
         const Sign& sign,
         const time::milliseconds& timeout = CommandOptions::DEFAULT_TIMEOUT));
 
+  /** \brief start execution of a batch of commands of the same type
+   *  \param parametersList parameters of each command
+   *  \param onSuccess invoked when a command succeeds, with its position in parametersList
+   *  \param onFailure invoked when a command fails, with its position in parametersList
+   *  \param options options shared by all commands in the batch
+   *  \throw ControlCommand::ArgumentError any parameters are invalid; no command is sent
+   *
+   *  Commands are sent in order, keeping at most BATCH_WINDOW_SIZE of them outstanding.
+   *  The signing certificate is looked up once for the whole batch.
+   */
+  template<typename Command>
+  void
+  startBatch(const std::vector<ControlParameters>& parametersList,
+             const BatchCommandSucceedCallback& onSuccess,
+             const BatchCommandFailCallback& onFailure,
+             const CommandOptions& options = CommandOptions())
+  {
+    shared_ptr<ControlCommand> command = make_shared<Command>();
+    this->startCommandBatch(command, parametersList, onSuccess, onFailure, options);
+  }
+
+  /** \brief start dataset retrieval
+   *  \tparam Dataset a status dataset type, such as FaceDataset or FibDataset
+   *  \param onItem invoked for each decoded item, in the order of the dataset
+   *  \param onSuccess invoked after the last item has been delivered
+   *  \param onFailure invoked if a segment cannot be retrieved or an item cannot be decoded;
+   *                   no more items are delivered after this
+   *  \param options options.getPrefix() is the forwarder prefix, and options.getTimeout()
+   *                 is the InterestLifetime of each segment Interest; signing parameters are ignored
+   *
+   *  Up to DATASET_WINDOW_SIZE segment Interests are kept outstanding at any time.
+   *  Items are decoded as soon as the segments containing them and all preceding segments
+   *  have arrived, so that the concatenated dataset payload is never materialized.
+   */
+  template<typename Dataset>
+  void
+  fetch(const function<void(const typename Dataset::ResultItem&)>& onItem,
+        const DatasetSucceedCallback& onSuccess,
+        const DatasetFailCallback& onFailure,
+        const CommandOptions& options = CommandOptions())
+  {
+    this->fetchDataset(Dataset::getDatasetPrefix(options.getPrefix()),
+                       bind(&Controller::decodeDatasetItem<typename Dataset::ResultItem>,
+                            _1, onItem),
+                       onSuccess, onFailure, options);
+  }
+
 private:
   void
   startCommand(const shared_ptr<ControlCommand>& command,
@@ -144,6 +211,44 @@ private:
                const CommandFailCallback& onFailure,
                const CommandOptions& options);
 
+  struct CommandBatch;
+
+  void
+  startCommandBatch(const shared_ptr<ControlCommand>& command,
+                    const std::vector<ControlParameters>& parametersList,
+                    const BatchCommandSucceedCallback& onSuccess,
+                    const BatchCommandFailCallback& onFailure,
+                    const CommandOptions& options);
+
+  void
+  sendBatchCommands(const shared_ptr<CommandBatch>& batch);
+
+  void
+  afterBatchCommandSucceed(const shared_ptr<CommandBatch>& batch, size_t index,
+                           const ControlParameters& parameters);
+
+  void
+  afterBatchCommandFail(const shared_ptr<CommandBatch>& batch, size_t index,
+                        uint32_t code, const std::string& reason);
+
+  void
+  fetchDataset(const Name& prefix,
+               const function<void(const Block&)>& onItemBlock,
+               const DatasetSucceedCallback& onSuccess,
+               const DatasetFailCallback& onFailure,
+               const CommandOptions& options);
+
+  /** \throw tlv::Error item cannot be decoded
+   */
+  template<typename Item>
+  static void
+  decodeDatasetItem(const Block& block, const function<void(const Item&)>& onItem)
+  {
+    Item item(block);
+    if (static_cast<bool>(onItem))
+      onItem(item);
+  }
+
   /** \deprecated This is to support arbitrary signing function.
    */
   void
@@ -181,6 +286,14 @@ public:
    */
   static const uint32_t ERROR_LBOUND;
 
+  /** \brief maximum number of outstanding commands during batch execution
+   */
+  static const size_t BATCH_WINDOW_SIZE;
+
+  /** \brief maximum number of outstanding segment Interests during dataset retrieval
+   */
+  static const size_t DATASET_WINDOW_SIZE;
+
 protected:
   Face& m_face;
 
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_MANAGEMENT_NFD_STATUS_DATASET_HPP
+#define NDN_MANAGEMENT_NFD_STATUS_DATASET_HPP
+
+#include "nfd-face-status.hpp"
+#include "nfd-channel-status.hpp"
+#include "nfd-fib-entry.hpp"
+#include "nfd-rib-entry.hpp"
+#include "nfd-strategy-choice.hpp"
+#include "../name.hpp"
+
+namespace ndn {
+namespace nfd {
+
+/**
+ * \ingroup management
+ * \brief represents a status dataset that can be retrieved with Controller::fetch
+ *
+ * A Dataset type must provide:
+ * - a ResultItem typedef, the type of each item in the dataset payload,
+ *   which must be constructible from a Block;
+ * - a static getDatasetPrefix function that returns dataset prefix under a command prefix.
+ *
+ * \sa http://redmine.named-data.net/projects/nfd/wiki/StatusDataset
+ */
+template<typename Item>
+class StatusDataset
+{
+public:
+  typedef Item ResultItem;
+};
+
+/**
+ * \ingroup management
+ * \brief represents a faces/list dataset
+ * \sa http://redmine.named-data.net/projects/nfd/wiki/FaceMgmt#Face-Dataset
+ */
+class FaceDataset : public StatusDataset<FaceStatus>
+{
+public:
+  static Name
+  getDatasetPrefix(const Name& prefix)
+  {
+    return Name(prefix).append("faces").append("list");
+  }
+};
+
+/**
+ * \ingroup management
+ * \brief represents a faces/channels dataset
+ * \sa http://redmine.named-data.net/projects/nfd/wiki/FaceMgmt#Channel-Dataset
+ */
+class ChannelDataset : public StatusDataset<ChannelStatus>
+{
+public:
+  static Name
+  getDatasetPrefix(const Name& prefix)
+  {
+    return Name(prefix).append("faces").append("channels");
+  }
+};
+
+/**
+ * \ingroup management
+ * \brief represents a fib/list dataset
+ * \sa http://redmine.named-data.net/projects/nfd/wiki/FibMgmt#FIB-Dataset
+ */
+class FibDataset : public StatusDataset<FibEntry>
+{
+public:
+  static Name
+  getDatasetPrefix(const Name& prefix)
+  {
+    return Name(prefix).append("fib").append("list");
+  }
+};
+
+/**
+ * \ingroup management
+ * \brief represents a rib/list dataset
+ * \sa http://redmine.named-data.net/projects/nfd/wiki/RibMgmt#RIB-Dataset
+ */
+class RibDataset : public StatusDataset<RibEntry>
+{
+public:
+  static Name
+  getDatasetPrefix(const Name& prefix)
+  {
+    return Name(prefix).append("rib").append("list");
+  }
+};
+
+/**
+ * \ingroup management
+ * \brief represents a strategy-choice/list dataset
+ * \sa http://redmine.named-data.net/projects/nfd/wiki/StrategyChoice#Strategy-Choice-Dataset
+ */
+class StrategyChoiceDataset : public StatusDataset<StrategyChoice>
+{
+public:
+  static Name
+  getDatasetPrefix(const Name& prefix)
+  {
+    return Name(prefix).append("strategy-choice").append("list");
+  }
+};
+
+} // namespace nfd
+} // namespace ndn
+
+#endif // NDN_MANAGEMENT_NFD_STATUS_DATASET_HPP
@@ -28,12 +28,13 @@
 #include "encoding/block-helpers.hpp"
 #include "encoding/encoding-buffer.hpp"
 #include "util/string-helper.hpp"
-#include "security/cryptopp.hpp"
 #include "util/crypto.hpp"
 #include "util/concepts.hpp"
 
 #include <boost/lexical_cast.hpp>
 
+#include <cstring>
+
 namespace ndn {
 namespace name {
 
@@ -92,104 +93,162 @@ Component::Component(const std::string& str)
 Component
 Component::fromEscapedString(const char* escapedString, size_t beginOffset, size_t endOffset)
 {
-  std::string trimmedString(escapedString + beginOffset, escapedString + endOffset);
-  trim(trimmedString);
+  // decode straight into the wire buffer, behind room for the largest possible TLV header
+  size_t uriLength = endOffset - beginOffset;
+  size_t maxHeaderLength = 1 + tlv::sizeOfVarNumber(uriLength);
+  BufferPtr buffer = make_shared<Buffer>(maxHeaderLength + uriLength);
+
+  uint32_t type = tlv::NameComponent;
+  size_t valueLength = decodeUri(escapedString + beginOffset, uriLength,
+                                 buffer->data() + maxHeaderLength, type);
+
+  size_t headerLength = tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueLength);
+  uint8_t* begin = buffer->data() + maxHeaderLength - headerLength;
+  tlv::writeVarNumber(begin + tlv::writeVarNumber(begin, type), valueLength);
+  return Block(buffer, buffer->begin() + (maxHeaderLength - headerLength),
+               buffer->begin() + (maxHeaderLength + valueLength));
+}
+
+size_t
+Component::decodeUri(const char* uri, size_t uriLength, uint8_t* value, uint32_t& type)
+{
+  const char* begin = uri;
+  const char* end = uri + uriLength;
+  trim(begin, end);
 
-  if (trimmedString.compare(0, getSha256DigestUriPrefix().size(),
-                            getSha256DigestUriPrefix()) == 0) {
-    if (trimmedString.size() != getSha256DigestUriPrefix().size() + crypto::SHA256_DIGEST_SIZE * 2)
+  const std::string& digestPrefix = getSha256DigestUriPrefix();
+  if (static_cast<size_t>(end - begin) >= digestPrefix.size() &&
+      std::equal(digestPrefix.begin(), digestPrefix.end(), begin)) {
+    if (static_cast<size_t>(end - begin) != digestPrefix.size() + crypto::SHA256_DIGEST_SIZE * 2)
       throw Error("Cannot convert to ImplicitSha256DigestComponent"
                   "(expected sha256 in hex encoding)");
 
-    try {
-      std::string value;
-      CryptoPP::StringSource(reinterpret_cast<const uint8_t*>(trimmedString.c_str()) +
-                               getSha256DigestUriPrefix().size(),
-                             trimmedString.size () - getSha256DigestUriPrefix().size(), true,
-                             new CryptoPP::HexDecoder(new CryptoPP::StringSink(value)));
+    const char* hex = begin + digestPrefix.size();
+    for (size_t i = 0; i < crypto::SHA256_DIGEST_SIZE; ++i) {
+      int hi = fromHexChar(hex[2 * i]);
+      int lo = fromHexChar(hex[2 * i + 1]);
+      if (hi < 0 || lo < 0)
+        throw Error("Cannot convert to a ImplicitSha256DigestComponent (invalid hex encoding)");
+      value[i] = static_cast<uint8_t>(16 * hi + lo);
+    }
+    type = tlv::ImplicitSha256DigestComponent;
+    return crypto::SHA256_DIGEST_SIZE;
+  }
 
-      return fromImplicitSha256Digest(reinterpret_cast<const uint8_t*>(value.c_str()),
-                                      value.size());
+  size_t valueLength = 0;
+  bool hasNonPeriod = false;
+  for (const char* i = begin; i != end; ++i) {
+    if (*i == '%' && end - i > 2) {
+      int hi = fromHexChar(i[1]);
+      int lo = fromHexChar(i[2]);
+      if (hi >= 0 && lo >= 0) {
+        value[valueLength] = static_cast<uint8_t>(16 * hi + lo);
+        hasNonPeriod = hasNonPeriod || value[valueLength] != '.';
+        ++valueLength;
+      }
+      else {
+        // invalid hex characters, so just keep the escaped string
+        std::copy(i, i + 3, value + valueLength);
+        valueLength += 3;
+        hasNonPeriod = true;
+      }
+      i += 2;
     }
-    catch (CryptoPP::Exception& e) {
-      throw Error("Cannot convert to a ImplicitSha256DigestComponent (invalid hex encoding)");
+    else {
+      value[valueLength++] = static_cast<uint8_t>(*i);
+      hasNonPeriod = hasNonPeriod || *i != '.';
     }
   }
-  else {
-    std::string value = unescape(trimmedString);
-
-    if (value.find_first_not_of(".") == std::string::npos) {
-      // Special case for component of only periods.
-      if (value.size() <= 2)
-        // Zero, one or two periods is illegal.  Ignore this component.
-        throw Error("Illegal URI (name component cannot be . or ..)");
-      else
-        // Remove 3 periods.
-        return Component(reinterpret_cast<const uint8_t*>(&value[3]), value.size() - 3);
-    }
+
+  type = tlv::NameComponent;
+  if (!hasNonPeriod) {
+    // Special case for component of only periods.
+    if (valueLength <= 2)
+      // Zero, one or two periods is illegal.  Ignore this component.
+      throw Error("Illegal URI (name component cannot be . or ..)");
     else
-      return Component(reinterpret_cast<const uint8_t*>(&value[0]), value.size());
+      // Remove 3 periods.
+      return valueLength - 3;
   }
+  return valueLength;
 }
 
-
-void
-Component::toUri(std::ostream& result) const
+size_t
+Component::toUri(char* buffer, size_t bufferSize) const
 {
-  if (type() == tlv::ImplicitSha256DigestComponent) {
-    result << getSha256DigestUriPrefix();
+  static const char UPPER_HEX_DIGITS[] = "0123456789ABCDEF";
+  static const char LOWER_HEX_DIGITS[] = "0123456789abcdef";
 
-    CryptoPP::StringSource(value(), value_size(), true,
-                           new CryptoPP::HexEncoder(new CryptoPP::FileSink(result), false));
-  }
-  else {
-    const uint8_t* value = this->value();
-    size_t valueSize = value_size();
+  const uint8_t* value = this->value();
+  size_t valueSize = value_size();
+  size_t length = 0;
+  auto put = [&] (char c) {
+    if (length < bufferSize)
+      buffer[length] = c;
+    ++length;
+  };
 
-    bool gotNonDot = false;
+  if (type() == tlv::ImplicitSha256DigestComponent) {
+    for (char c : getSha256DigestUriPrefix())
+      put(c);
     for (size_t i = 0; i < valueSize; ++i) {
-      if (value[i] != 0x2e) {
-        gotNonDot = true;
-        break;
-      }
+      put(LOWER_HEX_DIGITS[value[i] >> 4]);
+      put(LOWER_HEX_DIGITS[value[i] & 0xF]);
     }
-    if (!gotNonDot) {
-      // Special case for component of zero or more periods.  Add 3 periods.
-      result << "...";
-      for (size_t i = 0; i < valueSize; ++i)
-        result << '.';
+    return length;
+  }
+
+  if (std::find_if(value, value + valueSize, [] (uint8_t x) { return x != 0x2e; }) ==
+      value + valueSize) {
+    // Special case for component of zero or more periods.  Add 3 periods.
+    for (size_t i = 0; i < valueSize + 3; ++i)
+      put('.');
+    return length;
+  }
+
+  for (size_t i = 0; i < valueSize; ++i) {
+    uint8_t x = value[i];
+    // Check for 0-9, A-Z, a-z, (+), (-), (.), (_)
+    if ((x >= 0x30 && x <= 0x39) || (x >= 0x41 && x <= 0x5a) ||
+        (x >= 0x61 && x <= 0x7a) || x == 0x2b || x == 0x2d ||
+        x == 0x2e || x == 0x5f) {
+      put(static_cast<char>(x));
     }
     else {
-      // In case we need to escape, set to upper case hex and save the previous flags.
-      std::ios::fmtflags saveFlags = result.flags(std::ios::hex | std::ios::uppercase);
-
-      for (size_t i = 0; i < valueSize; ++i) {
-        uint8_t x = value[i];
-        // Check for 0-9, A-Z, a-z, (+), (-), (.), (_)
-        if ((x >= 0x30 && x <= 0x39) || (x >= 0x41 && x <= 0x5a) ||
-            (x >= 0x61 && x <= 0x7a) || x == 0x2b || x == 0x2d ||
-            x == 0x2e || x == 0x5f)
-          result << x;
-        else {
-          result << '%';
-          if (x < 16)
-            result << '0';
-          result << static_cast<uint32_t>(x);
-        }
-      }
-
-      // Restore.
-      result.flags(saveFlags);
+      put('%');
+      put(UPPER_HEX_DIGITS[x >> 4]);
+      put(UPPER_HEX_DIGITS[x & 0xF]);
     }
   }
+  return length;
+}
+
+void
+Component::toUri(std::ostream& result) const
+{
+  char buffer[256];
+  size_t length = toUri(buffer, sizeof(buffer));
+  if (length <= sizeof(buffer)) {
+    result.write(buffer, length);
+  }
+  else {
+    std::string uri(length, '\0');
+    toUri(&uri[0], length);
+    result << uri;
+  }
 }
 
 std::string
 Component::toUri() const
 {
-  std::ostringstream os;
-  toUri(os);
-  return os.str();
+  char buffer[256];
+  size_t length = toUri(buffer, sizeof(buffer));
+  if (length <= sizeof(buffer))
+    return std::string(buffer, length);
+
+  std::string uri(length, '\0');
+  toUri(&uri[0], length);
+  return uri;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -479,5 +538,63 @@ Component::wireDecode(const Block& wire)
   // validity check is done within Component(const Block& wire)
 }
 
+namespace {
+
+/** @brief MurmurHash64A over an octet string
+ *
+ *  The input is consumed eight octets at a time; this is considerably faster than
+ *  boost::hash_range, which combines one octet at a time.
+ */
+uint64_t
+hashOctets(const uint8_t* data, size_t size)
+{
+  static const uint64_t MULTIPLIER = 0xc6a4a7935bd1e995ULL;
+  static const int SHIFT = 47;
+
+  uint64_t h = size * MULTIPLIER;
+
+  const uint8_t* wordsEnd = data + (size & ~static_cast<size_t>(7));
+  for (; data != wordsEnd; data += 8) {
+    uint64_t k;
+    std::memcpy(&k, data, sizeof(k));
+    k *= MULTIPLIER;
+    k ^= k >> SHIFT;
+    k *= MULTIPLIER;
+    h ^= k;
+    h *= MULTIPLIER;
+  }
+
+  switch (size & 7) {
+  case 7: h ^= static_cast<uint64_t>(data[6]) << 48; // fall through
+  case 6: h ^= static_cast<uint64_t>(data[5]) << 40; // fall through
+  case 5: h ^= static_cast<uint64_t>(data[4]) << 32; // fall through
+  case 4: h ^= static_cast<uint64_t>(data[3]) << 24; // fall through
+  case 3: h ^= static_cast<uint64_t>(data[2]) << 16; // fall through
+  case 2: h ^= static_cast<uint64_t>(data[1]) << 8;  // fall through
+  case 1: h ^= static_cast<uint64_t>(data[0]);
+    h *= MULTIPLIER;
+  }
+
+  h ^= h >> SHIFT;
+  h *= MULTIPLIER;
+  h ^= h >> SHIFT;
+  return h;
+}
+
+} // namespace
+
 } // namespace name
 } // namespace ndn
+
+namespace std {
+
+size_t
+hash<ndn::name::Component>::operator()(const ndn::name::Component& component) const
+{
+  if (component.value_size() == 0)
+    return static_cast<size_t>(ndn::name::hashOctets(nullptr, 0));
+
+  return static_cast<size_t>(ndn::name::hashOctets(component.value(), component.value_size()));
+}
+
+} // namespace std
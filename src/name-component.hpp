@@ -203,6 +203,24 @@ public:
     return fromEscapedString(escapedString.c_str(), 0, escapedString.size());
   }
 
+  /**
+   * @brief Decode the NDN URI representation of a component into a caller-provided buffer
+   *
+   * Whitespace around the representation is ignored, "%XX" escapes are decoded, three periods
+   * are removed from a value made of periods only, and "sha256digest=" followed by 64 hex
+   * digits denotes an ImplicitSha256DigestComponent.  No memory is allocated.
+   *
+   * @param uri the escaped component, without slashes
+   * @param uriLength length of @p uri
+   * @param[out] value receives the TLV-VALUE; must have room for @p uriLength octets,
+   *                   because a value is never longer than its representation
+   * @param[out] type receives tlv::NameComponent or tlv::ImplicitSha256DigestComponent
+   * @return length of the TLV-VALUE written to @p value
+   * @throw Error the representation is empty, "." or "..", or an invalid implicit digest
+   */
+  static size_t
+  decodeUri(const char* uri, size_t uriLength, uint8_t* value, uint32_t& type);
+
   /**
    * @brief Write *this to the output stream, escaping characters according to the NDN URI Scheme
    *
@@ -255,6 +273,17 @@ public:
   std::string
   toUri() const;
 
+  /**
+   * @brief Write the NDN URI representation of *this into a caller-provided buffer
+   *
+   * No terminating null character is written, and no memory is allocated.
+   *
+   * @return length of the whole representation; if it is larger than @p bufferSize,
+   *         only the first @p bufferSize characters have been written
+   */
+  size_t
+  toUri(char* buffer, size_t bufferSize) const;
+
   ////////////////////////////////////////////////////////////////////////////////
 
   /**
@@ -625,4 +654,19 @@ Component::Component(InputIterator begin, InputIterator end)
 } // namespace name
 } // namespace ndn
 
+namespace std {
+
+/** @brief hash of a name component's TLV-VALUE
+ *
+ *  TLV-TYPE is not hashed, as Component::equals does not compare it.
+ */
+template<>
+struct hash<ndn::name::Component>
+{
+  size_t
+  operator()(const ndn::name::Component& component) const;
+};
+
+} // namespace std
+
 #endif // NDN_NAME_COMPONENT_HPP
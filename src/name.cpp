@@ -33,6 +33,9 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Name>));
@@ -43,17 +46,62 @@ static_assert(std::is_base_of<tlv::Error, Name::Error>::value,
 
 const size_t Name::npos = std::numeric_limits<size_t>::max();
 
+/** @brief prepend the wire encoding of components [first, last) of @p name
+ *
+ *  If the name has wire encoding, its components are contiguous in the wire buffer
+ *  and are copied with a single prependByteArray call.
+ */
 template<bool T>
-size_t
-Name::wireEncode(EncodingImpl<T>& encoder) const
+static size_t
+prependComponents(EncodingImpl<T>& encoder, const Name& name, size_t first, size_t last)
 {
+  if (first >= last)
+    return 0;
+
+  if (name.hasWire()) {
+    const uint8_t* begin = name[first].wire();
+    const uint8_t* end = name[last - 1].wire() + name[last - 1].size();
+    return encoder.prependByteArray(begin, end - begin);
+  }
+
   size_t totalLength = 0;
+  for (size_t i = last; i > first; --i) {
+    totalLength += name[i - 1].wireEncode(encoder);
+  }
+  return totalLength;
+}
 
-  for (const_reverse_iterator i = rbegin(); i != rend(); ++i)
-    {
-      totalLength += i->wireEncode(encoder);
-    }
+/** @brief create a parsed Name block holding components [first1, last1) of @p name1
+ *         followed by components [first2, last2) of @p name2
+ *
+ *  All components of the result reference a single buffer of the exact size.
+ */
+static Block
+makeNameBlock(const Name& name1, size_t first1, size_t last1,
+              const Name& name2, size_t first2, size_t last2)
+{
+  EncodingEstimator estimator;
+  size_t valueLength = prependComponents(estimator, name1, first1, last1) +
+                       prependComponents(estimator, name2, first2, last2);
+  size_t estimatedSize = valueLength + tlv::sizeOfVarNumber(valueLength) +
+                         tlv::sizeOfVarNumber(tlv::Name);
+
+  EncodingBuffer encoder(estimatedSize, 0);
+  prependComponents(encoder, name2, first2, last2);
+  prependComponents(encoder, name1, first1, last1);
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(tlv::Name);
+
+  Block block = encoder.block();
+  block.parse();
+  return block;
+}
 
+template<bool T>
+size_t
+Name::wireEncode(EncodingImpl<T>& encoder) const
+{
+  size_t totalLength = prependComponents(encoder, *this, 0, size());
   totalLength += encoder.prependVarNumber(totalLength);
   totalLength += encoder.prependVarNumber(tlv::Name);
   return totalLength;
@@ -94,80 +142,127 @@ Name::wireDecode(const Block& wire)
 }
 
 void
-Name::set(const char* uriOrig)
+Name::set(const char* uri)
 {
   clear();
 
-  std::string uri = uriOrig;
-  trim(uri);
-  if (uri.size() == 0)
+  const char* begin = uri;
+  const char* end = uri + std::char_traits<char>::length(uri);
+  trim(begin, end);
+  if (begin == end)
     return;
 
-  size_t iColon = uri.find(':');
-  if (iColon != std::string::npos) {
+  const char* colon = std::find(begin, end, ':');
+  if (colon != end) {
     // Make sure the colon came before a '/'.
-    size_t iFirstSlash = uri.find('/');
-    if (iFirstSlash == std::string::npos || iColon < iFirstSlash) {
+    const char* firstSlash = std::find(begin, end, '/');
+    if (firstSlash == end || colon < firstSlash) {
       // Omit the leading protocol such as ndn:
-      uri.erase(0, iColon + 1);
-      trim(uri);
+      begin = colon + 1;
+      trim(begin, end);
     }
   }
 
   // Trim the leading slash and possibly the authority.
-  if (uri[0] == '/') {
-    if (uri.size() >= 2 && uri[1] == '/') {
+  if (begin != end && *begin == '/') {
+    if (end - begin >= 2 && begin[1] == '/') {
       // Strip the authority following "//".
-      size_t iAfterAuthority = uri.find('/', 2);
-      if (iAfterAuthority == std::string::npos)
+      const char* afterAuthority = std::find(begin + 2, end, '/');
+      if (afterAuthority == end)
         // Unusual case: there was only an authority.
         return;
-      else {
-        uri.erase(0, iAfterAuthority + 1);
-        trim(uri);
-      }
+      begin = afterAuthority + 1;
     }
     else {
-      uri.erase(0, 1);
-      trim(uri);
+      ++begin;
     }
+    trim(begin, end);
   }
 
-  size_t iComponentStart = 0;
+  if (begin == end)
+    return;
+
+  // Every component is decoded directly into the wire encoding of the name.  A TLV-VALUE is
+  // never longer than its escaped representation, which bounds the size of the buffer.
+  static const size_t MAX_NAME_HEADER_LENGTH = 1 + 9;
+  size_t nComponents = std::count(begin, end, '/') + 1;
+  size_t uriLength = end - begin;
+  BufferPtr buffer = make_shared<Buffer>(MAX_NAME_HEADER_LENGTH + uriLength +
+                                         nComponents * (1 + tlv::sizeOfVarNumber(uriLength)));
+  uint8_t* valueBegin = buffer->data() + MAX_NAME_HEADER_LENGTH;
+  uint8_t* output = valueBegin;
+
+  // Unescape the components.  A trailing '/' does not start a component.
+  for (const char* componentBegin = begin; componentBegin < end; ) {
+    const char* componentEnd = std::find(componentBegin, end, '/');
+    size_t componentUriLength = componentEnd - componentBegin;
+    size_t maxHeaderLength = 1 + tlv::sizeOfVarNumber(componentUriLength);
+
+    uint32_t type = tlv::NameComponent;
+    size_t valueLength = Component::decodeUri(componentBegin, componentUriLength,
+                                              output + maxHeaderLength, type);
+    size_t headerLength = tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueLength);
+    if (headerLength < maxHeaderLength)
+      std::memmove(output + headerLength, output + maxHeaderLength, valueLength);
+    output += tlv::writeVarNumber(output, type);
+    output += tlv::writeVarNumber(output, valueLength);
+    output += valueLength;
+
+    componentBegin = componentEnd + 1;
+  }
 
-  // Unescape the components.
-  while (iComponentStart < uri.size()) {
-    size_t iComponentEnd = uri.find("/", iComponentStart);
-    if (iComponentEnd == std::string::npos)
-      iComponentEnd = uri.size();
+  size_t valueLength = output - valueBegin;
+  uint8_t* nameBegin = valueBegin - tlv::sizeOfVarNumber(tlv::Name) -
+                       tlv::sizeOfVarNumber(valueLength);
+  tlv::writeVarNumber(nameBegin + tlv::writeVarNumber(nameBegin, tlv::Name), valueLength);
 
-    Component component = Component::fromEscapedString(&uri[0], iComponentStart, iComponentEnd);
-    // Ignore illegal components.  This also gets rid of a trailing '/'.
-    if (!component.empty())
-      append(Component(component));
+  m_nameBlock = Block(buffer, buffer->begin() + (nameBegin - buffer->data()),
+                      buffer->begin() + (output - buffer->data()));
+  m_nameBlock.parse();
+}
 
-    iComponentStart = iComponentEnd + 1;
+size_t
+Name::toUri(char* buffer, size_t bufferSize) const
+{
+  if (empty()) {
+    if (bufferSize > 0)
+      buffer[0] = '/';
+    return 1;
   }
+
+  size_t length = 0;
+  for (const Component& component : *this) {
+    if (length < bufferSize)
+      buffer[length] = '/';
+    ++length;
+
+    size_t offset = std::min(length, bufferSize);
+    length += component.toUri(buffer + offset, bufferSize - offset);
+  }
+  return length;
 }
 
 std::string
 Name::toUri() const
 {
-  std::ostringstream os;
-  os << *this;
-  return os.str();
+  char buffer[256];
+  size_t length = toUri(buffer, sizeof(buffer));
+  if (length <= sizeof(buffer))
+    return std::string(buffer, length);
+
+  std::string uri(length, '\0');
+  toUri(&uri[0], length);
+  return uri;
 }
 
 Name&
 Name::append(const Name& name)
 {
-  if (&name == this)
-    // Copying from this name, so need to make a copy first.
-    return append(Name(name));
-
-  for (size_t i = 0; i < name.size(); ++i)
-    append(name.at(i));
+  if (name.empty())
+    return *this;
 
+  // also correct for &name == this, because both names are read before m_nameBlock is replaced
+  m_nameBlock = makeNameBlock(*this, 0, size(), name, 0, name.size());
   return *this;
 }
 
@@ -244,15 +339,18 @@ Name::appendImplicitSha256Digest(const uint8_t* digest, size_t digestSize)
 Name
 Name::getSubName(size_t iStartComponent, size_t nComponents) const
 {
-  Name result;
-
   size_t iEnd = this->size();
   if (nComponents != npos)
     iEnd = std::min(this->size(), iStartComponent + nComponents);
 
-  for (size_t i = iStartComponent; i < iEnd; ++i)
-    result.append(at(i));
+  if (iStartComponent >= iEnd)
+    return Name();
 
+  if (iStartComponent == 0 && iEnd == this->size())
+    return *this;
+
+  Name result;
+  result.m_nameBlock = makeNameBlock(*this, iStartComponent, iEnd, result, 0, 0);
   return result;
 }
 
@@ -275,8 +373,14 @@ Name::equals(const Name& name) const
   if (size() != name.size())
     return false;
 
+  if (hasWire() && name.hasWire() &&
+      m_nameBlock.value_size() == name.m_nameBlock.value_size() &&
+      std::equal(m_nameBlock.value_begin(), m_nameBlock.value_end(),
+                 name.m_nameBlock.value_begin()))
+    return true;
+
   for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
+    if (get(i) != name.get(i))
       return false;
   }
 
@@ -290,24 +394,50 @@ Name::isPrefixOf(const Name& name) const
   if (size() > name.size())
     return false;
 
+  // Identical leading octets decode to identical leading components.  Different octets
+  // may still encode equal components (non-minimal TLV-LENGTH), so a mismatch is rechecked.
+  if (hasWire() && name.hasWire() &&
+      m_nameBlock.value_size() <= name.m_nameBlock.value_size() &&
+      std::equal(m_nameBlock.value_begin(), m_nameBlock.value_end(),
+                 name.m_nameBlock.value_begin()))
+    return true;
+
   // Check if at least one of given components doesn't match.
   for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
+    if (get(i) != name.get(i))
       return false;
   }
 
   return true;
 }
 
+std::vector<size_t>
+Name::getPrefixHashes() const
+{
+  std::hash<Component> hashComponent;
+  std::vector<size_t> hashes(size() + 1);
+
+  size_t seed = 0;
+  hashes[0] = seed;
+  for (size_t i = 0; i < size(); ++i) {
+    boost::hash_combine(seed, hashComponent(get(i)));
+    hashes[i + 1] = seed;
+  }
+  return hashes;
+}
+
 int
 Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t count2) const
 {
+  if (pos1 > this->size() || pos2 > other.size())
+    throw Error("Requested component does not exist (out of bounds)");
+
   count1 = std::min(count1, this->size() - pos1);
   count2 = std::min(count2, other.size() - pos2);
   size_t count = std::min(count1, count2);
 
   for (size_t i = 0; i < count; ++i) {
-    int comp = this->at(pos1 + i).compare(other.at(pos2 + i));
+    int comp = this->get(pos1 + i).compare(other.get(pos2 + i));
     if (comp != 0) { // i-th component differs
       return comp;
     }
@@ -319,17 +449,12 @@ Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t
 std::ostream&
 operator<<(std::ostream& os, const Name& name)
 {
-  if (name.empty())
-    {
-      os << "/";
-    }
+  char buffer[256];
+  size_t length = name.toUri(buffer, sizeof(buffer));
+  if (length <= sizeof(buffer))
+    os.write(buffer, length);
   else
-    {
-      for (Name::const_iterator i = name.begin(); i != name.end(); i++) {
-        os << "/";
-        i->toUri(os);
-      }
-    }
+    os << name.toUri();
   return os;
 }
 
@@ -349,8 +474,12 @@ namespace std {
 size_t
 hash<ndn::Name>::operator()(const ndn::Name& name) const
 {
-  return boost::hash_range(name.wireEncode().wire(),
-                           name.wireEncode().wire() + name.wireEncode().size());
+  hash<ndn::name::Component> hashComponent;
+  size_t seed = 0;
+  for (const ndn::name::Component& component : name) {
+    boost::hash_combine(seed, hashComponent(component));
+  }
+  return seed;
 }
 
 } // namespace std
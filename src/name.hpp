@@ -204,6 +204,7 @@ public:
 
   /**
    * Append the components of the given name to this name.
+   * The resulting name is encoded into a single buffer in one pass.
    * @param name The Name with components to append.
    * @return This name so that you can chain calls to append.
    */
@@ -224,7 +225,8 @@ public:
    * @param iStartComponent The index if the first component to get.
    * @param nComponents The number of components starting at iStartComponent.
    *                    Use npos to get the sub Name until the end of this Name.
-   * @return A new name.
+   * @return A new name.  Its components share a single buffer, which is filled with
+   *         one copy when this name has wire encoding.
    */
   Name
   getSubName(size_t iStartComponent, size_t nComponents = npos) const;
@@ -253,6 +255,17 @@ public:
   std::string
   toUri() const;
 
+  /**
+   * @brief Write the URI of this name into a caller-provided buffer
+   *
+   * No terminating null character is written, and no memory is allocated.
+   *
+   * @return length of the whole URI; if it is larger than @p bufferSize,
+   *         only the first @p bufferSize characters have been written
+   */
+  size_t
+  toUri(char* buffer, size_t bufferSize) const;
+
   /**
    * @brief Append a component with the number encoded as nonNegativeInteger
    *
@@ -379,6 +392,17 @@ public:
   bool
   isPrefixOf(const Name& name) const;
 
+  /**
+   * @brief Compute the hashes of all prefixes of this name in a single pass
+   * @return a vector of size() + 1 elements, in which element i equals
+   *         std::hash<Name>()(getPrefix(i))
+   *
+   * This allows a longest prefix match to probe one hash table per name length
+   * without building each prefix.
+   */
+  std::vector<size_t>
+  getPrefixHashes() const;
+
   //
   // vector equivalent interface.
   //
@@ -469,6 +493,8 @@ public:
    *         to [pos2, pos2+count2) components in \p other
    *
    *  This is equivalent to this->getSubName(pos1, count1).compare(other.getSubName(pos2, count2));
+   *
+   *  \throw Error \p pos1 is greater than size(), or \p pos2 is greater than other.size()
    */
   int
   compare(size_t pos1, size_t count1,
@@ -620,6 +646,12 @@ Name::hasWire() const
 } // namespace ndn
 
 namespace std {
+
+/** @brief hash of a Name, computed incrementally over its components
+ *
+ *  The hash of a name extends the hash of its prefix with the hash of each further
+ *  component, so Name::getPrefixHashes can compute the hashes of all prefixes at once.
+ */
 template<>
 struct hash<ndn::Name>
 {
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "certificate-cache-lru.hpp"
+
+namespace ndn {
+
+CertificateCacheLru::CertificateCacheLru(size_t capacity/* = 1000*/,
+                                         const time::nanoseconds& defaultTtl/* = 3600s*/)
+  : m_capacity(capacity)
+  , m_defaultTtl(defaultTtl)
+{
+  BOOST_ASSERT(m_capacity > 0);
+}
+
+CertificateCacheLru::~CertificateCacheLru()
+{
+}
+
+void
+CertificateCacheLru::insertCertificate(shared_ptr<const IdentityCertificate> certificate)
+{
+  time::nanoseconds ttl = (certificate->getFreshnessPeriod() >= time::seconds::zero() ?
+                           time::nanoseconds(certificate->getFreshnessPeriod()) : m_defaultTtl);
+
+  Entry entry;
+  entry.name = certificate->getName().getPrefix(-1);
+  entry.certificate = certificate;
+  entry.expiry = time::steady_clock::now() + ttl;
+
+  Cache::index<byName>::type& byNameIndex = m_cache.get<byName>();
+  Cache::index<byName>::type::iterator it = byNameIndex.find(entry.name);
+  if (it != byNameIndex.end()) {
+    // keep the decoded key if the same certificate is re-inserted to extend its lifetime
+    if (it->certificate->getPublicKeyInfo() == certificate->getPublicKeyInfo())
+      entry.verifier = it->verifier;
+    byNameIndex.replace(it, entry);
+    m_cache.get<byUsage>().relocate(m_cache.get<byUsage>().end(), m_cache.project<byUsage>(it));
+    return;
+  }
+
+  if (m_cache.size() >= m_capacity) {
+    removeExpired();
+    if (m_cache.size() >= m_capacity)
+      m_cache.get<byUsage>().pop_front();
+  }
+
+  m_cache.insert(entry);
+}
+
+shared_ptr<const IdentityCertificate>
+CertificateCacheLru::getCertificate(const Name& certificateName)
+{
+  const Entry* entry = find(certificateName);
+  if (entry == nullptr)
+    return shared_ptr<const IdentityCertificate>();
+
+  return entry->certificate;
+}
+
+shared_ptr<const PublicKeyVerifier>
+CertificateCacheLru::getVerifier(const Name& certificateName)
+{
+  const Entry* entry = find(certificateName);
+  if (entry == nullptr)
+    return shared_ptr<const PublicKeyVerifier>();
+
+  if (!static_cast<bool>(entry->verifier))
+    entry->verifier = make_shared<PublicKeyVerifier>(entry->certificate->getPublicKeyInfo());
+
+  return entry->verifier;
+}
+
+void
+CertificateCacheLru::reset()
+{
+  m_cache.clear();
+}
+
+size_t
+CertificateCacheLru::getSize()
+{
+  removeExpired();
+  return m_cache.size();
+}
+
+const CertificateCacheLru::Entry*
+CertificateCacheLru::find(const Name& certificateName)
+{
+  Cache::index<byName>::type& byNameIndex = m_cache.get<byName>();
+  Cache::index<byName>::type::iterator it = byNameIndex.find(certificateName);
+  if (it == byNameIndex.end())
+    return nullptr;
+
+  if (it->expiry <= time::steady_clock::now()) {
+    byNameIndex.erase(it);
+    return nullptr;
+  }
+
+  m_cache.get<byUsage>().relocate(m_cache.get<byUsage>().end(), m_cache.project<byUsage>(it));
+  return &*it;
+}
+
+void
+CertificateCacheLru::removeExpired()
+{
+  Cache::index<byExpiry>::type& byExpiryIndex = m_cache.get<byExpiry>();
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  while (!byExpiryIndex.empty() && byExpiryIndex.begin()->expiry <= now) {
+    byExpiryIndex.erase(byExpiryIndex.begin());
+  }
+}
+
+} // namespace ndn
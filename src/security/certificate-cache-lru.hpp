@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_CERTIFICATE_CACHE_LRU_HPP
+#define NDN_SECURITY_CERTIFICATE_CACHE_LRU_HPP
+
+#include "../common.hpp"
+#include "certificate-cache.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+namespace ndn {
+
+/**
+ * @brief Size-bounded cache of validated certificates with LRU eviction
+ *
+ * Like CertificateCacheTtl, a certificate stays in the cache for its freshness period
+ * (or the default TTL), and re-inserting it extends its lifetime.  However, expiration is
+ * checked lazily when the cache is accessed, so the cache does not need an io_service and
+ * does not schedule a timer per certificate.  When the cache is full, the least recently
+ * used certificate is evicted.
+ *
+ * The public key of each certificate is decoded at most once: the verifier returned by
+ * getVerifier() is kept alongside the certificate and reused by subsequent calls.
+ *
+ * The cache is not thread-safe; it must be accessed from one thread, normally the thread
+ * that processes the events of the validator's Face.
+ */
+class CertificateCacheLru : public CertificateCache
+{
+public:
+  /**
+   * @param capacity maximum number of certificates in the cache, must be positive
+   * @param defaultTtl lifetime of certificates without a freshness period
+   */
+  explicit
+  CertificateCacheLru(size_t capacity = 1000,
+                      const time::nanoseconds& defaultTtl = time::seconds(3600));
+
+  virtual
+  ~CertificateCacheLru();
+
+  virtual void
+  insertCertificate(shared_ptr<const IdentityCertificate> certificate);
+
+  virtual shared_ptr<const IdentityCertificate>
+  getCertificate(const Name& certificateNameWithoutVersion);
+
+  virtual shared_ptr<const PublicKeyVerifier>
+  getVerifier(const Name& certificateNameWithoutVersion);
+
+  virtual void
+  reset();
+
+  /// @note expired certificates are removed before counting
+  virtual size_t
+  getSize();
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+private:
+  struct Entry
+  {
+    Name name;
+    shared_ptr<const IdentityCertificate> certificate;
+    time::steady_clock::TimePoint expiry;
+    mutable shared_ptr<const PublicKeyVerifier> verifier; ///< created on first use
+  };
+
+  class byName;
+  class byUsage;
+  class byExpiry;
+
+  typedef boost::multi_index_container<
+    Entry,
+    boost::multi_index::indexed_by<
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byName>,
+        boost::multi_index::member<Entry, Name, &Entry::name>,
+        std::hash<Name>
+      >,
+
+      // the least recently used entry is at the front
+      boost::multi_index::sequenced<
+        boost::multi_index::tag<byUsage>
+      >,
+
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byExpiry>,
+        boost::multi_index::member<Entry, time::steady_clock::TimePoint, &Entry::expiry>
+      >
+    >
+  > Cache;
+
+  /**
+   * @brief Find an unexpired entry and mark it as the most recently used
+   * @return pointer to the entry, or nullptr if not found or expired
+   */
+  const Entry*
+  find(const Name& certificateNameWithoutVersion);
+
+  void
+  removeExpired();
+
+private:
+  size_t m_capacity;
+  time::nanoseconds m_defaultTtl;
+  Cache m_cache;
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_CERTIFICATE_CACHE_LRU_HPP
@@ -28,6 +28,8 @@
 #include "certificate-cache.hpp"
 #include "../util/scheduler.hpp"
 
+#include <unordered_map>
+
 namespace ndn {
 
 /**
@@ -69,7 +71,7 @@ private:
   removeAll();
 
 protected:
-  typedef std::map<Name, std::pair<shared_ptr<const IdentityCertificate>, EventId> > Cache;
+  typedef std::unordered_map<Name, std::pair<shared_ptr<const IdentityCertificate>, EventId> > Cache;
 
   time::seconds m_defaultTtl;
   Cache m_cache;
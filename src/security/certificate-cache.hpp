@@ -26,6 +26,7 @@
 
 #include "../name.hpp"
 #include "identity-certificate.hpp"
+#include "public-key-verifier.hpp"
 
 namespace ndn {
 
@@ -46,6 +47,25 @@ public:
   virtual shared_ptr<const IdentityCertificate>
   getCertificate(const Name& certificateNameWithoutVersion) = 0;
 
+  /**
+   * @brief Get a verifier for the public key of a cached certificate
+   *
+   * The default implementation decodes the public key of the certificate on every call.
+   * Caches that keep decoded keys alongside the certificates should override it.
+   *
+   * @return the verifier, or nullptr if the certificate is not in the cache
+   */
+  virtual shared_ptr<const PublicKeyVerifier>
+  getVerifier(const Name& certificateNameWithoutVersion)
+  {
+    shared_ptr<const IdentityCertificate> certificate =
+      getCertificate(certificateNameWithoutVersion);
+    if (!static_cast<bool>(certificate))
+      return nullptr;
+
+    return make_shared<PublicKeyVerifier>(certificate->getPublicKeyInfo());
+  }
+
   virtual void
   reset() = 0;
 
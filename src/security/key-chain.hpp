@@ -227,6 +227,19 @@ public:
   void
   sign(T& packet, const Name& certificateName);
 
+  /**
+   * @brief Sign a packet using a particular certificate.
+   *
+   * Unlike the overload taking a certificate name, this does not look up the certificate in
+   * PIB, so that a certificate retrieved once can be used to sign many packets.
+   *
+   * @param packet The packet to be signed.
+   * @param certificate The signing certificate.
+   */
+  template<typename T>
+  void
+  sign(T& packet, const IdentityCertificate& certificate);
+
   /**
    * @brief Sign the byte array using a particular certificate.
    *
@@ -471,6 +484,16 @@ public:
     return m_pib->getAllCertificateNamesOfKey(keyName, nameList, isDefault);
   }
 
+  /**
+   * @brief Visit every certificate with its key and identity in one pass
+   * @sa SecPublicInfo::enumerateAll
+   */
+  void
+  enumerateAll(const SecPublicInfo::PibEntryCallback& onEntry) const
+  {
+    return m_pib->enumerateAll(onEntry);
+  }
+
   void
   deleteCertificateInfo(const Name& certificateName)
   {
@@ -696,16 +719,6 @@ private:
   void
   setDefaultCertificateInternal();
 
-  /**
-   * @brief Sign a packet using a pariticular certificate.
-   *
-   * @param packet The packet to be signed.
-   * @param certificate The signing certificate.
-   */
-  template<typename T>
-  void
-  sign(T& packet, const IdentityCertificate& certificate);
-
   /**
    * @brief Generate a key pair for the specified identity.
    *
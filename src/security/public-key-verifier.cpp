@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "public-key-verifier.hpp"
+
+#include "cryptopp.hpp"
+
+namespace ndn {
+
+static const CryptoPP::OID SECP256R1("1.2.840.10045.3.1.7");
+static const CryptoPP::OID SECP384R1("1.3.132.0.34");
+
+class PublicKeyVerifier::Impl
+{
+public:
+  explicit
+  Impl(const PublicKey& publicKey)
+    : keyType(publicKey.getKeyType())
+    , isValid(false)
+    , signatureSize(0)
+  {
+    try {
+      switch (keyType) {
+      case KEY_TYPE_RSA:
+        loadRsa(publicKey.get());
+        break;
+      case KEY_TYPE_ECDSA:
+        loadEcdsa(publicKey.get());
+        break;
+      default:
+        break;
+      }
+    }
+    catch (CryptoPP::Exception&) {
+      isValid = false;
+    }
+  }
+
+  bool
+  verify(const uint8_t* buf, size_t size, const Signature& sig) const
+  {
+    if (!isValid)
+      return false;
+
+    try {
+      switch (sig.getType()) {
+      case tlv::SignatureSha256WithRsa:
+        if (keyType != KEY_TYPE_RSA)
+          return false;
+
+        return rsaVerifier.VerifyMessage(buf, size,
+                                         sig.getValue().value(), sig.getValue().value_size());
+      case tlv::SignatureSha256WithEcdsa:
+        {
+          if (keyType != KEY_TYPE_ECDSA)
+            return false;
+
+          uint8_t buffer[96];
+          size_t usedSize = CryptoPP::DSAConvertSignatureFormat(buffer, signatureSize,
+                                                                CryptoPP::DSA_P1363,
+                                                                sig.getValue().value(),
+                                                                sig.getValue().value_size(),
+                                                                CryptoPP::DSA_DER);
+          return ecdsaVerifier.VerifyMessage(buf, size, buffer, usedSize);
+        }
+      default:
+        // Unsupported sig type
+        return false;
+      }
+    }
+    catch (CryptoPP::Exception&) {
+      return false;
+    }
+  }
+
+private:
+  void
+  loadRsa(const Buffer& der)
+  {
+    using namespace CryptoPP;
+
+    ByteQueue queue;
+    queue.Put(reinterpret_cast<const byte*>(der.buf()), der.size());
+    rsaVerifier.AccessKey().Load(queue);
+    isValid = true;
+  }
+
+  void
+  loadEcdsa(const Buffer& der)
+  {
+    using namespace CryptoPP;
+
+    StringSource src(der.buf(), der.size(), true);
+    BERSequenceDecoder subjectPublicKeyInfo(src);
+    {
+      BERSequenceDecoder algorithmInfo(subjectPublicKeyInfo);
+      {
+        OID algorithm;
+        algorithm.decode(algorithmInfo);
+
+        OID curveId;
+        curveId.decode(algorithmInfo);
+
+        // P1363 signature consists of two integers of the size of the curve order
+        if (curveId == SECP256R1)
+          signatureSize = 64;
+        else if (curveId == SECP384R1)
+          signatureSize = 96;
+        else
+          return;
+      }
+    }
+
+    ByteQueue queue;
+    queue.Put(reinterpret_cast<const byte*>(der.buf()), der.size());
+    ecdsaVerifier.AccessKey().Load(queue);
+    isValid = true;
+  }
+
+public:
+  KeyType keyType;
+  bool isValid;
+
+private:
+  CryptoPP::RSASS<CryptoPP::PKCS1v15, CryptoPP::SHA256>::Verifier rsaVerifier;
+  CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>::Verifier ecdsaVerifier;
+  size_t signatureSize;
+};
+
+PublicKeyVerifier::PublicKeyVerifier(const PublicKey& publicKey)
+  : m_impl(new Impl(publicKey))
+{
+}
+
+PublicKeyVerifier::~PublicKeyVerifier()
+{
+}
+
+bool
+PublicKeyVerifier::isValid() const
+{
+  return m_impl->isValid;
+}
+
+KeyType
+PublicKeyVerifier::getKeyType() const
+{
+  return m_impl->keyType;
+}
+
+bool
+PublicKeyVerifier::verify(const uint8_t* buf, size_t size, const Signature& sig) const
+{
+  return m_impl->verify(buf, size, sig);
+}
+
+} // namespace ndn
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_PUBLIC_KEY_VERIFIER_HPP
+#define NDN_SECURITY_PUBLIC_KEY_VERIFIER_HPP
+
+#include "../common.hpp"
+#include "../signature.hpp"
+#include "public-key.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Signature verifier bound to a single public key
+ *
+ * Decoding the DER of a public key and setting up the CryptoPP verifier is a significant
+ * part of the cost of verifying a signature.  PublicKeyVerifier does this work once in its
+ * constructor, so that the same key can be used to verify any number of signatures.
+ *
+ * verify() does not modify the verifier and may be called from several threads at once.
+ */
+class PublicKeyVerifier : noncopyable
+{
+public:
+  /**
+   * @brief Decode @p publicKey and prepare a verifier for it
+   *
+   * A key that cannot be decoded does not throw; such a verifier rejects every signature.
+   */
+  explicit
+  PublicKeyVerifier(const PublicKey& publicKey);
+
+  ~PublicKeyVerifier();
+
+  /// @brief Check whether the public key has been decoded successfully
+  bool
+  isValid() const;
+
+  KeyType
+  getKeyType() const;
+
+  /**
+   * @brief Verify the blob [@p buf, @p buf + @p size) against @p sig
+   *
+   * @return true if @p sig is a SHA256-RSA or SHA256-ECDSA signature that matches
+   *         the type of the key and is valid for the blob, false otherwise
+   */
+  bool
+  verify(const uint8_t* buf, size_t size, const Signature& sig) const;
+
+private:
+  class Impl;
+  unique_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_PUBLIC_KEY_VERIFIER_HPP
@@ -89,6 +89,16 @@ static const string INIT_CERT_TABLE =
   "CREATE INDEX cert_index ON Certificate(cert_name); "
   "CREATE INDEX subject ON Certificate(identity_name);";
 
+/**
+ * Indexes for the lookups by default flag and by key, created in existing PIBs as well
+ */
+static const string INIT_INDEXES =
+  "CREATE INDEX IF NOT EXISTS identity_default_index ON Identity(default_identity);      "
+  "CREATE INDEX IF NOT EXISTS key_default_index ON Key(default_key);                     "
+  "CREATE INDEX IF NOT EXISTS cert_key_index                                             "
+  "  ON Certificate(identity_name, key_identifier, default_cert);                        "
+  "CREATE INDEX IF NOT EXISTS cert_default_index ON Certificate(default_cert);           ";
+
 /**
  * A utility function to call the normal sqlite3_bind_text where the value and length are
  * value.c_str() and value.size().
@@ -139,6 +149,9 @@ SecPublicInfoSqlite3::SecPublicInfoSqlite3(const std::string& dir)
   initializeTable("Identity", INIT_ID_TABLE);      // Check if Identity table exists;
   initializeTable("Key", INIT_KEY_TABLE);          // Check if Key table exists;
   initializeTable("Certificate", INIT_CERT_TABLE); // Check if Certificate table exists;
+
+  // failure is not fatal, e.g., a read-only PIB works without the new indexes
+  sqlite3_exec(m_database, INIT_INDEXES.c_str(), nullptr, nullptr, nullptr);
 }
 
 SecPublicInfoSqlite3::~SecPublicInfoSqlite3()
@@ -867,6 +880,70 @@ SecPublicInfoSqlite3::getAllCertificateNamesOfKey(const Name& keyName,
   sqlite3_finalize(stmt);
 }
 
+void
+SecPublicInfoSqlite3::enumerateAll(const PibEntryCallback& onEntry)
+{
+  sqlite3_stmt* stmt;
+  sqlite3_prepare_v2(m_database,
+                     "SELECT i.identity_name, i.default_identity, k.key_identifier, k.default_key, \
+                             c.cert_name, c.default_cert \
+                      FROM Identity i \
+                      LEFT JOIN Key k ON k.identity_name=i.identity_name \
+                      LEFT JOIN Certificate c ON c.identity_name=k.identity_name \
+                                             AND c.key_identifier=k.key_identifier \
+                      ORDER BY i.default_identity DESC, i.rowid, \
+                               k.default_key DESC, k.rowid, \
+                               c.default_cert DESC, c.rowid",
+                     -1, &stmt, 0);
+
+  // consecutive rows usually share the identity and the key, whose names are parsed once
+  PibEntry entry;
+  string identityUri;
+  string keyId;
+  bool hasIdentity = false;
+  bool hasKey = false;
+
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    string rowIdentityUri = sqlite3_column_string(stmt, 0);
+    if (!hasIdentity || rowIdentityUri != identityUri) {
+      identityUri.swap(rowIdentityUri);
+      entry.identity = Name(identityUri);
+      hasIdentity = true;
+      hasKey = false;
+    }
+    entry.isDefaultIdentity = sqlite3_column_int(stmt, 1) != 0;
+
+    if (sqlite3_column_type(stmt, 2) == SQLITE_NULL) {
+      entry.keyName.clear();
+      entry.isDefaultKey = false;
+      hasKey = false;
+    }
+    else {
+      string rowKeyId = sqlite3_column_string(stmt, 2);
+      if (!hasKey || rowKeyId != keyId) {
+        keyId.swap(rowKeyId);
+        entry.keyName = entry.identity;
+        entry.keyName.append(keyId);
+        hasKey = true;
+      }
+      entry.isDefaultKey = sqlite3_column_int(stmt, 3) != 0;
+    }
+
+    if (sqlite3_column_type(stmt, 4) == SQLITE_NULL) {
+      entry.certificateName.clear();
+      entry.isDefaultCertificate = false;
+    }
+    else {
+      entry.certificateName = Name(sqlite3_column_string(stmt, 4));
+      entry.isDefaultCertificate = sqlite3_column_int(stmt, 5) != 0;
+    }
+
+    onEntry(entry);
+  }
+
+  sqlite3_finalize(stmt);
+}
+
 void
 SecPublicInfoSqlite3::deleteCertificateInfo(const Name& certName)
 {
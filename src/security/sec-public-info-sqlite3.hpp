@@ -120,6 +120,15 @@ public:
   virtual void
   getAllCertificateNamesOfKey(const Name& keyName, std::vector<Name>& nameList, bool isDefault);
 
+  /**
+   * @brief Visit every certificate with its key and identity in one joined query
+   *
+   * Rows are read from the query one at a time, so memory use does not grow with the size
+   * of the PIB.
+   */
+  virtual void
+  enumerateAll(const PibEntryCallback& onEntry);
+
   virtual void
   deleteCertificateInfo(const Name& certificateName);
 
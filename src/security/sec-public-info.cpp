@@ -103,6 +103,56 @@ SecPublicInfo::getNewKeyName(const Name& identityName, bool useKsk)
   return keyName;
 }
 
+void
+SecPublicInfo::enumerateAll(const PibEntryCallback& onEntry)
+{
+  PibEntry entry;
+
+  for (bool isDefaultIdentity : {true, false}) {
+    std::vector<Name> identities;
+    getAllIdentities(identities, isDefaultIdentity);
+    for (const Name& identity : identities) {
+      entry.identity = identity;
+      entry.isDefaultIdentity = isDefaultIdentity;
+      entry.keyName.clear();
+      entry.isDefaultKey = false;
+      entry.certificateName.clear();
+      entry.isDefaultCertificate = false;
+
+      bool hasKeys = false;
+      for (bool isDefaultKey : {true, false}) {
+        std::vector<Name> keyNames;
+        getAllKeyNamesOfIdentity(identity, keyNames, isDefaultKey);
+        for (const Name& keyName : keyNames) {
+          hasKeys = true;
+          entry.keyName = keyName;
+          entry.isDefaultKey = isDefaultKey;
+          entry.certificateName.clear();
+          entry.isDefaultCertificate = false;
+
+          bool hasCertificates = false;
+          for (bool isDefaultCertificate : {true, false}) {
+            std::vector<Name> certificateNames;
+            getAllCertificateNamesOfKey(keyName, certificateNames, isDefaultCertificate);
+            for (const Name& certificateName : certificateNames) {
+              hasCertificates = true;
+              entry.certificateName = certificateName;
+              entry.isDefaultCertificate = isDefaultCertificate;
+              onEntry(entry);
+            }
+          }
+          if (!hasCertificates) {
+            onEntry(entry);
+          }
+        }
+      }
+      if (!hasKeys) {
+        onEntry(entry);
+      }
+    }
+  }
+}
+
 void
 SecPublicInfo::addCertificateAsKeyDefault(const IdentityCertificate& certificate)
 {
@@ -49,6 +49,23 @@ public:
     }
   };
 
+  /**
+   * @brief An identity, one of its keys, and one of the key's certificates
+   *
+   * @sa enumerateAll
+   */
+  struct PibEntry
+  {
+    Name identity;
+    bool isDefaultIdentity;
+    Name keyName;              ///< empty if the identity has no keys
+    bool isDefaultKey;
+    Name certificateName;      ///< empty if the key has no certificates
+    bool isDefaultCertificate;
+  };
+
+  typedef function<void(const PibEntry& entry)> PibEntryCallback;
+
   explicit
   SecPublicInfo(const std::string& location);
 
@@ -269,6 +286,20 @@ public:
   virtual void
   getAllCertificateNamesOfKey(const Name& keyName, std::vector<Name>& nameList, bool isDefault) = 0;
 
+  /**
+   * @brief Visit every certificate with its key and identity in one pass
+   *
+   * @p onEntry is invoked once per certificate, once per key without certificates, and once
+   * per identity without keys.  The entries of an identity are consecutive, and so are the
+   * entries of a key.  Default identities, keys and certificates come before the others,
+   * and the others are in the order of the getAll* methods.
+   *
+   * The default implementation uses the getAll* methods, one call per identity and per key.
+   * An implementation should override it if it can do better.
+   */
+  virtual void
+  enumerateAll(const PibEntryCallback& onEntry);
+
   /*****************************************
    *            Delete Methods             *
    *****************************************/
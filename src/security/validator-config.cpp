@@ -22,7 +22,7 @@
  */
 
 #include "validator-config.hpp"
-#include "certificate-cache-ttl.hpp"
+#include "certificate-cache-lru.hpp"
 #include "../util/io.hpp"
 
 #include <boost/filesystem.hpp>
@@ -51,7 +51,7 @@ ValidatorConfig::ValidatorConfig(Face* face,
   , m_keyTimestampTtl(keyTimestampTtl)
 {
   if (!static_cast<bool>(m_certificateCache) && face != nullptr)
-    m_certificateCache = make_shared<CertificateCacheTtl>(ref(face->getIoService()));
+    m_certificateCache = make_shared<CertificateCacheLru>();
 }
 
 ValidatorConfig::ValidatorConfig(Face& face,
@@ -70,7 +70,7 @@ ValidatorConfig::ValidatorConfig(Face& face,
   , m_keyTimestampTtl(keyTimestampTtl)
 {
   if (!static_cast<bool>(m_certificateCache))
-    m_certificateCache = make_shared<CertificateCacheTtl>(ref(face.getIoService()));
+    m_certificateCache = make_shared<CertificateCacheLru>();
 }
 
 void
@@ -779,18 +779,22 @@ ValidatorConfig::checkSignature(const Packet& packet,
   const Name& keyLocatorName = signature.getKeyLocator().getName();
 
   shared_ptr<const Certificate> trustedCert;
+  shared_ptr<const PublicKeyVerifier> cachedVerifier;
 
   refreshAnchors();
 
   AnchorList::const_iterator it = m_anchors.find(keyLocatorName);
   if (m_anchors.end() == it && static_cast<bool>(m_certificateCache))
-    trustedCert = m_certificateCache->getCertificate(keyLocatorName);
+    cachedVerifier = m_certificateCache->getVerifier(keyLocatorName);
   else
     trustedCert = it->second;
 
-  if (static_cast<bool>(trustedCert))
+  if (static_cast<bool>(cachedVerifier) || static_cast<bool>(trustedCert))
     {
-      if (verifySignature(packet, signature, trustedCert->getPublicKeyInfo()))
+      bool isVerified = static_cast<bool>(cachedVerifier) ?
+                        verifySignature(packet, signature, *cachedVerifier) :
+                        verifySignature(packet, signature, trustedCert->getPublicKeyInfo());
+      if (isVerified)
         return onValidated(packet.shared_from_this());
       else
         return onValidationFailed(packet.shared_from_this(),
@@ -25,7 +25,7 @@
 
 #include "validator-regex.hpp"
 #include "signature-sha256-with-rsa.hpp"
-#include "certificate-cache-ttl.hpp"
+#include "certificate-cache-lru.hpp"
 
 namespace ndn {
 
@@ -39,7 +39,7 @@ ValidatorRegex::ValidatorRegex(Face* face,
   , m_certificateCache(certificateCache)
 {
   if (!static_cast<bool>(m_certificateCache) && face != nullptr)
-    m_certificateCache = make_shared<CertificateCacheTtl>(ref(face->getIoService()));
+    m_certificateCache = make_shared<CertificateCacheLru>();
 }
 
 ValidatorRegex::ValidatorRegex(Face& face,
@@ -50,7 +50,7 @@ ValidatorRegex::ValidatorRegex(Face& face,
   , m_certificateCache(certificateCache)
 {
   if (!static_cast<bool>(m_certificateCache))
-    m_certificateCache = make_shared<CertificateCacheTtl>(ref(face.getIoService()));
+    m_certificateCache = make_shared<CertificateCacheLru>();
 }
 
 void
@@ -146,15 +146,19 @@ ValidatorRegex::checkPolicy(const Data& data,
 
               const Name& keyLocatorName = keyLocator.getName();
               shared_ptr<const Certificate> trustedCert;
+              shared_ptr<const PublicKeyVerifier> cachedVerifier;
               if (m_trustAnchors.end() == m_trustAnchors.find(keyLocatorName) &&
                   static_cast<bool>(m_certificateCache))
-                trustedCert = m_certificateCache->getCertificate(keyLocatorName);
+                cachedVerifier = m_certificateCache->getVerifier(keyLocatorName);
               else
                 trustedCert = m_trustAnchors[keyLocatorName];
 
-              if (static_cast<bool>(trustedCert))
+              if (static_cast<bool>(cachedVerifier) || static_cast<bool>(trustedCert))
                 {
-                  if (verifySignature(data, data.getSignature(), trustedCert->getPublicKeyInfo()))
+                  bool isVerified = static_cast<bool>(cachedVerifier) ?
+                    verifySignature(data, data.getSignature(), *cachedVerifier) :
+                    verifySignature(data, data.getSignature(), trustedCert->getPublicKeyInfo());
+                  if (isVerified)
                     return onValidated(data.shared_from_this());
                   else
                     return onValidationFailed(data.shared_from_this(),
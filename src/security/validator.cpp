@@ -31,9 +31,6 @@
 
 namespace ndn {
 
-static OID SECP256R1("1.2.840.10045.3.1.7");
-static OID SECP384R1("1.3.132.0.34");
-
 Validator::Validator(Face* face)
   : m_face(face)
 {
@@ -148,94 +145,7 @@ Validator::verifySignature(const uint8_t* buf,
                            const Signature& sig,
                            const PublicKey& key)
 {
-  try
-    {
-      using namespace CryptoPP;
-
-      switch (sig.getType())
-        {
-        case tlv::SignatureSha256WithRsa:
-          {
-            if (key.getKeyType() != KEY_TYPE_RSA)
-              return false;
-
-            RSA::PublicKey publicKey;
-            ByteQueue queue;
-
-            queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
-            publicKey.Load(queue);
-
-            RSASS<PKCS1v15, SHA256>::Verifier verifier(publicKey);
-            return verifier.VerifyMessage(buf, size,
-                                          sig.getValue().value(), sig.getValue().value_size());
-          }
-        case tlv::SignatureSha256WithEcdsa:
-          {
-            if (key.getKeyType() != KEY_TYPE_ECDSA)
-              return false;
-
-            ECDSA<ECP, SHA256>::PublicKey publicKey;
-            ByteQueue queue;
-
-            queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
-            publicKey.Load(queue);
-
-            ECDSA<ECP, SHA256>::Verifier verifier(publicKey);
-
-            uint32_t length = 0;
-            StringSource src(key.get().buf(), key.get().size(), true);
-            BERSequenceDecoder subjectPublicKeyInfo(src);
-            {
-              BERSequenceDecoder algorithmInfo(subjectPublicKeyInfo);
-              {
-                OID algorithm;
-                algorithm.decode(algorithmInfo);
-
-                OID curveId;
-                curveId.decode(algorithmInfo);
-
-                if (curveId == SECP256R1)
-                  length = 256;
-                else if (curveId == SECP384R1)
-                  length = 384;
-                else
-                  return false;
-              }
-            }
-
-            switch (length)
-              {
-              case 256:
-                {
-                  uint8_t buffer[64];
-                  size_t usedSize = DSAConvertSignatureFormat(buffer, 64, DSA_P1363,
-                                                              sig.getValue().value(),
-                                                              sig.getValue().value_size(),
-                                                              DSA_DER);
-                  return verifier.VerifyMessage(buf, size, buffer, usedSize);
-                }
-              case 384:
-                {
-                  uint8_t buffer[96];
-                  size_t usedSize = DSAConvertSignatureFormat(buffer, 96, DSA_P1363,
-                                                              sig.getValue().value(),
-                                                              sig.getValue().value_size(),
-                                                              DSA_DER);
-                  return verifier.VerifyMessage(buf, size, buffer, usedSize);
-                }
-              default:
-                return false;
-              }
-          }
-        default:
-          // Unsupported sig type
-          return false;
-        }
-    }
-  catch (CryptoPP::Exception& e)
-    {
-      return false;
-    }
+  return PublicKeyVerifier(key).verify(buf, size, sig);
 }
 
 bool
@@ -30,6 +30,7 @@
 #include "../data.hpp"
 #include "../face.hpp"
 #include "public-key.hpp"
+#include "public-key-verifier.hpp"
 #include "signature-sha256-with-rsa.hpp"
 #include "signature-sha256-with-ecdsa.hpp"
 #include "digest-sha256.hpp"
@@ -159,6 +160,41 @@ public:
                   const Signature& sig,
                   const PublicKey& publicKey);
 
+  /**
+   * @brief Verify the data using a verifier prepared for the signer's public key.
+   *
+   * Unlike the PublicKey overloads, the key is not decoded again for every signature.
+   */
+  static bool
+  verifySignature(const Data& data,
+                  const Signature& sig,
+                  const PublicKeyVerifier& verifier)
+  {
+    return verifier.verify(data.wireEncode().value(),
+                           data.wireEncode().value_size() - data.getSignature().getValue().size(),
+                           sig);
+  }
+
+  /**
+   * @brief Verify the interest using a verifier prepared for the signer's public key.
+   *
+   * (Note the signature covers the first n-2 name components).
+   */
+  static bool
+  verifySignature(const Interest& interest,
+                  const Signature& sig,
+                  const PublicKeyVerifier& verifier)
+  {
+    if (interest.getName().size() < 2)
+      return false;
+
+    const Name& name = interest.getName();
+
+    return verifier.verify(name.wireEncode().value(),
+                           name.wireEncode().value_size() - name[-1].size(),
+                           sig);
+  }
+
 
   /// @brief Verify the data against the SHA256 signature.
   static bool
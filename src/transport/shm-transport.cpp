@@ -0,0 +1,865 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "common.hpp"
+
+#include "shm-transport.hpp"
+
+#if defined(NDN_CXX_HAVE_SHM_TRANSPORT)
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif // defined(NDN_CXX_HAVE_SHM_TRANSPORT)
+
+namespace ndn {
+
+const size_t ShmTransport::DEFAULT_RING_CAPACITY = 1 << 20;
+
+#if defined(NDN_CXX_HAVE_SHM_TRANSPORT)
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "ShmTransport requires lock-free atomics to share them between processes");
+
+namespace {
+
+/// "NDNSHMV1" in little-endian byte order
+const uint64_t SEGMENT_MAGIC = 0x31564d48534e444eULL;
+
+/// length value marking that the rest of the ring is unused and the next record is at offset 0
+const uint32_t WRAP_MARKER = 0xFFFFFFFF;
+
+/// each record starts with a 32-bit length, padded so that records stay 8-byte aligned
+const size_t RECORD_HEADER_SIZE = 8;
+
+const size_t MIN_RING_CAPACITY = 4096;
+const size_t MAX_RING_CAPACITY = size_t(1) << 30;
+
+/// maximum number of blocks delivered before yielding to other handlers in the io_service
+const size_t MAX_RECEIVE_BATCH = 64;
+
+/**
+ * @brief Control words of one ring, as laid out in the shared segment
+ *
+ * Positions are free-running byte counters; the producer and the consumer each write their
+ * own cache line, so that they do not invalidate each other's cache on every operation.
+ */
+struct RingControl
+{
+  alignas(64) std::atomic<uint64_t> tail; ///< bytes ever produced, written by the producer
+  alignas(64) std::atomic<uint64_t> head; ///< bytes ever consumed, written by the consumer
+  alignas(64) std::atomic<uint32_t> isConsumerWaiting;
+  alignas(64) std::atomic<uint32_t> isProducerWaiting;
+};
+
+struct SegmentHeader
+{
+  uint64_t magic;
+  uint64_t ringCapacity;
+  alignas(64) RingControl rings[2];
+};
+
+inline size_t
+getSegmentSize(size_t ringCapacity)
+{
+  return sizeof(SegmentHeader) + 2 * ringCapacity;
+}
+
+inline size_t
+getRecordSize(size_t length)
+{
+  return (RECORD_HEADER_SIZE + length + 7) & ~size_t(7);
+}
+
+std::string
+getErrorString(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+/**
+ * @brief Mapping of a shared segment, unmapped when the last endpoint using it goes away
+ */
+class Segment : noncopyable
+{
+public:
+  Segment(void* address, size_t size)
+    : m_address(address)
+    , m_size(size)
+  {
+  }
+
+  ~Segment()
+  {
+    ::munmap(m_address, m_size);
+  }
+
+  SegmentHeader&
+  getHeader() const
+  {
+    return *reinterpret_cast<SegmentHeader*>(m_address);
+  }
+
+  uint8_t*
+  getRingData(size_t index) const
+  {
+    return reinterpret_cast<uint8_t*>(m_address) + sizeof(SegmentHeader) +
+           index * getHeader().ringCapacity;
+  }
+
+private:
+  void* m_address;
+  size_t m_size;
+};
+
+/**
+ * @brief Single-producer/single-consumer byte ring holding length-prefixed records
+ *
+ * Records never wrap: when a record does not fit at the end of the ring, a wrap marker is
+ * written and the record is placed at offset 0.  Each endpoint only uses the producer
+ * methods of one ring and the consumer methods of the other.
+ */
+class Ring
+{
+public:
+  Ring(RingControl& control, uint8_t* data, size_t capacity)
+    : m_control(control)
+    , m_data(data)
+    , m_capacity(capacity)
+    , m_mask(capacity - 1)
+  {
+  }
+
+  size_t
+  getMaxRecordLength() const
+  {
+    return m_capacity / 2 - RECORD_HEADER_SIZE;
+  }
+
+public: // producer
+  /**
+   * @brief Append one record made of @p size1 bytes at @p buf1 followed by @p size2 bytes
+   *        at @p buf2
+   * @return false if the ring does not have enough free space
+   */
+  bool
+  tryPush(const uint8_t* buf1, size_t size1, const uint8_t* buf2, size_t size2)
+  {
+    size_t length = size1 + size2;
+    size_t recordSize = getRecordSize(length);
+
+    uint64_t tail = m_control.tail.load(std::memory_order_relaxed);
+    if (!hasSpace(tail, recordSize))
+      return false;
+
+    size_t offset = tail & m_mask;
+    size_t contiguous = m_capacity - offset;
+    if (recordSize > contiguous) {
+      std::memcpy(m_data + offset, &WRAP_MARKER, sizeof(WRAP_MARKER));
+      tail += contiguous;
+      offset = 0;
+    }
+
+    uint32_t length32 = static_cast<uint32_t>(length);
+    std::memcpy(m_data + offset, &length32, sizeof(length32));
+    std::memcpy(m_data + offset + RECORD_HEADER_SIZE, buf1, size1);
+    if (size2 > 0)
+      std::memcpy(m_data + offset + RECORD_HEADER_SIZE + size1, buf2, size2);
+
+    m_control.tail.store(tail + recordSize, std::memory_order_seq_cst);
+    return true;
+  }
+
+  /**
+   * @brief Declare that the producer is blocked on a full ring
+   * @return whether a record of @p length bytes fits after all, in which case
+   *         the producer should retry instead of sleeping
+   */
+  bool
+  setProducerWaiting(size_t length)
+  {
+    m_control.isProducerWaiting.store(1, std::memory_order_seq_cst);
+    return hasSpace(m_control.tail.load(std::memory_order_relaxed), getRecordSize(length));
+  }
+
+  /**
+   * @brief Check, after producing, whether the consumer asked to be woken up
+   */
+  bool
+  takeConsumerWaiting()
+  {
+    return m_control.isConsumerWaiting.load(std::memory_order_seq_cst) != 0 &&
+           m_control.isConsumerWaiting.exchange(0, std::memory_order_seq_cst) != 0;
+  }
+
+public: // consumer
+  bool
+  isEmpty() const
+  {
+    return m_control.head.load(std::memory_order_relaxed) ==
+           m_control.tail.load(std::memory_order_seq_cst);
+  }
+
+  /**
+   * @brief Copy the TLV blocks in the oldest record into @p blocks and release its space
+   *
+   * A record holds one or more consecutive TLV blocks, e.g., a LocalControlHeader
+   * followed by the packet it applies to.
+   *
+   * The positions and lengths are written by the peer, which is not trusted: a record is
+   * only parsed if it lies within the ring and within the data published by the producer.
+   *
+   * @return false if the ring is empty
+   * @throw Transport::Error the record is malformed
+   */
+  bool
+  tryPop(std::vector<Block>& blocks)
+  {
+    uint64_t head = m_control.head.load(std::memory_order_relaxed);
+    uint64_t tail = m_control.tail.load(std::memory_order_acquire);
+    if (head == tail)
+      return false;
+    if (tail - head > m_capacity || (head & 7) != 0)
+      throw Transport::Error("malformed positions in shared memory ring");
+
+    size_t offset = head & m_mask;
+    uint32_t length = 0;
+    std::memcpy(&length, m_data + offset, sizeof(length));
+    if (length == WRAP_MARKER) {
+      if (head + (m_capacity - offset) >= tail)
+        throw Transport::Error("malformed record in shared memory ring");
+      head += m_capacity - offset;
+      offset = 0;
+      std::memcpy(&length, m_data, sizeof(length));
+    }
+    if (length > getMaxRecordLength() ||
+        offset + getRecordSize(length) > m_capacity ||
+        head + getRecordSize(length) > tail)
+      throw Transport::Error("malformed record in shared memory ring");
+
+    const uint8_t* record = m_data + offset + RECORD_HEADER_SIZE;
+    for (size_t position = 0; position < length; position += blocks.back().size()) {
+      blocks.push_back(Block());
+      if (!Block::fromBuffer(record + position, length - position, blocks.back()))
+        throw Transport::Error("malformed record in shared memory ring");
+    }
+
+    m_control.head.store(head + getRecordSize(length), std::memory_order_seq_cst);
+    return true;
+  }
+
+  /**
+   * @brief Declare that the consumer is about to sleep
+   * @return whether records arrived in the meantime, in which case the consumer
+   *         should process them instead of sleeping
+   */
+  bool
+  setConsumerWaiting()
+  {
+    m_control.isConsumerWaiting.store(1, std::memory_order_seq_cst);
+    return !isEmpty();
+  }
+
+  /**
+   * @brief Check, after consuming, whether the producer asked to be woken up
+   */
+  bool
+  takeProducerWaiting()
+  {
+    return m_control.isProducerWaiting.load(std::memory_order_seq_cst) != 0 &&
+           m_control.isProducerWaiting.exchange(0, std::memory_order_seq_cst) != 0;
+  }
+
+private:
+  /**
+   * @return whether a record of @p recordSize bytes can be written at position @p tail,
+   *         including the wasted space before the end of the ring if the record must wrap
+   */
+  bool
+  hasSpace(uint64_t tail, size_t recordSize) const
+  {
+    uint64_t head = m_control.head.load(std::memory_order_seq_cst);
+    size_t contiguous = m_capacity - (tail & m_mask);
+    size_t needed = recordSize <= contiguous ? recordSize : contiguous + recordSize;
+    return m_capacity - (tail - head) >= needed;
+  }
+
+private:
+  RingControl& m_control;
+  uint8_t* m_data;
+  size_t m_capacity;
+  size_t m_mask;
+};
+
+int
+duplicateDescriptor(int fd)
+{
+  int newFd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (newFd < 0)
+    throw Transport::Error(getErrorString("cannot duplicate eventfd"));
+  return newFd;
+}
+
+void
+initializeSegment(void* address, size_t ringCapacity)
+{
+  SegmentHeader* header = new (address) SegmentHeader();
+  header->ringCapacity = ringCapacity;
+  header->magic = SEGMENT_MAGIC;
+}
+
+size_t
+adjustRingCapacity(size_t ringCapacity)
+{
+  if (ringCapacity > MAX_RING_CAPACITY)
+    throw Transport::Error("ring capacity exceeds the maximum");
+
+  size_t capacity = MIN_RING_CAPACITY;
+  while (capacity < ringCapacity)
+    capacity <<= 1;
+  return capacity;
+}
+
+} // anonymous namespace
+
+class ShmTransport::Impl : public enable_shared_from_this<ShmTransport::Impl>
+{
+public:
+  /**
+   * @param segmentName name to unlink on close, or empty if there is nothing to unlink
+   * @param localEventFd, peerEventFd descriptors owned by this object from now on
+   */
+  Impl(const shared_ptr<Segment>& segment, bool isCreator, const std::string& segmentName,
+       int localEventFd, int peerEventFd)
+    : m_transport(nullptr)
+    , m_ioService(nullptr)
+    , m_segment(segment)
+    , m_segmentName(segmentName)
+    , m_txRing(segment->getHeader().rings[isCreator ? 0 : 1],
+               segment->getRingData(isCreator ? 0 : 1), segment->getHeader().ringCapacity)
+    , m_rxRing(segment->getHeader().rings[isCreator ? 1 : 0],
+               segment->getRingData(isCreator ? 1 : 0), segment->getHeader().ringCapacity)
+    , m_localEventFd(localEventFd)
+    , m_peerEventFd(peerEventFd)
+    , m_eventCounter(0)
+    , m_isWaitPending(false)
+    , m_isProcessingScheduled(false)
+    , m_nCloses(0)
+  {
+  }
+
+  ~Impl()
+  {
+    if (m_eventDescriptor != nullptr) {
+      boost::system::error_code error;
+      m_eventDescriptor->close(error);
+    }
+    else {
+      ::close(m_localEventFd);
+    }
+    ::close(m_peerEventFd);
+  }
+
+  void
+  connect(boost::asio::io_service& ioService)
+  {
+    m_ioService = &ioService;
+    m_eventDescriptor.reset(new boost::asio::posix::stream_descriptor(ioService,
+                                                                      m_localEventFd));
+    m_transport->m_isConnected = true;
+
+    resume();
+    flushSendQueue();
+    waitForPeer();
+  }
+
+  void
+  close()
+  {
+    if (m_eventDescriptor != nullptr) {
+      // keep the eventfd, so that the transport can be connected again; this cancels the
+      // pending read, whose handler may only run after the transport is connected again
+      m_localEventFd = m_eventDescriptor->release();
+      m_eventDescriptor.reset();
+    }
+    m_isWaitPending = false;
+    ++m_nCloses;
+
+    if (!m_segmentName.empty()) {
+      ::shm_unlink(m_segmentName.c_str());
+      m_segmentName.clear();
+    }
+
+    m_transport->m_isConnected = false;
+    m_transport->m_isExpectingData = false;
+    m_sendQueue.clear();
+  }
+
+  void
+  pause()
+  {
+    m_transport->m_isExpectingData = false;
+  }
+
+  void
+  resume()
+  {
+    if (!m_transport->m_isExpectingData) {
+      m_transport->m_isExpectingData = true;
+      waitForPeer();
+    }
+  }
+
+  void
+  send(const Block& header, const Block& payload)
+  {
+    size_t length = header.size() + (payload.hasWire() ? payload.size() : 0);
+    if (length > m_txRing.getMaxRecordLength())
+      throw Transport::Error("block is too large for the shared memory ring");
+
+    if (m_transport->m_isConnected && m_sendQueue.empty() && push(header, payload))
+      return;
+
+    m_sendQueue.push_back(std::make_pair(header, payload));
+    waitForPeer();
+  }
+
+private:
+  bool
+  push(const Block& header, const Block& payload)
+  {
+    bool isPushed = payload.hasWire() ?
+                    m_txRing.tryPush(header.wire(), header.size(), payload.wire(), payload.size()) :
+                    m_txRing.tryPush(header.wire(), header.size(), nullptr, 0);
+    if (isPushed && m_txRing.takeConsumerWaiting())
+      notifyPeer();
+    return isPushed;
+  }
+
+  void
+  flushSendQueue()
+  {
+    while (!m_sendQueue.empty() && push(m_sendQueue.front().first, m_sendQueue.front().second))
+      m_sendQueue.pop_front();
+  }
+
+  /**
+   * @return whether more blocks may be ready
+   */
+  bool
+  receiveBatch()
+  {
+    size_t nRecords = 0;
+    std::vector<Block> blocks;
+    while (m_transport->m_isExpectingData && nRecords < MAX_RECEIVE_BATCH &&
+           m_rxRing.tryPop(blocks)) {
+      ++nRecords;
+      if (m_rxRing.takeProducerWaiting())
+        notifyPeer();
+
+      for (const Block& block : blocks) {
+        m_transport->receive(block);
+        if (!m_transport->m_isConnected)
+          return false;
+      }
+      blocks.clear();
+    }
+    return nRecords == MAX_RECEIVE_BATCH;
+  }
+
+  void
+  notifyPeer()
+  {
+    uint64_t one = 1;
+    // EAGAIN means the counter is already non-zero, so the peer will wake up anyway
+    ssize_t nWritten = ::write(m_peerEventFd, &one, sizeof(one));
+    (void)nWritten;
+  }
+
+  /**
+   * @brief Announce the events this endpoint waits for, then sleep on the eventfd
+   *
+   * The flags are re-checked after being set, so that a record pushed (or space freed)
+   * by the peer just before the announcement is not missed.
+   */
+  void
+  waitForPeer()
+  {
+    if (!m_transport->m_isConnected)
+      return;
+
+    bool isReady = false;
+    if (m_transport->m_isExpectingData && m_rxRing.setConsumerWaiting())
+      isReady = true;
+    if (!m_sendQueue.empty()) {
+      const std::pair<Block, Block>& front = m_sendQueue.front();
+      size_t length = front.first.size() + (front.second.hasWire() ? front.second.size() : 0);
+      if (m_txRing.setProducerWaiting(length))
+        isReady = true;
+    }
+
+    if (isReady) {
+      scheduleProcessing();
+      return;
+    }
+
+    if (!m_isWaitPending) {
+      m_isWaitPending = true;
+      m_eventDescriptor->async_read_some(boost::asio::buffer(&m_eventCounter,
+                                                             sizeof(m_eventCounter)),
+                                         bind(&Impl::handleWakeup, shared_from_this(),
+                                              m_nCloses, _1));
+    }
+  }
+
+  void
+  scheduleProcessing()
+  {
+    if (!m_isProcessingScheduled) {
+      m_isProcessingScheduled = true;
+      m_ioService->post(bind(&Impl::processEvents, shared_from_this()));
+    }
+  }
+
+  /**
+   * @param nCloses value of m_nCloses when the read was started
+   */
+  void
+  handleWakeup(size_t nCloses, const boost::system::error_code& error)
+  {
+    if (nCloses != m_nCloses) // read on a descriptor of an earlier connection
+      return;
+
+    m_isWaitPending = false;
+    if (m_eventDescriptor == nullptr) // closed
+      return;
+
+    if (error) {
+      if (error == boost::asio::error::operation_aborted)
+        return;
+
+      m_transport->close();
+      throw Transport::Error(error, "error while waiting on the shared memory eventfd");
+    }
+
+    processEvents();
+  }
+
+  void
+  processEvents()
+  {
+    m_isProcessingScheduled = false;
+    if (m_eventDescriptor == nullptr) // closed
+      return;
+
+    flushSendQueue();
+    if (receiveBatch()) {
+      scheduleProcessing();
+      return;
+    }
+    waitForPeer();
+  }
+
+public:
+  ShmTransport* m_transport;
+
+private:
+  boost::asio::io_service* m_ioService;
+  shared_ptr<Segment> m_segment;
+  std::string m_segmentName;
+  Ring m_txRing;
+  Ring m_rxRing;
+
+  int m_localEventFd;
+  int m_peerEventFd;
+  unique_ptr<boost::asio::posix::stream_descriptor> m_eventDescriptor;
+  uint64_t m_eventCounter;
+  bool m_isWaitPending;
+  bool m_isProcessingScheduled;
+  /// number of close() calls, which tells completions of reads of earlier connections apart
+  size_t m_nCloses;
+
+  std::deque<std::pair<Block, Block>> m_sendQueue;
+};
+
+shared_ptr<ShmTransport>
+ShmTransport::create(const std::string& segmentName, size_t ringCapacity,
+                     int localEventFd, int peerEventFd)
+{
+  size_t capacity = adjustRingCapacity(ringCapacity);
+  size_t segmentSize = getSegmentSize(capacity);
+
+  int fd = ::shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0)
+    throw Error(getErrorString("cannot create shared memory segment " + segmentName));
+
+  void* address = MAP_FAILED;
+  if (::ftruncate(fd, segmentSize) == 0)
+    address = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    std::string message = getErrorString("cannot map shared memory segment " + segmentName);
+    ::close(fd);
+    ::shm_unlink(segmentName.c_str());
+    throw Error(message);
+  }
+  ::close(fd);
+
+  initializeSegment(address, capacity);
+  shared_ptr<Segment> segment = make_shared<Segment>(address, segmentSize);
+
+  int localFd = duplicateDescriptor(localEventFd);
+  int peerFd = -1;
+  try {
+    peerFd = duplicateDescriptor(peerEventFd);
+  }
+  catch (const Error&) {
+    ::close(localFd);
+    ::shm_unlink(segmentName.c_str());
+    throw;
+  }
+
+  return shared_ptr<ShmTransport>(new ShmTransport(make_shared<Impl>(segment, true, segmentName,
+                                                                     localFd, peerFd)));
+}
+
+shared_ptr<ShmTransport>
+ShmTransport::open(const std::string& segmentName, int localEventFd, int peerEventFd)
+{
+  int fd = ::shm_open(segmentName.c_str(), O_RDWR, 0);
+  if (fd < 0)
+    throw Error(getErrorString("cannot open shared memory segment " + segmentName));
+
+  struct stat status;
+  if (::fstat(fd, &status) != 0) {
+    std::string message = getErrorString("cannot stat shared memory segment " + segmentName);
+    ::close(fd);
+    throw Error(message);
+  }
+
+  size_t segmentSize = static_cast<size_t>(status.st_size);
+  if (segmentSize < sizeof(SegmentHeader)) {
+    ::close(fd);
+    throw Error("shared memory segment " + segmentName + " is too small");
+  }
+
+  void* address = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (address == MAP_FAILED)
+    throw Error(getErrorString("cannot map shared memory segment " + segmentName));
+
+  shared_ptr<Segment> segment = make_shared<Segment>(address, segmentSize);
+  const SegmentHeader& header = segment->getHeader();
+  if (header.magic != SEGMENT_MAGIC ||
+      header.ringCapacity < MIN_RING_CAPACITY || header.ringCapacity > MAX_RING_CAPACITY ||
+      (header.ringCapacity & (header.ringCapacity - 1)) != 0 ||
+      getSegmentSize(header.ringCapacity) != segmentSize)
+    throw Error("shared memory segment " + segmentName + " is not a valid ShmTransport segment");
+
+  int localFd = duplicateDescriptor(localEventFd);
+  int peerFd = -1;
+  try {
+    peerFd = duplicateDescriptor(peerEventFd);
+  }
+  catch (const Error&) {
+    ::close(localFd);
+    throw;
+  }
+
+  return shared_ptr<ShmTransport>(new ShmTransport(make_shared<Impl>(segment, false, "",
+                                                                     localFd, peerFd)));
+}
+
+std::pair<shared_ptr<ShmTransport>, shared_ptr<ShmTransport>>
+ShmTransport::createLoopback(size_t ringCapacity)
+{
+  size_t capacity = adjustRingCapacity(ringCapacity);
+  size_t segmentSize = getSegmentSize(capacity);
+
+  void* address = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (address == MAP_FAILED)
+    throw Error(getErrorString("cannot map anonymous shared memory segment"));
+
+  initializeSegment(address, capacity);
+  shared_ptr<Segment> segment = make_shared<Segment>(address, segmentSize);
+
+  int firstEventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (firstEventFd < 0)
+    throw Error(getErrorString("cannot create eventfd"));
+  int secondEventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (secondEventFd < 0) {
+    std::string message = getErrorString("cannot create eventfd");
+    ::close(firstEventFd);
+    throw Error(message);
+  }
+
+  int fds[4] = {firstEventFd, -1, secondEventFd, -1};
+  try {
+    fds[1] = duplicateDescriptor(secondEventFd);
+    fds[3] = duplicateDescriptor(firstEventFd);
+  }
+  catch (const Error&) {
+    for (int fd : fds) {
+      if (fd >= 0)
+        ::close(fd);
+    }
+    throw;
+  }
+
+  shared_ptr<ShmTransport> first(new ShmTransport(make_shared<Impl>(segment, true, "",
+                                                                    fds[0], fds[1])));
+  shared_ptr<ShmTransport> second(new ShmTransport(make_shared<Impl>(segment, false, "",
+                                                                     fds[2], fds[3])));
+  return std::make_pair(first, second);
+}
+
+ShmTransport::ShmTransport(const shared_ptr<Impl>& impl)
+  : m_impl(impl)
+{
+  m_impl->m_transport = this;
+}
+
+ShmTransport::~ShmTransport()
+{
+  // handlers scheduled on the io_service may outlive this object, but they do nothing once
+  // the transport is closed
+  m_impl->close();
+}
+
+void
+ShmTransport::connect(boost::asio::io_service& ioService,
+                      const ReceiveCallback& receiveCallback)
+{
+  Transport::connect(ioService, receiveCallback);
+  m_impl->connect(ioService);
+}
+
+void
+ShmTransport::close()
+{
+  m_impl->close();
+}
+
+void
+ShmTransport::pause()
+{
+  m_impl->pause();
+}
+
+void
+ShmTransport::resume()
+{
+  m_impl->resume();
+}
+
+void
+ShmTransport::send(const Block& wire)
+{
+  m_impl->send(wire, Block());
+}
+
+void
+ShmTransport::send(const Block& header, const Block& payload)
+{
+  m_impl->send(header, payload);
+}
+
+#else // shared memory transport is not supported
+
+class ShmTransport::Impl
+{
+};
+
+shared_ptr<ShmTransport>
+ShmTransport::create(const std::string& segmentName, size_t ringCapacity,
+                     int localEventFd, int peerEventFd)
+{
+  throw Error("shared memory transport is not supported on this platform");
+}
+
+shared_ptr<ShmTransport>
+ShmTransport::open(const std::string& segmentName, int localEventFd, int peerEventFd)
+{
+  throw Error("shared memory transport is not supported on this platform");
+}
+
+std::pair<shared_ptr<ShmTransport>, shared_ptr<ShmTransport>>
+ShmTransport::createLoopback(size_t ringCapacity)
+{
+  throw Error("shared memory transport is not supported on this platform");
+}
+
+ShmTransport::ShmTransport(const shared_ptr<Impl>& impl)
+  : m_impl(impl)
+{
+}
+
+ShmTransport::~ShmTransport()
+{
+}
+
+void
+ShmTransport::connect(boost::asio::io_service& ioService,
+                      const ReceiveCallback& receiveCallback)
+{
+  throw Error("shared memory transport is not supported on this platform");
+}
+
+void
+ShmTransport::close()
+{
+}
+
+void
+ShmTransport::pause()
+{
+}
+
+void
+ShmTransport::resume()
+{
+}
+
+void
+ShmTransport::send(const Block& wire)
+{
+}
+
+void
+ShmTransport::send(const Block& header, const Block& payload)
+{
+}
+
+#endif // shared memory transport is not supported
+
+} // namespace ndn
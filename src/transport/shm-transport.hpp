@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_TRANSPORT_HPP
+#define NDN_TRANSPORT_SHM_TRANSPORT_HPP
+
+#include "../common.hpp"
+#include "transport.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Transport that exchanges TLV blocks with a local peer through shared memory
+ *
+ * Both endpoints map the same POSIX shared memory segment, which holds one
+ * single-producer/single-consumer byte ring per direction.  Sending a block copies it into
+ * the outgoing ring and receiving copies it out of the incoming ring, without any system call
+ * on the fast path.  Each endpoint owns an eventfd that the peer writes only after the
+ * endpoint has announced (through a flag in the segment) that it is idle, waiting either for
+ * new data or for free space in a full ring.
+ *
+ * The segment is set up by the "creator" endpoint, and mapped by the other endpoint by name.
+ * Exchanging the segment name and the two eventfds (e.g., by passing them over a Unix
+ * socket, or across fork()) is the responsibility of the caller.
+ *
+ * Blocks larger than half of the ring capacity cannot be sent.
+ */
+class ShmTransport : public Transport
+{
+public:
+  class Impl;
+
+  /**
+   * @brief Create the shared memory segment and return the creator endpoint
+   *
+   * @param segmentName name of the POSIX shared memory object, e.g., "/ndn-app-1234"
+   * @param ringCapacity capacity of each ring in bytes; rounded up to a power of two
+   * @param localEventFd eventfd signalled by the peer to wake up this endpoint
+   * @param peerEventFd eventfd this endpoint signals to wake up the peer
+   *
+   * Both eventfds are duplicated, so the caller keeps ownership of the passed descriptors.
+   * The segment name is unlinked when the creator endpoint is closed.
+   *
+   * @throws Transport::Error if the segment cannot be created, or if shared memory transport
+   *         is not supported on this platform
+   */
+  static shared_ptr<ShmTransport>
+  create(const std::string& segmentName, size_t ringCapacity,
+         int localEventFd, int peerEventFd);
+
+  /**
+   * @brief Map an existing segment created by the peer and return the second endpoint
+   *
+   * @throws Transport::Error if the segment cannot be opened or is not a valid segment,
+   *         or if shared memory transport is not supported on this platform
+   */
+  static shared_ptr<ShmTransport>
+  open(const std::string& segmentName, int localEventFd, int peerEventFd);
+
+  /**
+   * @brief Create two endpoints connected to each other through an anonymous segment
+   *
+   * Intended for tests and benchmarks; both transports still need to be connected to
+   * an io_service before they exchange blocks.
+   */
+  static std::pair<shared_ptr<ShmTransport>, shared_ptr<ShmTransport>>
+  createLoopback(size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+  ~ShmTransport();
+
+  // from Transport
+  virtual void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback);
+
+  virtual void
+  close();
+
+  virtual void
+  pause();
+
+  virtual void
+  resume();
+
+  virtual void
+  send(const Block& wire);
+
+  virtual void
+  send(const Block& header, const Block& payload);
+
+public:
+  static const size_t DEFAULT_RING_CAPACITY;
+
+private:
+  explicit
+  ShmTransport(const shared_ptr<Impl>& impl);
+
+private:
+  shared_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SHM_TRANSPORT_HPP
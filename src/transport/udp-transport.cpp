@@ -0,0 +1,658 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "common.hpp"
+
+#include "udp-transport.hpp"
+#include "util/face-uri.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/multicast.hpp>
+#include <boost/asio/ip/udp.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace ndn {
+
+const size_t UdpTransport::MAX_BATCH_SIZE = 32;
+
+namespace {
+
+namespace ip = boost::asio::ip;
+
+#if defined(NDN_CXX_HAVE_SENDMMSG)
+
+typedef ::mmsghdr MessageHeader;
+
+int
+sendMessages(int fd, MessageHeader* messages, size_t nMessages)
+{
+  return ::sendmmsg(fd, messages, nMessages, MSG_DONTWAIT);
+}
+
+int
+receiveMessages(int fd, MessageHeader* messages, size_t nMessages)
+{
+  return ::recvmmsg(fd, messages, nMessages, MSG_DONTWAIT, nullptr);
+}
+
+#else // sendmmsg and recvmmsg are not available
+
+/// same layout as struct mmsghdr
+struct MessageHeader
+{
+  msghdr msg_hdr;
+  unsigned int msg_len;
+};
+
+int
+sendMessages(int fd, MessageHeader* messages, size_t nMessages)
+{
+  for (size_t i = 0; i < nMessages; ++i) {
+    ssize_t nOctets = ::sendmsg(fd, &messages[i].msg_hdr, MSG_DONTWAIT);
+    if (nOctets < 0)
+      return i == 0 ? -1 : static_cast<int>(i);
+    messages[i].msg_len = static_cast<unsigned int>(nOctets);
+  }
+  return static_cast<int>(nMessages);
+}
+
+int
+receiveMessages(int fd, MessageHeader* messages, size_t nMessages)
+{
+  for (size_t i = 0; i < nMessages; ++i) {
+    ssize_t nOctets = ::recvmsg(fd, &messages[i].msg_hdr, MSG_DONTWAIT);
+    if (nOctets < 0)
+      return i == 0 ? -1 : static_cast<int>(i);
+    messages[i].msg_len = static_cast<unsigned int>(nOctets);
+  }
+  return static_cast<int>(nMessages);
+}
+
+#endif // sendmmsg and recvmmsg are not available
+
+std::string
+getErrorString(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+/**
+ * @brief Open a UDP socket bound to an ephemeral port on 127.0.0.1
+ * @param[out] address the address the socket is bound to
+ */
+int
+openLoopbackSocket(sockaddr_in& address)
+{
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0)
+    throw Transport::Error(getErrorString("cannot create UDP socket"));
+
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addressLength = sizeof(address);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+      ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+    std::string message = getErrorString("cannot bind UDP socket to 127.0.0.1");
+    ::close(fd);
+    throw Transport::Error(message);
+  }
+  return fd;
+}
+
+} // anonymous namespace
+
+class UdpTransport::Impl : public enable_shared_from_this<UdpTransport::Impl>
+{
+public:
+  Impl(const std::string& host, const std::string& port, const std::string& localAddress)
+    : m_transport(nullptr)
+    , m_ioService(nullptr)
+    , m_host(host)
+    , m_port(port)
+    , m_localAddress(localAddress)
+    , m_loopbackFd(-1)
+    , m_isReceivePending(false)
+    , m_isSendPending(false)
+    , m_isFlushScheduled(false)
+  {
+  }
+
+  /**
+   * @param loopbackFd socket already connected to its peer, owned by this object from now on
+   */
+  explicit
+  Impl(int loopbackFd)
+    : m_transport(nullptr)
+    , m_ioService(nullptr)
+    , m_loopbackFd(loopbackFd)
+    , m_isReceivePending(false)
+    , m_isSendPending(false)
+    , m_isFlushScheduled(false)
+  {
+  }
+
+  ~Impl()
+  {
+    if (m_loopbackFd >= 0)
+      ::close(m_loopbackFd);
+  }
+
+  void
+  connect(boost::asio::io_service& ioService)
+  {
+    if (m_socket != nullptr)
+      close();
+
+    m_ioService = &ioService;
+    try {
+      openSockets(ioService);
+    }
+    catch (const boost::system::system_error& error) {
+      closeSockets();
+      throw Transport::Error(error.code(), "cannot open UDP socket to " + m_host + ":" + m_port);
+    }
+    catch (const Transport::Error&) {
+      closeSockets();
+      throw;
+    }
+
+    if (m_receiveBuffer.empty()) {
+      m_receiveBuffer.resize(MAX_BATCH_SIZE * MAX_NDN_PACKET_SIZE);
+      m_rxMessages.resize(MAX_BATCH_SIZE);
+      m_rxIovecs.resize(MAX_BATCH_SIZE);
+      m_sourceAddresses.resize(MAX_BATCH_SIZE);
+      m_txMessages.resize(MAX_BATCH_SIZE);
+      m_txIovecs.resize(2 * MAX_BATCH_SIZE);
+    }
+
+    m_transport->m_isConnected = true;
+    resume();
+    scheduleFlush();
+  }
+
+  void
+  close()
+  {
+    closeSockets();
+    m_transport->m_isConnected = false;
+    m_transport->m_isExpectingData = false;
+    m_sendQueue.clear();
+  }
+
+  void
+  pause()
+  {
+    m_transport->m_isExpectingData = false;
+  }
+
+  void
+  resume()
+  {
+    if (!m_transport->m_isExpectingData) {
+      m_transport->m_isExpectingData = true;
+      waitForData();
+    }
+  }
+
+  void
+  send(const Block& header, const Block& payload)
+  {
+    size_t length = header.size() + (payload.hasWire() ? payload.size() : 0);
+    if (length > MAX_NDN_PACKET_SIZE)
+      throw Transport::Error("block is too large for a UDP datagram");
+
+    m_sendQueue.push_back(std::make_pair(header, payload));
+    scheduleFlush();
+  }
+
+private:
+  void
+  openSockets(boost::asio::io_service& ioService)
+  {
+    if (m_loopbackFd >= 0) {
+      int fd = ::dup(m_loopbackFd);
+      if (fd < 0)
+        throw Transport::Error(getErrorString("cannot duplicate UDP socket"));
+      m_socket.reset(new ip::udp::socket(ioService));
+      m_socket->assign(ip::udp::v4(), fd);
+      return;
+    }
+
+    ip::udp::resolver resolver(ioService);
+    ip::udp::endpoint remote = *resolver.resolve(ip::udp::resolver::query(m_host, m_port));
+
+    ip::address localAddress;
+    if (!m_localAddress.empty()) {
+      localAddress = ip::address::from_string(m_localAddress);
+      if (localAddress.is_v4() != remote.address().is_v4())
+        throw Transport::Error("local address " + m_localAddress +
+                               " is not of the same family as " + m_host);
+    }
+
+    m_socket.reset(new ip::udp::socket(ioService, remote.protocol()));
+    if (!remote.address().is_multicast()) {
+      if (!m_localAddress.empty())
+        m_socket->bind(ip::udp::endpoint(localAddress, 0));
+      m_socket->connect(remote);
+      return;
+    }
+
+    // receive on the group port, together with the other members on this host
+    m_socket->set_option(ip::udp::socket::reuse_address(true));
+    m_socket->bind(remote);
+    if (remote.address().is_v4() && !m_localAddress.empty())
+      m_socket->set_option(ip::multicast::join_group(remote.address().to_v4(),
+                                                     localAddress.to_v4()));
+    else
+      m_socket->set_option(ip::multicast::join_group(remote.address()));
+
+    // send from an ephemeral port, which identifies the looped-back datagrams of this endpoint
+    m_multicastSocket.reset(new ip::udp::socket(ioService, remote.protocol()));
+    m_multicastSocket->set_option(ip::multicast::enable_loopback(true));
+    if (!m_localAddress.empty()) {
+      if (localAddress.is_v4())
+        m_multicastSocket->set_option(ip::multicast::outbound_interface(localAddress.to_v4()));
+      m_multicastSocket->bind(ip::udp::endpoint(localAddress, 0));
+    }
+    m_multicastSocket->connect(remote);
+    m_ownEndpoint = m_multicastSocket->local_endpoint();
+  }
+
+  void
+  closeSockets()
+  {
+    // pending operations complete with operation_aborted, and their handlers do nothing
+    boost::system::error_code error;
+    if (m_socket != nullptr) {
+      m_socket->close(error);
+      m_socket.reset();
+    }
+    if (m_multicastSocket != nullptr) {
+      m_multicastSocket->close(error);
+      m_multicastSocket.reset();
+    }
+    m_isReceivePending = false;
+    m_isSendPending = false;
+  }
+
+  ip::udp::socket&
+  getSendSocket()
+  {
+    return m_multicastSocket != nullptr ? *m_multicastSocket : *m_socket;
+  }
+
+  void
+  waitForData()
+  {
+    if (m_socket == nullptr || m_isReceivePending || !m_transport->m_isExpectingData)
+      return;
+
+    m_isReceivePending = true;
+    m_socket->async_receive(boost::asio::null_buffers(),
+                            bind(&Impl::handleReadable, shared_from_this(), _1));
+  }
+
+  void
+  handleReadable(const boost::system::error_code& error)
+  {
+    if (error == boost::asio::error::operation_aborted)
+      return;
+
+    m_isReceivePending = false;
+    if (m_socket == nullptr || !m_transport->m_isExpectingData)
+      return;
+
+    // an ICMP port unreachable from an earlier datagram does not make the socket unusable
+    if (error && error != boost::asio::error::connection_refused) {
+      m_transport->close();
+      throw Transport::Error(error, "error while waiting on the UDP socket");
+    }
+
+    receiveBatch();
+    waitForData();
+  }
+
+  void
+  receiveBatch()
+  {
+    bool isMulticast = m_multicastSocket != nullptr;
+    for (size_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+      m_rxIovecs[i].iov_base = &m_receiveBuffer[i * MAX_NDN_PACKET_SIZE];
+      m_rxIovecs[i].iov_len = MAX_NDN_PACKET_SIZE;
+
+      msghdr& header = m_rxMessages[i].msg_hdr;
+      std::memset(&header, 0, sizeof(header));
+      header.msg_iov = &m_rxIovecs[i];
+      header.msg_iovlen = 1;
+      if (isMulticast) {
+        header.msg_name = &m_sourceAddresses[i];
+        header.msg_namelen = sizeof(m_sourceAddresses[i]);
+      }
+    }
+
+    int nMessages = receiveMessages(m_socket->native_handle(), &m_rxMessages[0], MAX_BATCH_SIZE);
+    if (nMessages < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ECONNREFUSED)
+        return;
+
+      std::string message = getErrorString("error while receiving from the UDP socket");
+      m_transport->close();
+      throw Transport::Error(message);
+    }
+
+    // datagrams already read are delivered even if the transport is paused meanwhile
+    for (int i = 0; i < nMessages; ++i) {
+      const MessageHeader& message = m_rxMessages[i];
+      if ((message.msg_hdr.msg_flags & MSG_TRUNC) != 0 ||
+          (isMulticast && isOwnDatagram(message.msg_hdr)))
+        continue;
+
+      Block block;
+      if (!Block::fromBuffer(&m_receiveBuffer[i * MAX_NDN_PACKET_SIZE], message.msg_len, block) ||
+          block.size() != message.msg_len)
+        continue;
+
+      m_transport->receive(block);
+      if (!m_transport->m_isConnected)
+        return;
+    }
+  }
+
+  bool
+  isOwnDatagram(const msghdr& header) const
+  {
+    ip::udp::endpoint source;
+    if (header.msg_namelen > source.capacity())
+      return false;
+
+    std::memcpy(source.data(), header.msg_name, header.msg_namelen);
+    source.resize(header.msg_namelen);
+    return source == m_ownEndpoint;
+  }
+
+  /**
+   * @brief Write the queued blocks from an io_service handler
+   *
+   * Deferring the write lets the blocks sent in a row by the application share
+   * a sendmmsg() call.
+   */
+  void
+  scheduleFlush()
+  {
+    if (!m_transport->m_isConnected || m_isFlushScheduled || m_isSendPending ||
+        m_sendQueue.empty())
+      return;
+
+    m_isFlushScheduled = true;
+    m_ioService->post(bind(&Impl::flush, shared_from_this()));
+  }
+
+  void
+  flush()
+  {
+    m_isFlushScheduled = false;
+    if (m_socket == nullptr || m_isSendPending || m_sendQueue.empty())
+      return;
+
+    size_t nMessages = std::min(m_sendQueue.size(), MAX_BATCH_SIZE);
+    for (size_t i = 0; i < nMessages; ++i) {
+      const std::pair<Block, Block>& entry = m_sendQueue[i];
+      iovec* iovecs = &m_txIovecs[2 * i];
+      iovecs[0].iov_base = const_cast<uint8_t*>(entry.first.wire());
+      iovecs[0].iov_len = entry.first.size();
+      size_t nIovecs = 1;
+      if (entry.second.hasWire()) {
+        iovecs[1].iov_base = const_cast<uint8_t*>(entry.second.wire());
+        iovecs[1].iov_len = entry.second.size();
+        nIovecs = 2;
+      }
+
+      msghdr& header = m_txMessages[i].msg_hdr;
+      std::memset(&header, 0, sizeof(header));
+      header.msg_iov = iovecs;
+      header.msg_iovlen = nIovecs;
+    }
+
+    int nSent = sendMessages(getSendSocket().native_handle(), &m_txMessages[0], nMessages);
+    if (nSent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+        waitForSpace();
+        return;
+      }
+
+      // the error reported by the socket was caused by an earlier datagram, so just try again
+      if (errno != EINTR && errno != ECONNREFUSED) {
+        std::string message = getErrorString("error while sending to the UDP socket");
+        m_transport->close();
+        throw Transport::Error(message);
+      }
+      nSent = 0;
+    }
+
+    m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nSent);
+    // yield to other handlers, in particular to the receiving side, between batches
+    scheduleFlush();
+  }
+
+  void
+  waitForSpace()
+  {
+    m_isSendPending = true;
+    getSendSocket().async_send(boost::asio::null_buffers(),
+                               bind(&Impl::handleWritable, shared_from_this(), _1));
+  }
+
+  void
+  handleWritable(const boost::system::error_code& error)
+  {
+    if (error == boost::asio::error::operation_aborted)
+      return;
+
+    m_isSendPending = false;
+    if (m_socket == nullptr)
+      return;
+
+    if (error && error != boost::asio::error::connection_refused) {
+      m_transport->close();
+      throw Transport::Error(error, "error while waiting on the UDP socket");
+    }
+
+    flush();
+  }
+
+public:
+  UdpTransport* m_transport;
+
+private:
+  boost::asio::io_service* m_ioService;
+  std::string m_host;
+  std::string m_port;
+  std::string m_localAddress;
+  int m_loopbackFd;
+
+  unique_ptr<ip::udp::socket> m_socket;
+  unique_ptr<ip::udp::socket> m_multicastSocket; ///< sends to the group, if multicast
+  ip::udp::endpoint m_ownEndpoint; ///< local endpoint of m_multicastSocket
+  bool m_isReceivePending;
+  bool m_isSendPending;
+  bool m_isFlushScheduled;
+
+  std::vector<uint8_t> m_receiveBuffer;
+  std::vector<MessageHeader> m_rxMessages;
+  std::vector<iovec> m_rxIovecs;
+  std::vector<sockaddr_storage> m_sourceAddresses;
+  std::vector<MessageHeader> m_txMessages;
+  std::vector<iovec> m_txIovecs;
+
+  std::deque<std::pair<Block, Block>> m_sendQueue;
+};
+
+UdpTransport::UdpTransport(const std::string& host, const std::string& port/* = "6363"*/,
+                           const std::string& localAddress/* = ""*/)
+  : m_impl(make_shared<Impl>(host, port, localAddress))
+{
+  m_impl->m_transport = this;
+}
+
+UdpTransport::UdpTransport(const shared_ptr<Impl>& impl)
+  : m_impl(impl)
+{
+  m_impl->m_transport = this;
+}
+
+UdpTransport::~UdpTransport()
+{
+  // handlers scheduled on the io_service may outlive this object, but they do nothing once
+  // the transport is closed
+  m_impl->close();
+}
+
+shared_ptr<UdpTransport>
+UdpTransport::create(const ConfigFile& config)
+{
+  const auto hostAndPort(getDefaultSocketHostAndPort(config));
+  return make_shared<UdpTransport>(hostAndPort.first,
+                                   hostAndPort.second);
+}
+
+std::pair<shared_ptr<UdpTransport>, shared_ptr<UdpTransport>>
+UdpTransport::createLoopback()
+{
+  sockaddr_in firstAddress;
+  sockaddr_in secondAddress;
+  int firstFd = openLoopbackSocket(firstAddress);
+  int secondFd = -1;
+  try {
+    secondFd = openLoopbackSocket(secondAddress);
+  }
+  catch (const Error&) {
+    ::close(firstFd);
+    throw;
+  }
+
+  if (::connect(firstFd, reinterpret_cast<sockaddr*>(&secondAddress), sizeof(secondAddress)) != 0 ||
+      ::connect(secondFd, reinterpret_cast<sockaddr*>(&firstAddress), sizeof(firstAddress)) != 0) {
+    std::string message = getErrorString("cannot connect loopback UDP sockets");
+    ::close(firstFd);
+    ::close(secondFd);
+    throw Error(message);
+  }
+
+  shared_ptr<UdpTransport> first(new UdpTransport(make_shared<Impl>(firstFd)));
+  shared_ptr<UdpTransport> second(new UdpTransport(make_shared<Impl>(secondFd)));
+  return std::make_pair(first, second);
+}
+
+std::pair<std::string, std::string>
+UdpTransport::getDefaultSocketHostAndPort(const ConfigFile& config)
+{
+  const ConfigFile::Parsed& parsed = config.getParsedConfiguration();
+  std::string host = "localhost";
+  std::string port = "6363";
+
+  try
+    {
+      const util::FaceUri uri(parsed.get<std::string>("transport"));
+
+      const std::string scheme = uri.getScheme();
+      if (scheme != "udp" && scheme != "udp4" && scheme != "udp6")
+        {
+          throw Transport::Error("Cannot create UdpTransport from \"" +
+                                 scheme + "\" URI");
+        }
+
+      if (!uri.getHost().empty())
+        {
+          host = uri.getHost();
+        }
+
+      if (!uri.getPort().empty())
+        {
+          port = uri.getPort();
+        }
+    }
+  catch (const boost::property_tree::ptree_bad_path& error)
+    {
+      // no transport specified, use default host and port
+    }
+  catch (const boost::property_tree::ptree_bad_data& error)
+    {
+      throw ConfigFile::Error(error.what());
+    }
+  catch (const util::FaceUri::Error& error)
+    {
+      throw ConfigFile::Error(error.what());
+    }
+
+  return std::make_pair(host, port);
+}
+
+void
+UdpTransport::connect(boost::asio::io_service& ioService,
+                      const ReceiveCallback& receiveCallback)
+{
+  Transport::connect(ioService, receiveCallback);
+  m_impl->connect(ioService);
+}
+
+void
+UdpTransport::close()
+{
+  m_impl->close();
+}
+
+void
+UdpTransport::pause()
+{
+  m_impl->pause();
+}
+
+void
+UdpTransport::resume()
+{
+  m_impl->resume();
+}
+
+void
+UdpTransport::send(const Block& wire)
+{
+  m_impl->send(wire, Block());
+}
+
+void
+UdpTransport::send(const Block& header, const Block& payload)
+{
+  m_impl->send(header, payload);
+}
+
+} // namespace ndn
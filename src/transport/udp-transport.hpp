@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_TRANSPORT_UDP_TRANSPORT_HPP
+#define NDN_TRANSPORT_UDP_TRANSPORT_HPP
+
+#include "../common.hpp"
+#include "transport.hpp"
+#include "../util/config-file.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Transport that exchanges TLV blocks with a forwarder over UDP
+ *
+ * Every block (or header and payload pair) is sent as one datagram, and every received
+ * datagram must contain exactly one block; datagrams that do not are dropped.  Unlike with
+ * stream transports, a lost datagram does not hold back the ones that follow it.
+ *
+ * Blocks passed to send() are queued and written from an io_service handler, so that all
+ * blocks sent while handling one event leave in as few sendmmsg() calls as possible; on the
+ * receiving side, up to MAX_BATCH_SIZE datagrams are read with each recvmmsg() call.  Where
+ * these system calls are not available, datagrams are sent and received one at a time.
+ *
+ * If the remote host is a multicast group, the transport joins the group, receives on the
+ * group port and sends to the group.  Its own datagrams, looped back by the kernel, are not
+ * delivered to the receive callback.
+ */
+class UdpTransport : public Transport
+{
+public:
+  class Impl;
+
+  /**
+   * @param host remote host name or address, either unicast or multicast
+   * @param port remote port
+   * @param localAddress for a unicast remote host, the local address to bind to; for a
+   *        multicast group, the address of the IPv4 interface on which the group is joined
+   *        and datagrams are sent.  If empty, the choice is left to the operating system.
+   *
+   * The host name is resolved when the transport is connected.
+   */
+  UdpTransport(const std::string& host, const std::string& port = "6363",
+               const std::string& localAddress = "");
+
+  ~UdpTransport();
+
+  /**
+   * @throw Transport::Error the host cannot be resolved, or the socket cannot be set up
+   */
+  virtual void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback);
+
+  virtual void
+  close();
+
+  virtual void
+  pause();
+
+  virtual void
+  resume();
+
+  /**
+   * @throw Transport::Error the block does not fit into one datagram
+   */
+  virtual void
+  send(const Block& wire);
+
+  /**
+   * @throw Transport::Error the header and payload do not fit into one datagram
+   */
+  virtual void
+  send(const Block& header, const Block& payload);
+
+  static shared_ptr<UdpTransport>
+  create(const ConfigFile& config);
+
+  /**
+   * @brief Create two endpoints bound to 127.0.0.1 that send to each other
+   *
+   * Intended for tests and benchmarks; both transports still need to be connected to
+   * an io_service before they exchange blocks.
+   */
+  static std::pair<shared_ptr<UdpTransport>, shared_ptr<UdpTransport>>
+  createLoopback();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+
+  static std::pair<std::string, std::string>
+  getDefaultSocketHostAndPort(const ConfigFile& config);
+
+public:
+  /// maximum number of datagrams passed to one sendmmsg() or recvmmsg() call
+  static const size_t MAX_BATCH_SIZE;
+
+private:
+  explicit
+  UdpTransport(const shared_ptr<Impl>& impl);
+
+private:
+  shared_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_UDP_TRANSPORT_HPP
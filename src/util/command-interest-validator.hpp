@@ -27,6 +27,7 @@
 #include "../security/sec-rule-specific.hpp"
 
 #include <list>
+#include <unordered_map>
 
 namespace ndn {
 
@@ -121,7 +122,7 @@ private:
   std::map<Name, PublicKey> m_trustAnchorsForInterest;
   std::list<SecRuleSpecific> m_trustScopeForInterest;
 
-  typedef std::map<Name, time::system_clock::TimePoint> LastTimestampMap;
+  typedef std::unordered_map<Name, time::system_clock::TimePoint> LastTimestampMap;
   LastTimestampMap m_lastTimestamp;
 };
 
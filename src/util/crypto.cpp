@@ -22,27 +22,13 @@
 #include "../common.hpp"
 
 #include "crypto.hpp"
-#include "../encoding/buffer-stream.hpp"
-#include "../security/cryptopp.hpp"
+#include "sha256-backend.hpp"
 
 namespace ndn {
 
 void ndn_digestSha256(const uint8_t* data, size_t dataLength, uint8_t* digest)
 {
-  try
-    {
-      using namespace CryptoPP;
-
-      CryptoPP::SHA256 hash;
-      OBufferStream os;
-      StringSource(data, dataLength, true,
-                   new HashFilter(hash, new ArraySink(digest, crypto::SHA256_DIGEST_SIZE)));
-    }
-  catch (CryptoPP::Exception& e)
-    {
-      return;
-    }
-
+  crypto::sha256(data, dataLength, digest);
 }
 
 namespace crypto {
@@ -50,19 +36,52 @@ namespace crypto {
 ConstBufferPtr
 sha256(const uint8_t* data, size_t dataLength)
 {
-  try
-    {
-      using namespace CryptoPP;
+  shared_ptr<Buffer> digest = make_shared<Buffer>(SHA256_DIGEST_SIZE);
+  sha256(data, dataLength, digest->buf());
+  return digest;
+}
 
-      SHA256 hash;
-      OBufferStream os;
-      StringSource(data, dataLength, true, new HashFilter(hash, new FileSink(os)));
-      return os.buf();
+void
+sha256(const uint8_t* data, size_t dataLength, uint8_t* digest)
+{
+  if (detail::hasShaNi())
+    detail::sha256ShaNi(data, dataLength, digest);
+  else
+    detail::sha256Generic(data, dataLength, digest);
+}
+
+void
+sha256(size_t nBuffers, const uint8_t* const* data, const size_t* dataLength,
+       uint8_t* const* digests)
+{
+  size_t i = 0;
+  if (detail::hasShaNi()) {
+    for (; i + 2 <= nBuffers; i += 2) {
+      detail::sha256ShaNiX2(data + i, dataLength + i, digests + i);
     }
-  catch (CryptoPP::Exception& e)
-    {
-      return ConstBufferPtr();
+  }
+  else if (detail::hasAvx2()) {
+    // a single buffer is hashed faster by the generic implementation
+    for (; i + 2 <= nBuffers; i += detail::SHA256_AVX2_LANES) {
+      size_t nLanes = std::min(nBuffers - i, detail::SHA256_AVX2_LANES);
+      detail::sha256Avx2(nLanes, data + i, dataLength + i, digests + i);
     }
+  }
+
+  for (; i < nBuffers; ++i) {
+    sha256(data[i], dataLength[i], digests[i]);
+  }
+}
+
+const char*
+getSha256Implementation()
+{
+  if (detail::hasShaNi())
+    return "SHA-NI";
+  else if (detail::hasAvx2())
+    return "AVX2";
+  else
+    return "generic";
 }
 
 } // namespace crypto
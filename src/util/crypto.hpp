@@ -52,6 +52,42 @@ static const size_t SHA256_DIGEST_SIZE = 32;
 ConstBufferPtr
 sha256(const uint8_t* data, size_t dataLength);
 
+/**
+ * @brief Compute the sha-256 digest of data.
+ *
+ * @param data Pointer to the input byte array.
+ * @param dataLength The length of data.
+ * @param digest A pointer to a buffer of size SHA256_DIGEST_SIZE to receive the digest.
+ */
+void
+sha256(const uint8_t* data, size_t dataLength, uint8_t* digest);
+
+/**
+ * @brief Compute the sha-256 digests of several independent buffers.
+ *
+ * This is faster than hashing the buffers one by one, because several buffers are hashed
+ * in parallel when the CPU supports it.  Buffers of similar sizes, such as the segments of
+ * a batch of Data packets, benefit the most.
+ *
+ * @param nBuffers Number of buffers.
+ * @param data Array of pointers to the input byte arrays.
+ * @param dataLength Array of the lengths of the input byte arrays.
+ * @param digests Array of pointers to buffers of size SHA256_DIGEST_SIZE to receive
+ *                the digests.
+ */
+void
+sha256(size_t nBuffers, const uint8_t* const* data, const size_t* dataLength,
+       uint8_t* const* digests);
+
+/**
+ * @brief Get the name of the sha-256 implementation selected for this CPU.
+ *
+ * @return "SHA-NI" if the CPU has the SHA extensions; "AVX2" if the CPU has AVX2, which
+ *         speeds up only the multi-buffer function; otherwise "generic".
+ */
+const char*
+getSha256Implementation();
+
 } // namespace crypto
 
 } // namespace ndn
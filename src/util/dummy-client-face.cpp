@@ -27,7 +27,7 @@
 namespace ndn {
 namespace util {
 
-const DummyClientFace::Options DummyClientFace::DEFAULT_OPTIONS { true, false };
+const DummyClientFace::Options DummyClientFace::DEFAULT_OPTIONS { true, false, 0 };
 
 class DummyClientFace::Transport : public ndn::Transport
 {
@@ -78,7 +78,10 @@ public:
 
 DummyClientFace::DummyClientFace(const Options& options, shared_ptr<Transport> transport)
   : Face(transport)
+  , nSentInterests(0)
+  , nSentDatas(0)
   , m_transport(transport)
+  , m_packetLogLimit(options.packetLogLimit)
 {
   this->construct(options);
 }
@@ -86,7 +89,10 @@ DummyClientFace::DummyClientFace(const Options& options, shared_ptr<Transport> t
 DummyClientFace::DummyClientFace(const Options& options, shared_ptr<Transport> transport,
                                  boost::asio::io_service& ioService)
   : Face(transport, ioService)
+  , nSentInterests(0)
+  , nSentDatas(0)
   , m_transport(transport)
+  , m_packetLogLimit(options.packetLogLimit)
 {
   this->construct(options);
 }
@@ -95,13 +101,20 @@ void
 DummyClientFace::construct(const Options& options)
 {
   m_transport->onSendBlock.connect([this] (const Block& wire) {
+    // packets are decoded only if someone is interested in them
     if (wire.type() == tlv::Interest) {
-      shared_ptr<Interest> interest = make_shared<Interest>(wire);
-      onSendInterest(*interest);
+      ++nSentInterests;
+      if (!onSendInterest.isEmpty()) {
+        shared_ptr<Interest> interest = make_shared<Interest>(wire);
+        onSendInterest(*interest);
+      }
     }
     else if (wire.type() == tlv::Data) {
-      shared_ptr<Data> data = make_shared<Data>(wire);
-      onSendData(*data);
+      ++nSentDatas;
+      if (!onSendData.isEmpty()) {
+        shared_ptr<Data> data = make_shared<Data>(wire);
+        onSendData(*data);
+      }
     }
   });
 
@@ -112,14 +125,26 @@ DummyClientFace::construct(const Options& options)
     this->enableRegistrationReply();
 }
 
+/** \brief append \p packet to \p log, discarding the older half of \p log if it is full
+ */
+template<typename Packet>
+static void
+appendToPacketLog(std::vector<Packet>& log, const Packet& packet, size_t limit)
+{
+  if (limit > 0 && log.size() >= limit) {
+    log.erase(log.begin(), log.begin() + (log.size() - limit / 2));
+  }
+  log.push_back(packet);
+}
+
 void
 DummyClientFace::enablePacketLogging()
 {
   onSendInterest.connect([this] (const Interest& interest) {
-    this->sentInterests.push_back(interest);
+    appendToPacketLog(this->sentInterests, interest, m_packetLogLimit);
   });
   onSendData.connect([this] (const Data& data) {
-    this->sentDatas.push_back(data);
+    appendToPacketLog(this->sentDatas, data, m_packetLogLimit);
   });
 }
 
@@ -152,6 +177,40 @@ DummyClientFace::enableRegistrationReply()
   });
 }
 
+void
+DummyClientFace::linkTo(DummyClientFace& other)
+{
+  this->deliverTo(other);
+  other.deliverTo(*this);
+}
+
+void
+DummyClientFace::deliverTo(DummyClientFace& other)
+{
+  // the receiving face may be destroyed before this face, or before a posted delivery
+  weak_ptr<Transport> otherTransport = other.m_transport;
+  boost::asio::io_service& otherIoService = other.getIoService();
+
+  m_transport->onSendBlock.connect([otherTransport, &otherIoService] (const Block& wire) {
+    if (otherTransport.expired())
+      return;
+
+    if (wire.type() == tlv::Interest) {
+      static const Name localhost("/localhost");
+      Block interest = wire;
+      interest.parse();
+      if (localhost.isPrefixOf(Name(interest.get(tlv::Name))))
+        return;
+    }
+
+    otherIoService.post([otherTransport, wire] {
+      shared_ptr<Transport> transport = otherTransport.lock();
+      if (transport != nullptr)
+        transport->receive(wire);
+    });
+  });
+}
+
 template<typename Packet>
 void
 DummyClientFace::receive(const Packet& packet)
@@ -45,6 +45,13 @@ public:
      *         replied with a successful response
      */
     bool enableRegistrationReply;
+
+    /** \brief maximum number of packets kept in sentInterests and sentDatas; 0 means unlimited
+     *
+     *  When a container reaches this size, its older half is discarded, so that it keeps
+     *  the most recent packets at a bounded cost per sent packet.
+     */
+    size_t packetLogLimit;
   };
 
   /** \brief cause the Face to receive a packet
@@ -54,6 +61,16 @@ public:
   void
   receive(const Packet& packet);
 
+  /** \brief connect this face and \p other, as if both were attached to the same forwarder
+   *
+   *  Every Interest or Data sent by one face is received by the other face, through the
+   *  io_service of the receiving face.  Prefix registration commands and other Interests
+   *  under /localhost are not delivered.  The link remains in effect until either face is
+   *  destroyed.
+   */
+  void
+  linkTo(DummyClientFace& other);
+
 private: // constructors
   class Transport;
 
@@ -80,11 +97,15 @@ private:
   void
   enableRegistrationReply();
 
+  void
+  deliverTo(DummyClientFace& other);
+
 public:
   /** \brief default options
    *
    *  enablePacketLogging=true
    *  enableRegistrationReply=false
+   *  packetLogLimit=0
    */
   static const Options DEFAULT_OPTIONS;
 
@@ -104,6 +125,18 @@ public:
    */
   std::vector<Data> sentDatas;
 
+  /** \brief number of Interests sent out of this DummyClientFace
+   *
+   *  This counter is maintained regardless of options.enablePacketLogging.
+   */
+  uint64_t nSentInterests;
+
+  /** \brief number of Data sent out of this DummyClientFace
+   *
+   *  This counter is maintained regardless of options.enablePacketLogging.
+   */
+  uint64_t nSentDatas;
+
   /** \brief emits whenever an Interest is sent
    *
    *  After .expressInterest, .processEvents must be called before this signal would be emitted.
@@ -118,6 +151,7 @@ public:
 
 private:
   shared_ptr<Transport> m_transport;
+  size_t m_packetLogLimit;
 };
 
 shared_ptr<DummyClientFace>
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-arc.hpp"
+
+namespace ndn {
+namespace util {
+
+const InMemoryStorageArc::RecordIndex InMemoryStorageArc::NONE =
+  std::numeric_limits<RecordIndex>::max();
+
+InMemoryStorageArc::InMemoryStorageArc(size_t limit)
+  : InMemoryStorage(limit)
+  , m_targetT1Size(0)
+  , m_cacheSize(0)
+{
+  for (List& list : m_lists) {
+    list.head = list.tail = NONE;
+    list.size = 0;
+  }
+}
+
+InMemoryStorageArc::InMemoryStorageArc(boost::asio::io_service& ioService, size_t limit)
+  : InMemoryStorage(ioService, limit)
+  , m_targetT1Size(0)
+  , m_cacheSize(0)
+{
+  for (List& list : m_lists) {
+    list.head = list.tail = NONE;
+    list.size = 0;
+  }
+}
+
+InMemoryStorageArc::~InMemoryStorageArc()
+{
+}
+
+InMemoryStorageArc::RecordIndex
+InMemoryStorageArc::allocateRecord()
+{
+  if (!m_freeRecords.empty()) {
+    RecordIndex index = m_freeRecords.back();
+    m_freeRecords.pop_back();
+    return index;
+  }
+
+  m_records.push_back(Record());
+  return m_records.size() - 1;
+}
+
+void
+InMemoryStorageArc::freeRecord(RecordIndex index)
+{
+  m_records[index].entry = nullptr;
+  m_freeRecords.push_back(index);
+}
+
+void
+InMemoryStorageArc::pushHead(ListId listId, RecordIndex index)
+{
+  List& list = m_lists[listId];
+  Record& record = m_records[index];
+  record.list = listId;
+  record.prev = NONE;
+  record.next = list.head;
+  if (list.head != NONE)
+    m_records[list.head].prev = index;
+  else
+    list.tail = index;
+  list.head = index;
+  ++list.size;
+}
+
+void
+InMemoryStorageArc::unlink(RecordIndex index)
+{
+  Record& record = m_records[index];
+  List& list = m_lists[record.list];
+  if (record.prev != NONE)
+    m_records[record.prev].next = record.next;
+  else
+    list.head = record.next;
+  if (record.next != NONE)
+    m_records[record.next].prev = record.prev;
+  else
+    list.tail = record.prev;
+  --list.size;
+}
+
+void
+InMemoryStorageArc::dropGhost(ListId listId)
+{
+  RecordIndex index = m_lists[listId].tail;
+  BOOST_ASSERT(index != NONE);
+  m_ghosts.erase(m_records[index].hash);
+  unlink(index);
+  freeRecord(index);
+}
+
+void
+InMemoryStorageArc::afterInsert(InMemoryStorageEntry* entry)
+{
+  size_t hash = std::hash<Name>()(entry->getFullName());
+  RecordIndex index = NONE;
+  size_t c = m_cacheSize;
+
+  auto ghost = m_ghosts.find(hash);
+  if (ghost != m_ghosts.end()) {
+    index = ghost->second;
+    m_ghosts.erase(ghost);
+
+    // a ghost hit in B1 means T1 was too small, and one in B2 means T2 was too small
+    size_t nB1 = m_lists[B1].size;
+    size_t nB2 = m_lists[B2].size;
+    if (m_records[index].list == B1) {
+      size_t delta = std::max<size_t>(nB2 / nB1, 1);
+      m_targetT1Size = std::min(m_targetT1Size + delta, c);
+    }
+    else {
+      size_t delta = std::max<size_t>(nB1 / nB2, 1);
+      m_targetT1Size = m_targetT1Size > delta ? m_targetT1Size - delta : 0;
+    }
+
+    unlink(index);
+    m_records[index].entry = entry;
+    pushHead(T2, index);
+  }
+  else {
+    index = allocateRecord();
+    m_records[index].entry = entry;
+    m_records[index].hash = hash;
+    pushHead(T1, index);
+  }
+  entry->setPolicyIndex(index);
+
+  // remember at most c packets in T1 and B1, and at most 2 * c packets overall
+  while (m_lists[B1].size > 0 && m_lists[T1].size + m_lists[B1].size > c) {
+    dropGhost(B1);
+  }
+  while (m_lists[B2].size > 0) {
+    size_t nRecords = size() + m_lists[B1].size + m_lists[B2].size;
+    if (nRecords <= c || nRecords - c <= c)
+      break;
+    dropGhost(B2);
+  }
+}
+
+bool
+InMemoryStorageArc::evictItem()
+{
+  size_t nT1 = m_lists[T1].size;
+  if (nT1 + m_lists[T2].size == 0)
+    return false;
+
+  m_cacheSize = size();
+
+  ListId from = (nT1 > 0 && (nT1 > m_targetT1Size || m_lists[T2].size == 0)) ? T1 : T2;
+  RecordIndex index = m_lists[from].tail;
+  Record& record = m_records[index];
+  InMemoryStorageEntry* entry = record.entry;
+
+  unlink(index);
+  auto ghost = m_ghosts.find(record.hash);
+  if (ghost != m_ghosts.end()) {
+    // another packet with the same hash already has a ghost record, drop it
+    unlink(ghost->second);
+    freeRecord(ghost->second);
+    m_ghosts.erase(ghost);
+  }
+  record.entry = nullptr;
+  pushHead(from == T1 ? B1 : B2, index);
+  m_ghosts.insert(std::make_pair(record.hash, index));
+
+  eraseImpl(entry->getFullName());
+  return true;
+}
+
+void
+InMemoryStorageArc::beforeErase(InMemoryStorageEntry* entry)
+{
+  RecordIndex index = entry->getPolicyIndex();
+  unlink(index);
+  freeRecord(index);
+}
+
+void
+InMemoryStorageArc::afterAccess(InMemoryStorageEntry* entry)
+{
+  RecordIndex index = entry->getPolicyIndex();
+  unlink(index);
+  pushHead(T2, index);
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IN_MEMORY_STORAGE_ARC_HPP
+#define NDN_UTIL_IN_MEMORY_STORAGE_ARC_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <unordered_map>
+
+namespace ndn {
+namespace util {
+
+/** @brief Provides in-memory storage employing the Adaptive Replacement Cache (ARC) policy
+ *
+ *  Packets are kept in two LRU lists: T1 holds packets that were accessed once since they
+ *  were inserted, and T2 holds packets that were accessed again.  Evicted packets leave a
+ *  ghost record, with the hash of their full name, in list B1 or B2.  Re-inserting a packet
+ *  that has a ghost in B1 enlarges the target size of T1, and one that has a ghost in B2
+ *  enlarges T2.  A sequential scan passes through T1 only, and does not flush the packets
+ *  in T2.
+ *
+ *  The cache size c of ARC is the number of packets resident when the last packet was
+ *  evicted: the limit, or fewer when the byte limit is reached first.  T1 and B1 together
+ *  hold at most c records, and all lists together at most 2c records.
+ *
+ *  The records of all lists live in one array and are linked by index.  An access moves a
+ *  record to the head of T2 in O(1) time, without allocating memory.
+ *
+ *  @sa N. Megiddo and D. S. Modha, "ARC: A Self-Tuning, Low Overhead Replacement Cache",
+ *      FAST 2003
+ */
+class InMemoryStorageArc : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageArc(size_t limit = 10);
+
+  /** @brief Creates in-memory storage that removes stale Data packets in the background
+   */
+  InMemoryStorageArc(boost::asio::io_service& ioService, size_t limit = 10);
+
+  virtual
+  ~InMemoryStorageArc();
+
+  /** @return{ target number of packets in T1 }
+   */
+  size_t
+  getTargetT1Size() const
+  {
+    return m_targetT1Size;
+  }
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes the least recently used packet of T1 if T1 exceeds its target size,
+   *  and that of T2 otherwise, leaving a ghost record of the packet
+   *  @return{ whether the Data was removed }
+   */
+  virtual bool
+  evictItem();
+
+  /** @brief Moves the entry to the head of T2
+   */
+  virtual void
+  afterAccess(InMemoryStorageEntry* entry);
+
+  /** @brief Adds the entry to the head of T1, or to that of T2 if it has a ghost record,
+   *  and adapts the target size of T1
+   */
+  virtual void
+  afterInsert(InMemoryStorageEntry* entry);
+
+  /** @brief Removes the entry from its list without leaving a ghost record
+   */
+  virtual void
+  beforeErase(InMemoryStorageEntry* entry);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  enum ListId {
+    T1,
+    T2,
+    B1,
+    B2,
+    N_LISTS
+  };
+
+  /** @return{ number of records in a list }
+   */
+  size_t
+  getListSize(ListId list) const
+  {
+    return m_lists[list].size;
+  }
+
+private:
+  typedef uint32_t RecordIndex;
+  static const RecordIndex NONE;
+
+  struct Record
+  {
+    InMemoryStorageEntry* entry; ///< nullptr in a ghost record
+    size_t hash;                 ///< hash of the full name
+    RecordIndex prev;            ///< toward the head (most recently used)
+    RecordIndex next;            ///< toward the tail (least recently used)
+    ListId list;
+  };
+
+  struct List
+  {
+    RecordIndex head;
+    RecordIndex tail;
+    size_t size;
+  };
+
+  RecordIndex
+  allocateRecord();
+
+  void
+  freeRecord(RecordIndex index);
+
+  void
+  pushHead(ListId list, RecordIndex index);
+
+  void
+  unlink(RecordIndex index);
+
+  void
+  dropGhost(ListId list);
+
+private:
+  std::vector<Record> m_records;
+  std::vector<RecordIndex> m_freeRecords;
+  List m_lists[N_LISTS];
+  /// hash of full name => ghost record in B1 or B2
+  std::unordered_map<size_t, RecordIndex> m_ghosts;
+  size_t m_targetT1Size;
+  /// number of packets resident when the last packet was evicted
+  size_t m_cacheSize;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IN_MEMORY_STORAGE_ARC_HPP
@@ -0,0 +1,408 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-disk.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace util {
+
+const std::string InMemoryStorageDisk::LOG_FILENAME("segments.log");
+const std::string InMemoryStorageDisk::INDEX_FILENAME("index");
+
+/** @brief Fixed part of an index record, followed by the TLV of the full name
+ *
+ *  A record with zero length is a tombstone: the packet with this full name was erased.
+ */
+struct IndexRecordHeader
+{
+  uint64_t offset;
+  uint32_t length;
+  uint32_t nameLength;
+  int64_t staleTime; ///< milliseconds since Unix epoch, or NEVER_STALE
+};
+
+static const int64_t NEVER_STALE = std::numeric_limits<int64_t>::max();
+
+static const uint64_t INITIAL_LOG_CAPACITY = 1 << 20;
+
+static std::string
+describeError(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+static int
+openFile(const boost::filesystem::path& path, int flags)
+{
+  int fd = ::open(path.c_str(), flags | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0)
+    throw InMemoryStorageDisk::Error(describeError("Cannot open " + path.string()));
+  return fd;
+}
+
+static uint64_t
+getFileSize(int fd)
+{
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+    throw InMemoryStorageDisk::Error(describeError("Cannot stat storage file"));
+  return static_cast<uint64_t>(st.st_size);
+}
+
+InMemoryStorageDisk::InMemoryStorageDisk(const std::string& directory, size_t ramLimit)
+  : m_ram(ramLimit)
+  , m_logFd(-1)
+  , m_indexFd(-1)
+  , m_log(nullptr)
+  , m_logCapacity(0)
+  , m_logEnd(0)
+  , m_nDiskReads(0)
+{
+  boost::filesystem::path dir(directory);
+  boost::filesystem::create_directories(dir);
+
+  m_logFd = openFile(dir / LOG_FILENAME, O_RDWR);
+  try {
+    m_indexFd = openFile(dir / INDEX_FILENAME, O_RDWR | O_APPEND);
+    loadIndex();
+    mapLog(std::max(getFileSize(m_logFd), INITIAL_LOG_CAPACITY));
+  }
+  catch (const Error&) {
+    if (m_indexFd >= 0)
+      ::close(m_indexFd);
+    ::close(m_logFd);
+    throw;
+  }
+}
+
+InMemoryStorageDisk::~InMemoryStorageDisk()
+{
+  ::munmap(m_log, m_logCapacity);
+  // drop the space reserved for appending
+  if (::ftruncate(m_logFd, m_logEnd) != 0) {
+    // the unused tail is ignored when the storage is opened again
+  }
+  ::close(m_logFd);
+  ::close(m_indexFd);
+}
+
+void
+InMemoryStorageDisk::loadIndex()
+{
+  uint64_t logSize = getFileSize(m_logFd);
+  uint64_t indexSize = getFileSize(m_indexFd);
+  if (indexSize == 0)
+    return;
+
+  void* mapping = ::mmap(nullptr, indexSize, PROT_READ, MAP_PRIVATE, m_indexFd, 0);
+  if (mapping == MAP_FAILED)
+    throw Error(describeError("Cannot map the index file"));
+  const uint8_t* buffer = static_cast<const uint8_t*>(mapping);
+
+  // a crash may leave an incomplete record at the end of the index file, and records for
+  // packets beyond the end of the segment log; records for packets that are within the space
+  // reserved by mapLog() but never reached the disk are only detected by load()
+  uint64_t position = 0;
+  while (position + sizeof(IndexRecordHeader) <= indexSize) {
+    IndexRecordHeader header;
+    std::memcpy(&header, buffer + position, sizeof(header));
+    uint64_t recordEnd = position + sizeof(header) + header.nameLength;
+    if (recordEnd > indexSize || header.offset + header.length > logSize)
+      break;
+
+    Name fullName;
+    try {
+      fullName.wireDecode(Block(buffer + position + sizeof(header), header.nameLength));
+    }
+    catch (const tlv::Error&) {
+      break;
+    }
+
+    if (header.length == 0) {
+      m_index.erase(fullName);
+    }
+    else {
+      Location& location = m_index[fullName];
+      location.offset = header.offset;
+      location.length = header.length;
+      if (header.staleTime == NEVER_STALE)
+        location.staleTime = time::system_clock::TimePoint::max();
+      else
+        location.staleTime = time::fromUnixTimestamp(time::milliseconds(header.staleTime));
+      m_logEnd = std::max(m_logEnd, header.offset + header.length);
+    }
+    position = recordEnd;
+  }
+
+  ::munmap(mapping, indexSize);
+
+  if (position < indexSize && ::ftruncate(m_indexFd, position) != 0)
+    throw Error(describeError("Cannot truncate the index file"));
+}
+
+void
+InMemoryStorageDisk::mapLog(uint64_t capacity)
+{
+  if (m_log != nullptr) {
+    ::munmap(m_log, m_logCapacity);
+    m_log = nullptr;
+    m_logCapacity = 0;
+  }
+
+  if (getFileSize(m_logFd) < capacity && ::ftruncate(m_logFd, capacity) != 0)
+    throw Error(describeError("Cannot extend the segment log"));
+
+  void* mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_logFd, 0);
+  if (mapping == MAP_FAILED)
+    throw Error(describeError("Cannot map the segment log"));
+
+  m_log = static_cast<uint8_t*>(mapping);
+  m_logCapacity = capacity;
+}
+
+void
+InMemoryStorageDisk::appendToLog(const Block& wire, uint64_t& offset)
+{
+  if (m_logEnd + wire.size() > m_logCapacity) {
+    mapLog(std::max(m_logCapacity * 2, m_logEnd + wire.size()));
+  }
+
+  offset = m_logEnd;
+  std::memcpy(m_log + m_logEnd, wire.wire(), wire.size());
+  m_logEnd += wire.size();
+}
+
+void
+InMemoryStorageDisk::appendIndexRecord(const Name& fullName, const Location& location)
+{
+  const Block& nameWire = fullName.wireEncode();
+
+  IndexRecordHeader header;
+  header.offset = location.offset;
+  header.length = location.length;
+  header.nameLength = nameWire.size();
+  if (location.staleTime == time::system_clock::TimePoint::max())
+    header.staleTime = NEVER_STALE;
+  else
+    header.staleTime = time::toUnixTimestamp(location.staleTime).count();
+
+  std::vector<uint8_t> record(sizeof(header) + nameWire.size());
+  std::memcpy(record.data(), &header, sizeof(header));
+  std::memcpy(record.data() + sizeof(header), nameWire.wire(), nameWire.size());
+
+  size_t nWritten = 0;
+  while (nWritten < record.size()) {
+    ssize_t n = ::write(m_indexFd, record.data() + nWritten, record.size() - nWritten);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      throw Error(describeError("Cannot write the index file"));
+    }
+    nWritten += n;
+  }
+}
+
+void
+InMemoryStorageDisk::insert(const Data& data)
+{
+  const Name& fullName = data.getFullName();
+  if (m_index.find(fullName) != m_index.end())
+    return;
+
+  Location location;
+  const Block& wire = data.wireEncode();
+  appendToLog(wire, location.offset);
+  location.length = wire.size();
+  if (data.getFreshnessPeriod() >= time::milliseconds::zero())
+    location.staleTime = time::system_clock::now() + data.getFreshnessPeriod();
+  else
+    location.staleTime = time::system_clock::TimePoint::max();
+
+  appendIndexRecord(fullName, location);
+  m_index.insert(std::make_pair(fullName, location));
+
+  m_ram.insert(data);
+}
+
+shared_ptr<const Data>
+InMemoryStorageDisk::load(Index::const_iterator it)
+{
+  shared_ptr<const Data> data = m_ram.find(it->first);
+  if (data != nullptr)
+    return data;
+
+  const Location& location = it->second;
+  BOOST_ASSERT(location.offset + location.length <= m_logEnd);
+  ++m_nDiskReads;
+  try {
+    shared_ptr<Data> data = make_shared<Data>(Block(make_shared<Buffer>(m_log + location.offset,
+                                                                        location.length)));
+    // the implicit digest also detects a packet whose octets were only partially written
+    if (data->getFullName() == it->first)
+      return data;
+  }
+  catch (const tlv::Error&) {
+  }
+
+  // the packet did not completely reach the disk before a crash, or was overwritten
+  m_corruptedNames.push_back(it->first);
+  return shared_ptr<const Data>();
+}
+
+void
+InMemoryStorageDisk::dropCorrupted()
+{
+  for (const Name& fullName : m_corruptedNames) {
+    erase(fullName, false);
+  }
+  m_corruptedNames.clear();
+}
+
+shared_ptr<const Data>
+InMemoryStorageDisk::promote(const shared_ptr<const Data>& data)
+{
+  m_ram.insert(*data);
+  return data;
+}
+
+shared_ptr<const Data>
+InMemoryStorageDisk::find(const Name& name)
+{
+  shared_ptr<const Data> data;
+  for (Index::const_iterator it = m_index.lower_bound(name);
+       it != m_index.end() && name.isPrefixOf(it->first); ++it) {
+    data = load(it);
+    if (data != nullptr)
+      break;
+  }
+
+  dropCorrupted();
+  return data == nullptr ? data : promote(data);
+}
+
+bool
+InMemoryStorageDisk::canSatisfy(const Interest& interest, Index::const_iterator it,
+                                const time::system_clock::TimePoint& now,
+                                shared_ptr<const Data>& data)
+{
+  if (interest.getMustBeFresh() && it->second.staleTime <= now)
+    return false;
+
+  data = load(it);
+  return data != nullptr && interest.matchesData(*data);
+}
+
+shared_ptr<const Data>
+InMemoryStorageDisk::find(const Interest& interest)
+{
+  shared_ptr<const Data> data = findMatch(interest);
+  dropCorrupted();
+  return data;
+}
+
+shared_ptr<const Data>
+InMemoryStorageDisk::findMatch(const Interest& interest)
+{
+  const Name& prefix = interest.getName();
+  time::system_clock::TimePoint now = time::system_clock::now();
+
+  // if a packet is located by its full name, it must be the packet to return
+  Index::const_iterator it = m_index.find(prefix);
+  if (it != m_index.end()) {
+    if (interest.getMustBeFresh() && it->second.staleTime <= now)
+      return shared_ptr<const Data>();
+    shared_ptr<const Data> data = load(it);
+    return data == nullptr ? data : promote(data);
+  }
+
+  // the packets under the Interest name are [first, last)
+  Index::const_iterator first = m_index.lower_bound(prefix);
+  Index::const_iterator last = prefix.empty() ? m_index.end() :
+                                                m_index.lower_bound(prefix.getSuccessor());
+
+  shared_ptr<const Data> data;
+  if (interest.getChildSelector() <= 0) {
+    for (it = first; it != last; ++it) {
+      if (canSatisfy(interest, it, now, data))
+        return promote(data);
+    }
+    return shared_ptr<const Data>();
+  }
+
+  // rightmost child: walk the children from right to left, and return the leftmost
+  // satisfying packet of the first child that has one
+  Index::const_iterator childEnd = last;
+  while (childEnd != first) {
+    const Name& lastInChild = std::prev(childEnd)->first;
+    Index::const_iterator childBegin = m_index.lower_bound(lastInChild.getPrefix(prefix.size() + 1));
+    for (it = childBegin; it != childEnd; ++it) {
+      if (canSatisfy(interest, it, now, data))
+        return promote(data);
+    }
+    childEnd = childBegin;
+  }
+  return shared_ptr<const Data>();
+}
+
+void
+InMemoryStorageDisk::erase(const Name& prefix, bool isPrefix)
+{
+  static const Location TOMBSTONE = {0, 0, time::system_clock::TimePoint()};
+
+  if (!isPrefix) {
+    Index::iterator it = m_index.find(prefix);
+    if (it == m_index.end())
+      return;
+    appendIndexRecord(it->first, TOMBSTONE);
+    m_index.erase(it);
+    m_ram.erase(prefix, false);
+    return;
+  }
+
+  Index::iterator it = m_index.lower_bound(prefix);
+  while (it != m_index.end() && prefix.isPrefixOf(it->first)) {
+    appendIndexRecord(it->first, TOMBSTONE);
+    it = m_index.erase(it);
+  }
+  m_ram.erase(prefix, true);
+}
+
+void
+InMemoryStorageDisk::flush()
+{
+  if (::msync(m_log, m_logEnd, MS_SYNC) != 0)
+    throw Error(describeError("Cannot write the segment log"));
+  if (::fsync(m_indexFd) != 0)
+    throw Error(describeError("Cannot write the index file"));
+}
+
+} // namespace util
+} // namespace ndn
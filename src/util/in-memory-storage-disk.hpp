@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IN_MEMORY_STORAGE_DISK_HPP
+#define NDN_UTIL_IN_MEMORY_STORAGE_DISK_HPP
+
+#include "in-memory-storage-lru.hpp"
+
+#include <map>
+#include <vector>
+
+namespace ndn {
+namespace util {
+
+/** @brief Provides storage of Data packets on disk, with the recently used packets cached in RAM
+ *
+ *  Every inserted Data packet is appended to a segment log, a file that is memory-mapped
+ *  and never rewritten in place.  The full name, position and stale time of each packet
+ *  are appended to a separate index file.  At startup, only the index file is read, so the
+ *  storage is usable without decoding the stored packets.
+ *
+ *  Packets that are found on disk are promoted into an InMemoryStorageLru, which holds the
+ *  hot part of the storage; the least recently used packets are dropped from RAM and served
+ *  from the segment log afterwards.
+ *
+ *  Erasing a packet appends a tombstone record to the index file.  The space occupied by
+ *  erased packets in the segment log is not reclaimed.
+ *
+ *  After a crash, the index file can refer to packets that did not completely reach the
+ *  segment log.  Such a packet is erased when it fails to decode, or does not match the
+ *  implicit digest in its index record, on a lookup, which then continues as if the packet
+ *  had not been stored.
+ *
+ *  @note The file formats use the native byte order, and are not meant to be moved between
+ *        hosts of different architectures.
+ */
+class InMemoryStorageDisk : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** @brief Opens the storage in @p directory, creating it if it does not exist
+   *  @param directory directory that holds the segment log and the index file
+   *  @param ramLimit maximum number of Data packets cached in RAM
+   *  @throw Error the files cannot be opened or mapped
+   */
+  explicit
+  InMemoryStorageDisk(const std::string& directory, size_t ramLimit = 1000);
+
+  ~InMemoryStorageDisk();
+
+  /** @brief Inserts a Data packet
+   *
+   *  The packet is written to the segment log and cached in RAM.  A packet whose full name
+   *  is already in the storage is not written again.
+   *
+   *  @throw Error the segment log or the index file cannot be written
+   */
+  void
+  insert(const Data& data);
+
+  /** @brief Finds the Data packet whose full name is the smallest one under @p name
+   *  @return the packet, or nullptr if there is no such packet
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /** @brief Finds the best match Data for an Interest
+   *
+   *  The selection follows InMemoryStorage::find(const Interest&).  MustBeFresh is evaluated
+   *  against the wall clock time the packet was inserted, so it holds across restarts.
+   *
+   *  @return the packet, or nullptr if there is no match
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /** @brief Erases the Data packets under @p prefix, or the one whose full name is @p prefix
+   *         if @p isPrefix is false
+   */
+  void
+  erase(const Name& prefix, bool isPrefix = true);
+
+  /** @brief Writes the mapped segment log and the index file to the disk
+   */
+  void
+  flush();
+
+  /** @return number of Data packets in the storage
+   */
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  /** @return the RAM cache in front of the segment log
+   */
+  const InMemoryStorage&
+  getRamCache() const
+  {
+    return m_ram;
+  }
+
+  /** @return number of octets occupied by the segment log, including erased packets
+   */
+  uint64_t
+  getLogSize() const
+  {
+    return m_logEnd;
+  }
+
+  /** @return number of packets read from the segment log since the storage was opened
+   */
+  size_t
+  getNDiskReads() const
+  {
+    return m_nDiskReads;
+  }
+
+public:
+  /** @brief Name of the segment log in the storage directory
+   */
+  static const std::string LOG_FILENAME;
+
+  /** @brief Name of the index file in the storage directory
+   */
+  static const std::string INDEX_FILENAME;
+
+private:
+  struct Location
+  {
+    uint64_t offset;
+    uint32_t length;
+    time::system_clock::TimePoint staleTime;
+  };
+
+  typedef std::map<Name, Location> Index;
+
+  void
+  loadIndex();
+
+  void
+  appendIndexRecord(const Name& fullName, const Location& location);
+
+  void
+  appendToLog(const Block& wire, uint64_t& offset);
+
+  void
+  mapLog(uint64_t capacity);
+
+  /** @brief Reads a packet from the RAM cache, or from the segment log without caching it
+   *  @return the packet, or nullptr if it cannot be decoded from the segment log; its
+   *          full name is then queued for dropCorrupted()
+   */
+  shared_ptr<const Data>
+  load(Index::const_iterator it);
+
+  /** @brief Erases the packets that load() failed to read
+   *
+   *  This is not done by load() itself, so that callers can keep iterating over the index.
+   */
+  void
+  dropCorrupted();
+
+  shared_ptr<const Data>
+  findMatch(const Interest& interest);
+
+  /** @brief Caches a packet found on disk in RAM
+   */
+  shared_ptr<const Data>
+  promote(const shared_ptr<const Data>& data);
+
+  bool
+  canSatisfy(const Interest& interest, Index::const_iterator it,
+             const time::system_clock::TimePoint& now, shared_ptr<const Data>& data);
+
+private:
+  InMemoryStorageLru m_ram;
+  Index m_index;
+
+  int m_logFd;
+  int m_indexFd;
+  uint8_t* m_log;
+  uint64_t m_logCapacity;
+  uint64_t m_logEnd;
+  size_t m_nDiskReads;
+  std::vector<Name> m_corruptedNames;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IN_MEMORY_STORAGE_DISK_HPP
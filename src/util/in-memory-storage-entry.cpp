@@ -24,6 +24,11 @@
 namespace ndn {
 namespace util {
 
+InMemoryStorageEntry::InMemoryStorageEntry()
+  : m_policyIndex(0)
+{
+}
+
 void
 InMemoryStorageEntry::release()
 {
@@ -34,6 +39,11 @@ void
 InMemoryStorageEntry::setData(const Data& data)
 {
   m_dataPacket = data.shared_from_this();
+
+  if (data.getFreshnessPeriod() >= time::milliseconds::zero())
+    m_staleTime = time::steady_clock::now() + data.getFreshnessPeriod();
+  else
+    m_staleTime = time::steady_clock::TimePoint::max();
 }
 
 } // namespace util
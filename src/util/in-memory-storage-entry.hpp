@@ -34,6 +34,8 @@ namespace util {
 class InMemoryStorageEntry : noncopyable
 {
 public:
+  InMemoryStorageEntry();
+
   /** @brief Releases reference counts on shared objects
    */
   void
@@ -67,12 +69,50 @@ public:
 
 
   /** @brief Changes the content of in-memory storage entry
+   *
+   *  The Data packet becomes stale after its FreshnessPeriod from now.  A Data packet
+   *  without FreshnessPeriod never becomes stale.
    */
   void
   setData(const Data& data);
 
+  /** @brief Returns the time when the Data packet becomes stale
+   */
+  const time::steady_clock::TimePoint&
+  getStaleTime() const
+  {
+    return m_staleTime;
+  }
+
+  /** @brief Checks whether the Data packet is still fresh at @p now
+   */
+  bool
+  isFresh(const time::steady_clock::TimePoint& now) const
+  {
+    return now < m_staleTime;
+  }
+
+  /** @brief Returns the position of the entry in the bookkeeping of a replacement policy
+   *
+   *  A replacement policy that keeps its own array of records can store the index of the
+   *  entry's record here, and find it without a lookup.
+   */
+  size_t
+  getPolicyIndex() const
+  {
+    return m_policyIndex;
+  }
+
+  void
+  setPolicyIndex(size_t index)
+  {
+    m_policyIndex = index;
+  }
+
 private:
   shared_ptr<const Data> m_dataPacket;
+  time::steady_clock::TimePoint m_staleTime;
+  size_t m_policyIndex;
 };
 
 } // namespace util
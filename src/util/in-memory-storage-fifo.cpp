@@ -29,6 +29,11 @@ InMemoryStorageFifo::InMemoryStorageFifo(size_t limit)
 {
 }
 
+InMemoryStorageFifo::InMemoryStorageFifo(boost::asio::io_service& ioService, size_t limit)
+  : InMemoryStorage(ioService, limit)
+{
+}
+
 InMemoryStorageFifo::~InMemoryStorageFifo()
 {
 }
@@ -40,6 +40,10 @@ public:
   explicit
   InMemoryStorageFifo(size_t limit = 10);
 
+  /** @brief Creates in-memory storage that removes stale Data packets in the background
+   */
+  InMemoryStorageFifo(boost::asio::io_service& ioService, size_t limit = 10);
+
   virtual
   ~InMemoryStorageFifo();
 
@@ -29,6 +29,11 @@ InMemoryStorageLfu::InMemoryStorageLfu(size_t limit)
 {
 }
 
+InMemoryStorageLfu::InMemoryStorageLfu(boost::asio::io_service& ioService, size_t limit)
+  : InMemoryStorage(ioService, limit)
+{
+}
+
 InMemoryStorageLfu::~InMemoryStorageLfu()
 {
 }
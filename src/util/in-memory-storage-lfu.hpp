@@ -43,6 +43,10 @@ public:
   explicit
   InMemoryStorageLfu(size_t limit = 10);
 
+  /** @brief Creates in-memory storage that removes stale Data packets in the background
+   */
+  InMemoryStorageLfu(boost::asio::io_service& ioService, size_t limit = 10);
+
   virtual
   ~InMemoryStorageLfu();
 
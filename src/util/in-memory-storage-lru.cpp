@@ -29,6 +29,11 @@ InMemoryStorageLru::InMemoryStorageLru(size_t limit)
 {
 }
 
+InMemoryStorageLru::InMemoryStorageLru(boost::asio::io_service& ioService, size_t limit)
+  : InMemoryStorage(ioService, limit)
+{
+}
+
 InMemoryStorageLru::~InMemoryStorageLru()
 {
 }
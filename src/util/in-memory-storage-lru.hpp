@@ -42,6 +42,10 @@ public:
   explicit
   InMemoryStorageLru(size_t limit = 10);
 
+  /** @brief Creates in-memory storage that removes stale Data packets in the background
+   */
+  InMemoryStorageLru(boost::asio::io_service& ioService, size_t limit = 10);
+
   virtual
   ~InMemoryStorageLru();
 
@@ -39,5 +39,11 @@ InMemoryStoragePersistent::evictItem()
   return false;
 }
 
+bool
+InMemoryStoragePersistent::evictStaleItem()
+{
+  return false;
+}
+
 } // namespace util
 } // namespace ndn
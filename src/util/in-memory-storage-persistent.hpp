@@ -48,6 +48,15 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
    */
   virtual bool
   evictItem();
+
+  /** @brief Do nothing.
+   *
+   *  Stale packets are removed only by an explicit eraseStale().
+   *
+   *  @return false
+   */
+  virtual bool
+  evictStaleItem();
 };
 
 } // namespace util
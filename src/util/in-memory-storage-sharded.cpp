@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-sharded.hpp"
+#include "in-memory-storage-lru.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+namespace util {
+
+const size_t InMemoryStorageSharded::DEFAULT_N_SHARDS = 16;
+
+static unique_ptr<InMemoryStorage>
+makeLruShard(size_t limit)
+{
+  return unique_ptr<InMemoryStorage>(new InMemoryStorageLru(limit));
+}
+
+InMemoryStorageSharded::InMemoryStorageSharded(size_t keyLength, size_t limit, size_t nShards,
+                                               const ShardFactory& makeShard)
+  : m_keyLength(keyLength)
+{
+  BOOST_ASSERT(nShards > 0);
+
+  size_t shardLimit = limit;
+  if (limit != std::numeric_limits<size_t>::max())
+    shardLimit = limit / nShards + (limit % nShards != 0);
+
+  m_shards.reserve(nShards);
+  for (size_t i = 0; i < nShards; ++i) {
+    m_shards.push_back(unique_ptr<Shard>(new Shard));
+    m_shards.back()->storage = makeShard ? makeShard(shardLimit) : makeLruShard(shardLimit);
+    if (m_shards.back()->storage->hasStaleSweep())
+      throw std::invalid_argument("the storage of a shard must not be created with an io_service");
+  }
+}
+
+size_t
+InMemoryStorageSharded::getShardIndex(const Name& name) const
+{
+  // same as std::hash<Name>()(name.getPrefix(m_keyLength)), without copying the prefix
+  std::hash<name::Component> hashComponent;
+  size_t seed = 0;
+  size_t nComponents = std::min(name.size(), m_keyLength);
+  for (size_t i = 0; i < nComponents; ++i) {
+    boost::hash_combine(seed, hashComponent(name.get(i)));
+  }
+  return seed % m_shards.size();
+}
+
+bool
+InMemoryStorageSharded::findShard(const Name& name, size_t& shardIndex) const
+{
+  // a name ending with an implicit digest matches only the Data packet named by the rest of it
+  if (!name.empty() && name.get(-1).isImplicitSha256Digest()) {
+    shardIndex = getShardIndex(name.getPrefix(-1));
+    return true;
+  }
+
+  if (name.size() >= m_keyLength) {
+    shardIndex = getShardIndex(name);
+    return true;
+  }
+  return false;
+}
+
+void
+InMemoryStorageSharded::insert(const Data& data)
+{
+  // packets found in the storage can be read by several threads at once
+  data.decodeDeferredFields();
+
+  Shard& shard = getShard(getShardIndex(data.getName()));
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.storage->insert(data);
+}
+
+shared_ptr<const Data>
+InMemoryStorageSharded::find(const Name& name)
+{
+  size_t shardIndex = 0;
+  if (findShard(name, shardIndex)) {
+    Shard& shard = getShard(shardIndex);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.storage->find(name);
+  }
+
+  shared_ptr<const Data> best;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    shared_ptr<const Data> found;
+    {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      found = shard->storage->find(name);
+    }
+    if (found != nullptr && (best == nullptr || found->getFullName() < best->getFullName()))
+      best = found;
+  }
+  return best;
+}
+
+shared_ptr<const Data>
+InMemoryStorageSharded::find(const Interest& interest)
+{
+  size_t shardIndex = 0;
+  if (findShard(interest.getName(), shardIndex)) {
+    Shard& shard = getShard(shardIndex);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.storage->find(interest);
+  }
+
+  // Each shard returns its leftmost match, or the leftmost match under its rightmost child
+  // that has one.  The leftmost of these, or the leftmost under the rightmost child, is the
+  // result of looking up the union of the shards.
+  bool isRightmost = interest.getChildSelector() > 0;
+  size_t childPrefixLength = interest.getName().size() + 1;
+  auto isBetter = [&] (const Data& found, const Data& best) {
+    if (isRightmost) {
+      int order = found.getFullName().compare(0, childPrefixLength,
+                                              best.getFullName(), 0, childPrefixLength);
+      if (order != 0)
+        return order > 0;
+    }
+    return found.getFullName() < best.getFullName();
+  };
+
+  shared_ptr<const Data> best;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    shared_ptr<const Data> found;
+    {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      found = shard->storage->find(interest);
+    }
+    if (found != nullptr && (best == nullptr || isBetter(*found, *best)))
+      best = found;
+  }
+  return best;
+}
+
+void
+InMemoryStorageSharded::erase(const Name& prefix, bool isPrefix)
+{
+  size_t shardIndex = 0;
+  if (findShard(prefix, shardIndex)) {
+    Shard& shard = getShard(shardIndex);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.storage->erase(prefix, isPrefix);
+    return;
+  }
+
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->storage->erase(prefix, isPrefix);
+  }
+}
+
+void
+InMemoryStorageSharded::eraseStale()
+{
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->storage->eraseStale();
+  }
+}
+
+size_t
+InMemoryStorageSharded::size() const
+{
+  size_t nPackets = 0;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    nPackets += shard->storage->size();
+  }
+  return nPackets;
+}
+
+} // namespace util
+} // namespace ndn
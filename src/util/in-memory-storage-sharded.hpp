@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IN_MEMORY_STORAGE_SHARDED_HPP
+#define NDN_UTIL_IN_MEMORY_STORAGE_SHARDED_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <mutex>
+
+namespace ndn {
+namespace util {
+
+/** @brief Provides thread-safe in-memory storage partitioned into independently locked shards
+ *
+ *  A Data packet is placed in a shard chosen by the hash of the first @p keyLength components
+ *  of its name.  Each shard is an InMemoryStorage with its own lock and its own replacement
+ *  policy, so threads working on different shards do not wait for each other, and eviction
+ *  in one shard does not affect the others.
+ *
+ *  An Interest or prefix with at least @p keyLength components is looked up in one shard.
+ *  A shorter one is looked up in every shard in turn, and the best of the per-shard results
+ *  is returned; such a lookup is not atomic with respect to concurrent insertions.
+ *
+ *  The key length should cover the components that tell the producers' objects apart, e.g.
+ *  the prefix of an object without its version and segment components, so that all segments
+ *  of an object share a shard and Interests for them visit only that shard.
+ */
+class InMemoryStorageSharded : noncopyable
+{
+public:
+  /** @brief creates the storage of one shard, given its packet limit
+   *
+   *  The storage must not be created with an io_service, because its background sweep of
+   *  stale packets would not take the lock of the shard; call eraseStale() instead.
+   */
+  typedef function<unique_ptr<InMemoryStorage>(size_t limit)> ShardFactory;
+
+  static const size_t DEFAULT_N_SHARDS;
+
+  /** @brief Creates sharded storage
+   *  @param keyLength number of name components that choose the shard of a packet
+   *  @param limit total number of packets, divided evenly among the shards
+   *  @param nShards number of shards
+   *  @param makeShard creates the storage of each shard; InMemoryStorageLru if empty
+   *  @throw std::invalid_argument a storage created by @p makeShard sweeps stale packets in
+   *                               the background
+   */
+  explicit
+  InMemoryStorageSharded(size_t keyLength,
+                         size_t limit = std::numeric_limits<size_t>::max(),
+                         size_t nShards = DEFAULT_N_SHARDS,
+                         const ShardFactory& makeShard = ShardFactory());
+
+  /** @brief Inserts a Data packet into its shard
+   *
+   *  The packet must be managed by a shared_ptr, and must not be modified afterwards.
+   *  Its elements deferred by Data::lazyWireDecode() are decoded before it is inserted.
+   */
+  void
+  insert(const Data& data);
+
+  /** @brief Finds the Data packet whose full name is the smallest one under @p name
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /** @brief Finds the best match Data for an Interest
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /** @brief Deletes Data packets by prefix, or by full name if @p isPrefix is false
+   */
+  void
+  erase(const Name& prefix, bool isPrefix = true);
+
+  /** @brief Removes the Data packets whose FreshnessPeriod has expired from every shard
+   */
+  void
+  eraseStale();
+
+  /** @return number of packets in all shards
+   */
+  size_t
+  size() const;
+
+  size_t
+  getNShards() const
+  {
+    return m_shards.size();
+  }
+
+  size_t
+  getKeyLength() const
+  {
+    return m_keyLength;
+  }
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** @return index of the shard for a Data packet named @p name,
+   *          which has at least getKeyLength() components or is the whole Data name
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+  /** @brief Chooses the shard that holds every packet that can match @p name
+   *  @param name Interest name or prefix, which may end with an implicit digest
+   *  @param[out] shardIndex the shard, if there is one
+   *  @return whether one shard holds all such packets
+   */
+  bool
+  findShard(const Name& name, size_t& shardIndex) const;
+
+  struct Shard
+  {
+    std::mutex mutex;
+    unique_ptr<InMemoryStorage> storage;
+  };
+
+  Shard&
+  getShard(size_t shardIndex) const
+  {
+    return *m_shards[shardIndex];
+  }
+
+private:
+  size_t m_keyLength;
+  std::vector<unique_ptr<Shard>> m_shards;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IN_MEMORY_STORAGE_SHARDED_HPP
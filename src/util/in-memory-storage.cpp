@@ -83,9 +83,23 @@ InMemoryStorage::const_iterator::operator!=(const const_iterator& rhs)
   return m_it != rhs.m_it;
 }
 
+const time::milliseconds InMemoryStorage::STALE_SWEEP_INTERVAL(1000);
+
+InMemoryStorage::InMemoryStorage(boost::asio::io_service& ioService, size_t limit)
+  : InMemoryStorage(limit)
+{
+  m_scheduler.reset(new Scheduler(ioService));
+  scheduleStaleSweep();
+}
+
 InMemoryStorage::InMemoryStorage(size_t limit)
   : m_limit(limit)
   , m_nPackets(0)
+  , m_byteLimit(std::numeric_limits<size_t>::max())
+  , m_nBytes(0)
+  , m_peakNBytes(0)
+  , m_nEvictions(0)
+  , m_nStaleEvictions(0)
 {
   // TODO consider a more suitable initial value
   m_capacity = 10;
@@ -124,7 +138,7 @@ InMemoryStorage::setCapacity(size_t capacity)
   if (size() > m_capacity) {
     ssize_t nAllowedFailures = size() - m_capacity;
     while (size() > m_capacity) {
-      if (!evictItem() && --nAllowedFailures < 0) {
+      if (!evict() && --nAllowedFailures < 0) {
         throw Error();
       }
     }
@@ -145,6 +159,17 @@ InMemoryStorage::setCapacity(size_t capacity)
   BOOST_ASSERT(size() + m_freeEntries.size() == m_capacity);
 }
 
+void
+InMemoryStorage::setByteLimit(size_t nMaxBytes)
+{
+  m_byteLimit = nMaxBytes;
+
+  while (m_nBytes > m_byteLimit) {
+    if (!evict())
+      break;
+  }
+}
+
 void
 InMemoryStorage::insert(const Data& data)
 {
@@ -153,6 +178,15 @@ InMemoryStorage::insert(const Data& data)
   if (it != m_cache.get<byFullName>().end())
     return;
 
+  //if the packet does not fit into the byte limit, employ replacement policy
+  size_t nBytes = data.wireEncode().size();
+  if (nBytes > m_byteLimit)
+    return;
+  while (m_nBytes + nBytes > m_byteLimit) {
+    if (!evict())
+      return;
+  }
+
   //if full, double the capacity
   bool doesReachLimit = (getLimit() == getCapacity());
   if (isFull() && !doesReachLimit) {
@@ -163,7 +197,7 @@ InMemoryStorage::insert(const Data& data)
 
   //if full and reach limitation of the capacity, employ replacement policy
   if (isFull() && doesReachLimit) {
-    evictItem();
+    evict();
   }
 
   //insert to cache
@@ -172,6 +206,8 @@ InMemoryStorage::insert(const Data& data)
   InMemoryStorageEntry* entry = m_freeEntries.top();
   m_freeEntries.pop();
   m_nPackets++;
+  m_nBytes += nBytes;
+  m_peakNBytes = std::max(m_peakNBytes, m_nBytes);
   entry->setData(data);
   m_cache.insert(entry);
 
@@ -207,6 +243,8 @@ InMemoryStorage::find(const Interest& interest)
 
   //if a packet is located by its full name, it must be the packet to return.
   if (it != m_cache.get<byFullName>().end()) {
+    if (interest.getMustBeFresh() && !(*it)->isFresh(time::steady_clock::now()))
+      return shared_ptr<const Data>();
     return ((*it)->getData()).shared_from_this();
   }
 
@@ -248,9 +286,17 @@ InMemoryStorage::selectChild(const Interest& interest,
   bool hasLeftmostSelector = (interest.getChildSelector() <= 0);
   bool hasRightmostSelector = !hasLeftmostSelector;
 
+  // stale Data cannot satisfy an Interest with MustBeFresh
+  bool mustBeFresh = interest.getMustBeFresh();
+  time::steady_clock::TimePoint now = mustBeFresh ? time::steady_clock::now() :
+                                                    time::steady_clock::TimePoint::min();
+  auto canSatisfy = [&] (const InMemoryStorageEntry* entry) {
+    return (!mustBeFresh || entry->isFresh(now)) && interest.matchesData(entry->getData());
+  };
+
   if (hasLeftmostSelector)
     {
-      if (interest.matchesData((*startingPoint)->getData()))
+      if (canSatisfy(*startingPoint))
         {
           return *startingPoint;
         }
@@ -276,7 +322,7 @@ InMemoryStorage::selectChild(const Interest& interest,
 
           if (isInPrefix)
             {
-              if (interest.matchesData((*rightmostCandidate)->getData()))
+              if (canSatisfy(*rightmostCandidate))
                 {
                   if (hasLeftmostSelector)
                     {
@@ -309,7 +355,7 @@ InMemoryStorage::selectChild(const Interest& interest,
 
   if (hasRightmostSelector) // if rightmost was not found, try starting point
     {
-      if (interest.matchesData((*startingPoint)->getData()))
+      if (canSatisfy(*startingPoint))
         {
           return *startingPoint;
         }
@@ -318,9 +364,57 @@ InMemoryStorage::selectChild(const Interest& interest,
   return 0;
 }
 
+bool
+InMemoryStorage::evict()
+{
+  if (evictStaleItem()) {
+    return true;
+  }
+  return evictItem();
+}
+
+bool
+InMemoryStorage::evictStaleItem()
+{
+  return eraseFirstStale();
+}
+
+bool
+InMemoryStorage::eraseFirstStale()
+{
+  Cache::index<byStaleTime>::type& staleIndex = m_cache.get<byStaleTime>();
+  Cache::index<byStaleTime>::type::iterator it = staleIndex.begin();
+  if (it == staleIndex.end() || (*it)->isFresh(time::steady_clock::now()))
+    return false;
+
+  //let derived class do something with the entry
+  beforeErase(*it);
+  freeEntry(m_cache.project<byFullName>(it));
+  m_nStaleEvictions++;
+  return true;
+}
+
+void
+InMemoryStorage::eraseStale()
+{
+  while (eraseFirstStale()) {
+  }
+}
+
+void
+InMemoryStorage::scheduleStaleSweep()
+{
+  m_staleSweepEvent = m_scheduler->scheduleEvent(STALE_SWEEP_INTERVAL, [this] {
+      eraseStale();
+      scheduleStaleSweep();
+    });
+}
+
 InMemoryStorage::Cache::iterator
 InMemoryStorage::freeEntry(Cache::iterator it)
 {
+  m_nBytes -= (*it)->getData().wireEncode().size();
+
   //push the *empty* entry into mem pool
   (*it)->release();
   m_freeEntries.push(*it);
@@ -364,6 +458,7 @@ InMemoryStorage::eraseImpl(const Name& name)
     return;
 
   freeEntry(it);
+  m_nEvictions++;
 }
 
 InMemoryStorage::const_iterator
@@ -27,6 +27,7 @@
 #include "../data.hpp"
 
 #include "in-memory-storage-entry.hpp"
+#include "scheduler.hpp"
 
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
@@ -48,6 +49,7 @@ class InMemoryStorage : noncopyable
 public:
   //multi_index_container to implement storage
   class byFullName;
+  class byStaleTime;
 
   typedef boost::multi_index_container<
     InMemoryStorageEntry*,
@@ -59,6 +61,14 @@ public:
         boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
                                           &InMemoryStorageEntry::getFullName>,
         std::less<Name>
+      >,
+
+      // by the time when Data becomes stale, the first entry becomes stale first
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byStaleTime>,
+        boost::multi_index::const_mem_fun<InMemoryStorageEntry,
+                                          const time::steady_clock::TimePoint&,
+                                          &InMemoryStorageEntry::getStaleTime>
       >
 
     >
@@ -109,9 +119,22 @@ public:
     }
   };
 
+  /** @brief Interval of the background removal of stale Data packets
+   */
+  static const time::milliseconds STALE_SWEEP_INTERVAL;
+
   explicit
   InMemoryStorage(size_t limit = std::numeric_limits<size_t>::max());
 
+  /** @brief Creates in-memory storage that removes stale Data packets in the background
+   *
+   *  Every STALE_SWEEP_INTERVAL, the Data packets whose FreshnessPeriod has expired are
+   *  removed from the storage.
+   */
+  explicit
+  InMemoryStorage(boost::asio::io_service& ioService,
+                  size_t limit = std::numeric_limits<size_t>::max());
+
   /** @note Please make sure to implement it to free m_freeEntries and evict
     * all items in the derived class for anybody who wishes to inherit this class
     */
@@ -130,6 +153,9 @@ public:
   insert(const Data& data);
 
   /** @brief Finds the best match Data for an Interest
+   *
+   *  If the Interest has MustBeFresh, only Data packets that are still within their
+   *  FreshnessPeriod can match.
    *
    *  @note It will invoke afterAccess(shared_ptr<InMemoryStorageEntry>).
    *  As currently it is impossible to determine whether a Name contains implicit digest or not,
@@ -184,6 +210,73 @@ public:
     return m_nPackets;
   }
 
+  /** @brief sets the maximum total wire size of the packets in in-memory storage (in octets)
+   *
+   *  Packets are evicted according to the replacement policy until the storage fits within
+   *  the new limit.  Afterwards, insert() evicts packets until the new packet fits.
+   *  A packet larger than the limit is not inserted.  If the replacement policy cannot evict
+   *  any more packets, as in InMemoryStoragePersistent, new packets are not inserted until
+   *  enough packets are erased.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
+  /** @return{ maximum total wire size of packets in in-memory storage (in octets) }
+   */
+  size_t
+  getByteLimit() const
+  {
+    return m_byteLimit;
+  }
+
+  /** @return{ total wire size of packets stored in in-memory storage (in octets) }
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
+  /** @return{ highest value of getNBytes() since the storage was created }
+   */
+  size_t
+  getPeakNBytes() const
+  {
+    return m_peakNBytes;
+  }
+
+  /** @return{ number of packets evicted by the replacement policy }
+   */
+  size_t
+  getNEvictions() const
+  {
+    return m_nEvictions;
+  }
+
+  /** @return{ number of stale packets removed to make room or by the background sweep }
+   */
+  size_t
+  getNStaleEvictions() const
+  {
+    return m_nStaleEvictions;
+  }
+
+  /** @brief Removes all Data packets whose FreshnessPeriod has expired
+   *
+   *  The storage created with an io_service does this periodically.
+   */
+  void
+  eraseStale();
+
+  /** @return whether stale Data packets are removed in the background,
+   *          i.e. the storage was created with an io_service
+   */
+  bool
+  hasStaleSweep() const
+  {
+    return m_scheduler != nullptr;
+  }
+
   /** @brief Returns begin iterator of the in-memory storage ordering by
    *  name with digest
    *
@@ -231,6 +324,16 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   virtual bool
   evictItem() = 0;
 
+  /** @brief Removes the Data packet that became stale first, if it is stale by now
+   *
+   *  When the storage is full, stale packets are removed before evictItem() is invoked.
+   *  It will invoke beforeErase(shared_ptr<InMemoryStorageEntry>).
+   *  Derived classes that must not remove packets on their own may override it to do nothing.
+   *  @return{ whether the Data was removed }
+   */
+  virtual bool
+  evictStaleItem();
+
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   /** @brief sets current capacity of in-memory storage (in packets)
    */
@@ -259,6 +362,7 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
    *  This is the function one should use to erase entry in the cache
    *  in derived class.
    *  It won't invoke beforeErase(shared_ptr<Entry>).
+   *  The erased entry is counted as an eviction.
    */
   void
   eraseImpl(const Name& name);
@@ -269,6 +373,22 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   printCache(std::ostream& os) const;
 
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** @brief Removes one Data packet, a stale one if possible, otherwise the one chosen by
+   *  the replacement policy
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evict();
+
+  /** @brief Removes the Data packet that became stale first, if it is stale by now
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  eraseFirstStale();
+
+  void
+  scheduleStaleSweep();
+
   /** @brief free in-memory storage entries by an iterator pointing to that entry.
       @return An iterator pointing to the element that followed the last element erased.
    */
@@ -301,6 +421,19 @@ private:
   size_t m_capacity;
   /// current number of packets in in-memory storage
   size_t m_nPackets;
+  /// user defined maximum total wire size of packets in octets
+  size_t m_byteLimit;
+  /// current total wire size of packets in octets
+  size_t m_nBytes;
+  /// highest total wire size of packets in octets
+  size_t m_peakNBytes;
+  /// number of packets evicted by the replacement policy
+  size_t m_nEvictions;
+  /// number of stale packets removed
+  size_t m_nStaleEvictions;
+  /// present if stale packets are removed in the background
+  unique_ptr<Scheduler> m_scheduler;
+  scheduler::EventId m_staleSweepEvent;
   /// memory pool
   std::stack<InMemoryStorageEntry*> m_freeEntries;
 };
@@ -25,6 +25,7 @@
 #include "../common.hpp"
 
 #include "../encoding/block.hpp"
+#include "../encoding/block-stream-reader.hpp"
 #include "../encoding/buffer-stream.hpp"
 
 #include <iostream>
@@ -51,10 +52,48 @@ enum IoEncoding {
   HEX
 };
 
+/** @brief Decode the next object from a stream of unencoded TLV blocks
+ *
+ *  The object's wire encoding shares the reader's buffer, so a stream holding many objects
+ *  (e.g., a packet trace) can be loaded one by one without copying.
+ *
+ *  @return the object, or nullptr at the end of the stream or upon a decoding error
+ */
+template<typename T>
+shared_ptr<T>
+load(BlockStreamReader& reader)
+{
+  typedef typename T::Error TypeError;
+  try
+    {
+      Block block;
+      if (!reader.read(block))
+        return shared_ptr<T>();
+
+      shared_ptr<T> object = make_shared<T>();
+      object->wireDecode(block);
+      return object;
+    }
+  catch (TypeError& e)
+    {
+      return shared_ptr<T>();
+    }
+  catch (tlv::Error& e)
+    {
+      return shared_ptr<T>();
+    }
+}
+
 template<typename T>
 shared_ptr<T>
 load(std::istream& is, IoEncoding encoding = BASE_64)
 {
+  if (encoding == NO_ENCODING)
+    {
+      BlockStreamReader reader(is);
+      return load<T>(reader);
+    }
+
   typedef typename T::Error TypeError;
   try
     {
@@ -66,11 +105,6 @@ load(std::istream& is, IoEncoding encoding = BASE_64)
 
       switch (encoding)
         {
-        case NO_ENCODING:
-          {
-            FileSource ss(is, true, new FileSink(os));
-            break;
-          }
         case BASE_64:
           {
             FileSource ss(is, true, new Base64Decoder(new FileSink(os)));
@@ -106,7 +140,7 @@ template<typename T>
 shared_ptr<T>
 load(const std::string& file, IoEncoding encoding = BASE_64)
 {
-  std::ifstream is(file.c_str());
+  std::ifstream is(file.c_str(), std::ios::binary);
   return load<T>(is, encoding);
 }
 
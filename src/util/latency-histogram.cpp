@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "latency-histogram.hpp"
+
+#include <limits>
+
+namespace ndn {
+namespace util {
+
+const size_t LatencyHistogram::N_BUCKETS;
+
+LatencyHistogram::LatencyHistogram()
+{
+  this->reset();
+}
+
+static size_t
+getBucketIndex(uint64_t latency)
+{
+  size_t index = 0;
+  while (latency > 1) {
+    latency >>= 1;
+    ++index;
+  }
+  return index;
+}
+
+void
+LatencyHistogram::add(const time::nanoseconds& latency)
+{
+  uint64_t ns = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+
+  ++m_buckets[getBucketIndex(ns)];
+  ++m_count;
+  m_min = std::min(m_min, ns);
+  m_max = std::max(m_max, ns);
+  m_sum += ns;
+}
+
+void
+LatencyHistogram::reset()
+{
+  m_buckets.fill(0);
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+  m_sum = 0;
+}
+
+time::nanoseconds
+LatencyHistogram::getMin() const
+{
+  return time::nanoseconds(m_count == 0 ? 0 : m_min);
+}
+
+time::nanoseconds
+LatencyHistogram::getMax() const
+{
+  return time::nanoseconds(m_max);
+}
+
+time::nanoseconds
+LatencyHistogram::getMean() const
+{
+  return time::nanoseconds(m_count == 0 ? 0 : static_cast<uint64_t>(m_sum / m_count));
+}
+
+time::nanoseconds
+LatencyHistogram::getPercentile(double percent) const
+{
+  if (m_count == 0)
+    return time::nanoseconds::zero();
+
+  // number of samples at or below the percentile, at least one
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(percent / 100 * m_count + 0.5));
+
+  uint64_t nSeen = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    nSeen += m_buckets[i];
+    if (nSeen >= rank) {
+      uint64_t upperBound = i + 1 < N_BUCKETS ? (uint64_t(1) << (i + 1)) :
+                                                std::numeric_limits<uint64_t>::max();
+      return time::nanoseconds(std::min(upperBound, m_max));
+    }
+  }
+  return time::nanoseconds(m_max);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram)
+{
+  return os << "count=" << histogram.getCount()
+            << " min=" << histogram.getMin().count() << "ns"
+            << " mean=" << histogram.getMean().count() << "ns"
+            << " max=" << histogram.getMax().count() << "ns"
+            << " p50<=" << histogram.getPercentile(50).count() << "ns"
+            << " p90<=" << histogram.getPercentile(90).count() << "ns"
+            << " p99<=" << histogram.getPercentile(99).count() << "ns"
+            << " p99.9<=" << histogram.getPercentile(99.9).count() << "ns";
+}
+
+} // namespace util
+} // namespace ndn
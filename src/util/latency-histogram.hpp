@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_LATENCY_HISTOGRAM_HPP
+#define NDN_UTIL_LATENCY_HISTOGRAM_HPP
+
+#include "../common.hpp"
+#include "time.hpp"
+
+#include <array>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Histogram of latencies with logarithmic buckets
+ *
+ * Bucket i counts latencies of at least 2^i and less than 2^(i+1) nanoseconds, except that
+ * bucket 0 covers [0, 2) nanoseconds.  Adding a sample is a constant-time operation and the
+ * histogram has a fixed size, while percentiles are reported within a factor of two.
+ * Minimum, maximum, and mean are exact.
+ */
+class LatencyHistogram
+{
+public:
+  static const size_t N_BUCKETS = 64;
+
+  LatencyHistogram();
+
+  /** @brief add a sample; negative latencies are counted as zero
+   */
+  void
+  add(const time::nanoseconds& latency);
+
+  /** @brief remove all samples
+   */
+  void
+  reset();
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  /** @return smallest sample, or zero if there is no sample
+   */
+  time::nanoseconds
+  getMin() const;
+
+  /** @return largest sample, or zero if there is no sample
+   */
+  time::nanoseconds
+  getMax() const;
+
+  /** @return mean of all samples, or zero if there is no sample
+   */
+  time::nanoseconds
+  getMean() const;
+
+  /**
+   * @brief Get an upper bound of the given percentile
+   * @param percent percentile in the range [0, 100]
+   * @return the exclusive upper bound of the bucket where the percentile falls, limited to
+   *         the largest sample; zero if there is no sample
+   */
+  time::nanoseconds
+  getPercentile(double percent) const;
+
+  /** @brief number of samples in bucket @p i
+   */
+  uint64_t
+  getBucketCount(size_t i) const
+  {
+    return m_buckets.at(i);
+  }
+
+private:
+  std::array<uint64_t, N_BUCKETS> m_buckets;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double m_sum;
+};
+
+/**
+ * @brief Print count, min, mean, max and 50/90/99/99.9 percentiles on one line
+ */
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram);
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LATENCY_HISTOGRAM_HPP
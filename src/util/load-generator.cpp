@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "load-generator.hpp"
+#include "../security/digest-sha256.hpp"
+
+namespace ndn {
+namespace util {
+
+const LoadGenerator::Options LoadGenerator::DEFAULT_OPTIONS {
+  Name("/load-generator"), 1000, 0, time::seconds(4), 1024
+};
+
+const time::milliseconds LoadGenerator::TICK_INTERVAL = time::milliseconds(1);
+
+LoadGenerator::LoadGenerator(const Options& options)
+  : m_options(options)
+  , m_content(make_shared<Buffer>(options.contentSize))
+  , m_consumerFace(nullptr)
+  , m_producerFace(nullptr)
+  , m_interestFilterId(nullptr)
+  , m_nSentInterests(0)
+  , m_nReceivedData(0)
+  , m_nTimeouts(0)
+  , m_nServedInterests(0)
+{
+}
+
+LoadGenerator::~LoadGenerator()
+{
+  this->stop();
+}
+
+void
+LoadGenerator::startProducer(Face& face)
+{
+  if (m_token == nullptr)
+    m_token = make_shared<bool>(true);
+  weak_ptr<bool> token = m_token;
+
+  DigestSha256 signature;
+  std::vector<uint8_t> signatureValue(32, 0);
+  signature.setValue(dataBlock(tlv::SignatureValue, &signatureValue[0], signatureValue.size()));
+
+  m_producerFace = &face;
+  m_interestFilterId = face.setInterestFilter(m_options.prefix,
+    [this, token, signature] (const InterestFilter&, const Interest& interest) {
+      if (token.expired())
+        return;
+
+      shared_ptr<Data> data = make_shared<Data>(interest.getName());
+      data->setContent(m_content);
+      data->setSignature(signature);
+
+      ++m_nServedInterests;
+      m_producerFace->put(*data);
+    });
+}
+
+void
+LoadGenerator::startConsumer(Face& face, const function<void()>& onFinished)
+{
+  if (!(m_options.interestRate > 0))
+    throw std::invalid_argument("Interest rate must be positive");
+
+  if (m_token == nullptr)
+    m_token = make_shared<bool>(true);
+
+  m_consumerFace = &face;
+  m_onFinished = onFinished;
+  m_scheduler.reset(new scheduler::Scheduler(face.getIoService()));
+  m_startTime = time::steady_clock::now();
+  this->expressInterests();
+}
+
+void
+LoadGenerator::stop()
+{
+  m_token.reset();
+
+  if (m_scheduler != nullptr) {
+    m_scheduler->cancelEvent(m_tickEvent);
+    m_scheduler.reset();
+  }
+
+  if (m_producerFace != nullptr) {
+    m_producerFace->unsetInterestFilter(m_interestFilterId);
+    m_producerFace = nullptr;
+  }
+}
+
+void
+LoadGenerator::expressInterests()
+{
+  double elapsed = time::duration_cast<time::nanoseconds>(time::steady_clock::now() -
+                                                          m_startTime).count() / 1e9;
+  // the first Interest is expressed immediately
+  uint64_t nDue = static_cast<uint64_t>(elapsed * m_options.interestRate) + 1;
+  if (m_options.nInterests > 0)
+    nDue = std::min(nDue, m_options.nInterests);
+
+  weak_ptr<bool> token = m_token;
+  for (; m_nSentInterests < nDue; ++m_nSentInterests) {
+    Interest interest(Name(m_options.prefix).appendNumber(m_nSentInterests));
+    interest.setInterestLifetime(m_options.interestLifetime);
+
+    time::steady_clock::TimePoint sendTime = time::steady_clock::now();
+    m_consumerFace->expressInterest(interest,
+      [this, token, sendTime] (const Interest&, const Data&) {
+        if (token.expired())
+          return;
+        ++m_nReceivedData;
+        m_latencies.add(time::steady_clock::now() - sendTime);
+        this->afterInterestDone();
+      },
+      [this, token] (const Interest&) {
+        if (token.expired())
+          return;
+        ++m_nTimeouts;
+        this->afterInterestDone();
+      });
+  }
+
+  if (m_options.nInterests == 0 || m_nSentInterests < m_options.nInterests) {
+    m_tickEvent = m_scheduler->scheduleEvent(TICK_INTERVAL,
+                                             bind(&LoadGenerator::expressInterests, this));
+  }
+}
+
+void
+LoadGenerator::afterInterestDone()
+{
+  if (m_nReceivedData + m_nTimeouts == m_options.nInterests && m_onFinished) {
+    m_onFinished();
+  }
+}
+
+} // namespace util
+} // namespace ndn
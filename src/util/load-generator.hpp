@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_LOAD_GENERATOR_HPP
+#define NDN_UTIL_LOAD_GENERATOR_HPP
+
+#include "../common.hpp"
+#include "../face.hpp"
+#include "latency-histogram.hpp"
+#include "scheduler.hpp"
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Generates Interest/Data traffic at a configured rate, and measures its latency
+ *
+ * The consumer side expresses Interests named /<prefix>/<sequence number> at a constant rate,
+ * and records the time from expressing each Interest to receiving its Data in a histogram.
+ * The producer side answers every Interest under the prefix with a Data packet of a
+ * configured size, which carries a DigestSha256 signature with a zero value, so that no
+ * cryptographic operation is performed.
+ *
+ * Together with two DummyClientFaces connected with DummyClientFace::linkTo, this allows
+ * benchmarking applications and the library end to end without a forwarder:
+ *
+ *     boost::asio::io_service io;
+ *     shared_ptr<DummyClientFace> consumerFace = makeDummyClientFace(io, {false, false});
+ *     shared_ptr<DummyClientFace> producerFace = makeDummyClientFace(io, {false, false});
+ *     consumerFace->linkTo(*producerFace);
+ *
+ *     LoadGenerator::Options options = LoadGenerator::DEFAULT_OPTIONS;
+ *     options.interestRate = 100000;
+ *     options.nInterests = 1000000;
+ *     LoadGenerator generator(options);
+ *     generator.startProducer(*producerFace);
+ *     generator.startConsumer(*consumerFace, [&io] { io.stop(); });
+ *     io.run();
+ *     std::cout << generator.getLatencies() << std::endl;
+ *
+ * The consumer and the producer may also be started on two LoadGenerators, possibly in two
+ * processes.  LoadGenerator is not thread-safe, and cannot be used with a Face on which
+ * worker threads have been started.  It must be stopped or destroyed before the Faces it uses.
+ */
+class LoadGenerator : noncopyable
+{
+public:
+  struct Options
+  {
+    /** @brief prefix of Interest names
+     */
+    Name prefix;
+
+    /** @brief number of Interests expressed per second
+     */
+    double interestRate;
+
+    /** @brief number of Interests to express; 0 means until stop() is called
+     */
+    uint64_t nInterests;
+
+    /** @brief InterestLifetime of expressed Interests
+     */
+    time::milliseconds interestLifetime;
+
+    /** @brief size of the Content of Data packets sent by the producer
+     */
+    size_t contentSize;
+  };
+
+  /** @brief default options
+   *
+   *  prefix=/load-generator, interestRate=1000, nInterests=0, interestLifetime=4s,
+   *  contentSize=1024
+   */
+  static const Options DEFAULT_OPTIONS;
+
+  /** @brief interval between two rounds of expressing Interests
+   *
+   *  In each round, as many Interests are expressed as needed to keep up with interestRate.
+   */
+  static const time::milliseconds TICK_INTERVAL;
+
+  explicit
+  LoadGenerator(const Options& options = DEFAULT_OPTIONS);
+
+  ~LoadGenerator();
+
+  /**
+   * @brief Start answering Interests under the prefix on @p face
+   *
+   * Only an InterestFilter is set; the prefix is not registered.
+   */
+  void
+  startProducer(Face& face);
+
+  /**
+   * @brief Start expressing Interests on @p face
+   * @param onFinished called when all options.nInterests Interests have been either
+   *                   satisfied or timed out
+   * @throw std::invalid_argument options.interestRate is not positive
+   */
+  void
+  startConsumer(Face& face, const function<void()>& onFinished = function<void()>());
+
+  /**
+   * @brief Stop expressing and answering Interests
+   *
+   * Callbacks for Interests that are still pending are ignored.
+   */
+  void
+  stop();
+
+public: // statistics
+  uint64_t
+  getNSentInterests() const
+  {
+    return m_nSentInterests;
+  }
+
+  uint64_t
+  getNReceivedData() const
+  {
+    return m_nReceivedData;
+  }
+
+  uint64_t
+  getNTimeouts() const
+  {
+    return m_nTimeouts;
+  }
+
+  /** @brief number of Interests answered by the producer
+   */
+  uint64_t
+  getNServedInterests() const
+  {
+    return m_nServedInterests;
+  }
+
+  /** @brief latencies of satisfied Interests
+   */
+  const LatencyHistogram&
+  getLatencies() const
+  {
+    return m_latencies;
+  }
+
+private:
+  void
+  expressInterests();
+
+  void
+  afterInterestDone();
+
+private:
+  Options m_options;
+  ConstBufferPtr m_content;
+
+  Face* m_consumerFace;
+  unique_ptr<scheduler::Scheduler> m_scheduler;
+  scheduler::EventId m_tickEvent;
+  time::steady_clock::TimePoint m_startTime;
+  function<void()> m_onFinished;
+
+  Face* m_producerFace;
+  const InterestFilterId* m_interestFilterId;
+
+  /** @brief callbacks of Face hold a weak reference to this token, and are ignored once the
+   *         token is released by stop()
+   */
+  shared_ptr<bool> m_token;
+
+  uint64_t m_nSentInterests;
+  uint64_t m_nReceivedData;
+  uint64_t m_nTimeouts;
+  uint64_t m_nServedInterests;
+  LatencyHistogram m_latencies;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOAD_GENERATOR_HPP
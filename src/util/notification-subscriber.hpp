@@ -53,12 +53,20 @@
 #include "concepts.hpp"
 #include <boost/concept_check.hpp>
 
+#include <map>
+#include <set>
+
 namespace ndn {
 namespace util {
 
 /** \brief provides a subscriber of Notification Stream
  *  \sa http://redmine.named-data.net/projects/nfd/wiki/Notification
  *  \tparam Notification type of Notification item, appears in payload of Data packets
+ *
+ *  The subscriber keeps up to .getWindowSize() Interests outstanding for sequence numbers
+ *  following the last delivered Notification, so that it can keep up with publishers that
+ *  emit more than one Notification per round-trip time.
+ *  Notifications are always delivered in order of their sequence numbers.
  */
 template<typename Notification>
 class NotificationSubscriber : noncopyable
@@ -68,18 +76,25 @@ public:
   BOOST_CONCEPT_ASSERT((WireDecodable<Notification>));
 
   /** \brief construct a NotificationSubscriber
+   *  \param windowSize maximum number of outstanding Interests for subsequent Notifications
+   *  \throw std::invalid_argument windowSize is zero
    *  \note The subscriber is not started after construction.
    *        User should add one or more handlers to onNotification, and invoke .start().
    */
   NotificationSubscriber(Face& face, const Name& prefix,
-                         const time::milliseconds& interestLifetime = time::milliseconds(60000))
+                         const time::milliseconds& interestLifetime = time::milliseconds(60000),
+                         size_t windowSize = 1)
     : m_face(face)
     , m_prefix(prefix)
     , m_isRunning(false)
     , m_lastSequenceNo(std::numeric_limits<uint64_t>::max())
-    , m_lastInterestId(0)
+    , m_initialInterestId(0)
     , m_interestLifetime(interestLifetime)
+    , m_windowSize(windowSize)
   {
+    if (m_windowSize == 0) {
+      throw std::invalid_argument("windowSize must be positive");
+    }
   }
 
   virtual
@@ -97,6 +112,14 @@ public:
     return m_interestLifetime;
   }
 
+  /** \return maximum number of outstanding Interests for subsequent Notifications
+   */
+  size_t
+  getWindowSize() const
+  {
+    return m_windowSize;
+  }
+
   bool
   isRunning() const
   {
@@ -126,9 +149,7 @@ public:
       return;
     m_isRunning = false;
 
-    if (m_lastInterestId != 0)
-      m_face.removePendingInterest(m_lastInterestId);
-    m_lastInterestId = 0;
+    this->cancelPendingInterests();
   }
 
 public: // subscriptions
@@ -145,6 +166,14 @@ public: // subscriptions
    */
   signal::Signal<NotificationSubscriber, Data> onDecodeError;
 
+  /** \brief fires, in order with onNotification, when a Notification is considered lost
+   *
+   *  A sequence number is considered lost when its Interest times out
+   *  while a Notification with a greater sequence number has been received,
+   *  or when the subscriber starts over while such a Notification is buffered.
+   */
+  signal::Signal<NotificationSubscriber, uint64_t> onGap;
+
 private:
   void
   sendInitialInterest()
@@ -152,18 +181,22 @@ private:
     if (this->shouldStop())
       return;
 
+    this->cancelPendingInterests();
+
     shared_ptr<Interest> interest = make_shared<Interest>(m_prefix);
     interest->setMustBeFresh(true);
     interest->setChildSelector(1);
     interest->setInterestLifetime(getInterestLifetime());
 
-    m_lastInterestId = m_face.expressInterest(*interest,
-                         bind(&NotificationSubscriber<Notification>::afterReceiveData, this, _2),
-                         bind(&NotificationSubscriber<Notification>::afterTimeout, this));
+    m_initialInterestId = m_face.expressInterest(*interest,
+                            bind(&NotificationSubscriber<Notification>::afterReceiveData, this, _2),
+                            bind(&NotificationSubscriber<Notification>::afterInitialTimeout, this));
   }
 
+  /** \brief fill the window with Interests for sequence numbers following the last delivered one
+   */
   void
-  sendNextInterest()
+  sendNextInterests()
   {
     if (this->shouldStop())
       return;
@@ -171,15 +204,40 @@ private:
     BOOST_ASSERT(m_lastSequenceNo !=
                  std::numeric_limits<uint64_t>::max());// overflow or missing initial reply
 
-    Name nextName = m_prefix;
-    nextName.appendSequenceNumber(m_lastSequenceNo + 1);
+    for (uint64_t seqNo = m_lastSequenceNo + 1; seqNo <= m_lastSequenceNo + m_windowSize; ++seqNo) {
+      if (m_pendingInterests.count(seqNo) > 0 ||
+          m_receivedNotifications.count(seqNo) > 0 ||
+          m_lostSequenceNos.count(seqNo) > 0)
+        continue;
 
-    shared_ptr<Interest> interest = make_shared<Interest>(nextName);
-    interest->setInterestLifetime(getInterestLifetime());
+      Name nextName = m_prefix;
+      nextName.appendSequenceNumber(seqNo);
 
-    m_lastInterestId = m_face.expressInterest(*interest,
+      shared_ptr<Interest> interest = make_shared<Interest>(nextName);
+      interest->setInterestLifetime(getInterestLifetime());
+
+      m_pendingInterests[seqNo] = m_face.expressInterest(*interest,
                          bind(&NotificationSubscriber<Notification>::afterReceiveData, this, _2),
-                         bind(&NotificationSubscriber<Notification>::afterTimeout, this));
+                         bind(&NotificationSubscriber<Notification>::afterTimeout, this, seqNo));
+    }
+  }
+
+  /** \brief cancel all outstanding Interests and forget buffered Notifications
+   */
+  void
+  cancelPendingInterests()
+  {
+    if (m_initialInterestId != 0)
+      m_face.removePendingInterest(m_initialInterestId);
+    m_initialInterestId = 0;
+
+    for (const auto& pending : m_pendingInterests) {
+      m_face.removePendingInterest(pending.second);
+    }
+    m_pendingInterests.clear();
+    m_receivedNotifications.clear();
+    m_lostSequenceNos.clear();
+    m_lastSequenceNo = std::numeric_limits<uint64_t>::max();
   }
 
   /** \brief Check if the subscriber is or should be stopped.
@@ -203,40 +261,131 @@ private:
     if (this->shouldStop())
       return;
 
+    uint64_t seqNo = 0;
     Notification notification;
     try {
-      m_lastSequenceNo = data.getName().get(-1).toSequenceNumber();
+      seqNo = data.getName().get(-1).toSequenceNumber();
       notification.wireDecode(data.getContent().blockFromValue());
     }
     catch (tlv::Error&) {
       this->onDecodeError(data);
+      this->flushReceivedNotifications();
       this->sendInitialInterest();
       return;
     }
 
-    this->onNotification(notification);
+    if (m_lastSequenceNo == std::numeric_limits<uint64_t>::max()) {
+      // reply to initial Interest
+      m_initialInterestId = 0;
+      m_lastSequenceNo = seqNo;
+      this->onNotification(notification);
+    }
+    else {
+      m_pendingInterests.erase(seqNo);
+      if (seqNo > m_lastSequenceNo) {
+        m_receivedNotifications.insert(std::make_pair(seqNo, notification));
+        this->deliverInOrder();
+      }
+    }
+
+    if (m_isRunning)
+      this->sendNextInterests();
+  }
 
-    this->sendNextInterest();
+  /** \brief deliver buffered Notifications and gaps that directly follow the last delivered one
+   */
+  void
+  deliverInOrder()
+  {
+    while (m_isRunning) {
+      uint64_t nextSeqNo = m_lastSequenceNo + 1;
+
+      auto received = m_receivedNotifications.find(nextSeqNo);
+      if (received != m_receivedNotifications.end()) {
+        Notification notification = received->second;
+        m_receivedNotifications.erase(received);
+        m_lastSequenceNo = nextSeqNo;
+        this->onNotification(notification);
+        continue;
+      }
+
+      auto lost = m_lostSequenceNos.find(nextSeqNo);
+      if (lost != m_lostSequenceNos.end()) {
+        m_lostSequenceNos.erase(lost);
+        m_lastSequenceNo = nextSeqNo;
+        this->onGap(nextSeqNo);
+        continue;
+      }
+
+      break;
+    }
   }
 
+  /** \brief deliver all buffered Notifications, reporting the missing sequence numbers
+   *         before them as gaps
+   *
+   *  This is done before starting over, which forgets the buffered Notifications.
+   */
   void
-  afterTimeout()
+  flushReceivedNotifications()
+  {
+    while (m_isRunning && !m_receivedNotifications.empty()) {
+      uint64_t nextSeqNo = m_lastSequenceNo + 1;
+      if (m_receivedNotifications.count(nextSeqNo) == 0)
+        m_lostSequenceNos.insert(nextSeqNo);
+      this->deliverInOrder();
+    }
+  }
+
+  void
+  afterInitialTimeout()
   {
     if (this->shouldStop())
       return;
 
+    m_initialInterestId = 0;
     this->onTimeout();
 
     this->sendInitialInterest();
   }
 
+  void
+  afterTimeout(uint64_t seqNo)
+  {
+    if (this->shouldStop())
+      return;
+
+    auto pending = m_pendingInterests.find(seqNo);
+    if (pending == m_pendingInterests.end()) // Interest has been canceled
+      return;
+    m_pendingInterests.erase(pending);
+
+    if (m_receivedNotifications.empty() || m_receivedNotifications.rbegin()->first < seqNo) {
+      // nothing newer has been published, start over
+      this->flushReceivedNotifications();
+      this->onTimeout();
+      this->sendInitialInterest();
+      return;
+    }
+
+    m_lostSequenceNos.insert(seqNo);
+    this->deliverInOrder();
+
+    if (m_isRunning)
+      this->sendNextInterests();
+  }
+
 private:
   Face& m_face;
   Name m_prefix;
   bool m_isRunning;
   uint64_t m_lastSequenceNo;
-  const PendingInterestId* m_lastInterestId;
+  const PendingInterestId* m_initialInterestId;
+  std::map<uint64_t, const PendingInterestId*> m_pendingInterests;
+  std::map<uint64_t, Notification> m_receivedNotifications;
+  std::set<uint64_t> m_lostSequenceNos;
   time::milliseconds m_interestLifetime;
+  size_t m_windowSize;
 };
 
 } // namespace util
@@ -24,8 +24,6 @@
 #include "random.hpp"
 
 #include <boost/nondet_random.hpp>
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/uniform_int_distribution.hpp>
 
 #include "../security/cryptopp.hpp"
 
@@ -58,31 +56,103 @@ generateSecureWord64()
   return random;
 }
 
-// Boost.Random-based (simple) random generators
+// xoroshiro128+ (simple) random generators with per-thread state
 
-static boost::random::mt19937&
-getRandomGenerator()
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+#define NDN_CXX_RANDOM_THREAD_LOCAL thread_local
+#else
+#define NDN_CXX_RANDOM_THREAD_LOCAL __thread
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
+
+/** @brief state of xoroshiro128+ generator
+ *
+ *  A trivial type, so that it can be thread-local even where only __thread is available.
+ *  An all-zero state means the generator has not been seeded.
+ */
+struct PseudoRandomState
+{
+  uint64_t s0;
+  uint64_t s1;
+};
+
+static NDN_CXX_RANDOM_THREAD_LOCAL PseudoRandomState g_pseudoRandomState;
+
+static inline uint64_t
+rotateLeft(uint64_t x, int k)
 {
-  static boost::random_device randomSeedGenerator;
-  static boost::random::mt19937 gen(randomSeedGenerator);
+  return (x << k) | (x >> (64 - k));
+}
 
-  return gen;
+static uint64_t
+splitMix64(uint64_t& x)
+{
+  uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+static PseudoRandomState&
+getPseudoRandomState()
+{
+  PseudoRandomState& state = g_pseudoRandomState;
+  if (state.s0 == 0 && state.s1 == 0) {
+    boost::random_device randomSeedGenerator;
+    uint64_t seed = (static_cast<uint64_t>(randomSeedGenerator()) << 32) | randomSeedGenerator();
+    state.s0 = splitMix64(seed);
+    state.s1 = splitMix64(seed);
+    if (state.s0 == 0 && state.s1 == 0) {
+      state.s1 = 1;
+    }
+  }
+  return state;
+}
+
+static inline uint64_t
+nextPseudoRandom(PseudoRandomState& state)
+{
+  uint64_t s0 = state.s0;
+  uint64_t s1 = state.s1;
+  uint64_t result = s0 + s1;
+
+  s1 ^= s0;
+  state.s0 = rotateLeft(s0, 24) ^ s1 ^ (s1 << 16);
+  state.s1 = rotateLeft(s1, 37);
+  return result;
 }
 
 uint32_t
 generateWord32()
 {
-  static boost::random::uniform_int_distribution<uint32_t> distribution;
-  return distribution(getRandomGenerator());
+  // the upper half of xoroshiro128+ output has better statistical quality
+  return static_cast<uint32_t>(nextPseudoRandom(getPseudoRandomState()) >> 32);
 }
 
 uint64_t
 generateWord64()
 {
-  static boost::random::uniform_int_distribution<uint64_t> distribution;
-  return distribution(getRandomGenerator());
+  return nextPseudoRandom(getPseudoRandomState());
 }
 
+void
+generateWords32(uint32_t* words, size_t nWords)
+{
+  PseudoRandomState state = getPseudoRandomState();
+  for (size_t i = 0; i < nWords; ++i) {
+    words[i] = static_cast<uint32_t>(nextPseudoRandom(state) >> 32);
+  }
+  g_pseudoRandomState = state;
+}
+
+void
+generateWords64(uint64_t* words, size_t nWords)
+{
+  PseudoRandomState state = getPseudoRandomState();
+  for (size_t i = 0; i < nWords; ++i) {
+    words[i] = nextPseudoRandom(state);
+  }
+  g_pseudoRandomState = state;
+}
 
 } // namespace random
 } // namespace ndn
@@ -46,7 +46,9 @@ generateSecureWord64();
 /**
  * @brief Generate a cryptographically non-secure random integer from the range [0, 2^32)
  *
- * This method uses Boost.Random routines
+ * This method uses a xoroshiro128+ generator with per-thread state, so it may be called
+ * from multiple threads without synchronization.  Each thread's generator is seeded
+ * from Boost.Random's random_device upon first use.
  *
  * This version is faster than generateSecureWord32, but it should not be used when
  * cryptographically secure random integers are needed (e.g., when creating signing or
@@ -58,7 +60,7 @@ generateWord32();
 /**
  * @brief Generate a cryptographically non-secure random integer from range [0, 2^64)
  *
- * This method uses Boost.Random routines
+ * This method uses the same per-thread generator as generateWord32
  *
  * This version is faster than generateSecureWord64, but it should not be used when
  * cryptographically secure random integers are needed (e.g., when creating signing or
@@ -67,6 +69,24 @@ generateWord32();
 uint64_t
 generateWord64();
 
+/**
+ * @brief Fill an array with cryptographically non-secure random integers from [0, 2^32)
+ *
+ * This is equivalent to calling generateWord32 @p nWords times, but accesses the
+ * per-thread generator only once, e.g., to prepare Nonces for a batch of Interests.
+ */
+void
+generateWords32(uint32_t* words, size_t nWords);
+
+/**
+ * @brief Fill an array with cryptographically non-secure random integers from [0, 2^64)
+ *
+ * This is equivalent to calling generateWord64 @p nWords times, but accesses the
+ * per-thread generator only once.
+ */
+void
+generateWords64(uint64_t* words, size_t nWords);
+
 } // namespace random
 } // namespace ndn
 
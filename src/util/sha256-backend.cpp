@@ -0,0 +1,570 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "sha256-backend.hpp"
+
+#include <cstring>
+
+// the accelerated compressors need per-function target attributes and the SHA intrinsics,
+// which are missing from older compilers (such as gcc 4.8) and from other architectures
+#ifdef NDN_CXX_HAVE_SHA_NI_INTRINSICS
+#define NDN_CXX_SHA256_HAVE_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+// the round loop of SHA-NI must be unrolled to keep the message schedule in registers
+#if defined(__clang__)
+#define NDN_CXX_SHA256_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#define NDN_CXX_SHA256_UNROLL _Pragma("GCC unroll 16")
+#else
+#define NDN_CXX_SHA256_UNROLL
+#endif
+
+namespace ndn {
+namespace crypto {
+namespace detail {
+
+static const uint32_t INITIAL_STATE[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const size_t BLOCK_SIZE = 64;
+
+/**
+ * @brief copy the incomplete last block of a message into @p tail and append the padding
+ * @return number of blocks in @p tail, 1 or 2
+ */
+static size_t
+makeTail(const uint8_t* data, size_t dataLength, uint8_t tail[2 * BLOCK_SIZE])
+{
+  size_t rest = dataLength % BLOCK_SIZE;
+  if (rest > 0)
+    std::memcpy(tail, data + dataLength - rest, rest);
+  tail[rest] = 0x80;
+
+  size_t nBlocks = rest + 1 + 8 <= BLOCK_SIZE ? 1 : 2;
+  size_t end = nBlocks * BLOCK_SIZE;
+  std::memset(tail + rest + 1, 0, end - 8 - rest - 1);
+
+  uint64_t nBits = static_cast<uint64_t>(dataLength) * 8;
+  for (size_t i = 1; i <= 8; ++i) {
+    tail[end - i] = static_cast<uint8_t>(nBits);
+    nBits >>= 8;
+  }
+  return nBlocks;
+}
+
+/// @brief a message as a sequence of blocks: full blocks are read in place, the rest is padded
+struct PaddedMessage
+{
+  explicit
+  PaddedMessage(const uint8_t* data = nullptr, size_t dataLength = 0)
+    : data(data)
+    , nFullBlocks(dataLength / BLOCK_SIZE)
+    , nBlocks(nFullBlocks + makeTail(data, dataLength, tail))
+  {
+  }
+
+  const uint8_t*
+  getBlock(size_t k) const
+  {
+    return k < nFullBlocks ? data + k * BLOCK_SIZE : tail + (k - nFullBlocks) * BLOCK_SIZE;
+  }
+
+  const uint8_t* data;
+  size_t nFullBlocks;
+  uint8_t tail[2 * BLOCK_SIZE];
+  size_t nBlocks;
+};
+
+static inline uint32_t
+loadBigEndian(const uint8_t* p)
+{
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static inline void
+storeBigEndian(const uint32_t state[8], uint8_t* digest)
+{
+  for (size_t i = 0; i < 8; ++i) {
+    digest[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+    digest[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+    digest[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+    digest[4 * i + 3] = static_cast<uint8_t>(state[i]);
+  }
+}
+
+typedef void (*CompressFunction)(uint32_t state[8], const uint8_t* blocks, size_t nBlocks);
+
+static void
+hashWith(CompressFunction compress, const uint8_t* data, size_t dataLength, uint8_t* digest)
+{
+  uint32_t state[8];
+  std::memcpy(state, INITIAL_STATE, sizeof(state));
+
+  compress(state, data, dataLength / BLOCK_SIZE);
+
+  uint8_t tail[2 * BLOCK_SIZE];
+  size_t nTailBlocks = makeTail(data, dataLength, tail);
+  compress(state, tail, nTailBlocks);
+
+  storeBigEndian(state, digest);
+}
+
+static inline uint32_t
+rotr(uint32_t x, int n)
+{
+  return (x >> n) | (x << (32 - n));
+}
+
+static void
+compressGeneric(uint32_t state[8], const uint8_t* blocks, size_t nBlocks)
+{
+  for (; nBlocks > 0; --nBlocks, blocks += BLOCK_SIZE) {
+    uint32_t w[64];
+    for (size_t t = 0; t < 16; ++t) {
+      w[t] = loadBigEndian(blocks + 4 * t);
+    }
+    for (size_t t = 16; t < 64; ++t) {
+      uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+      uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+      w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (size_t t = 0; t < 64; ++t) {
+      uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) +
+                    K[t] + w[t];
+      uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+void
+sha256Generic(const uint8_t* data, size_t dataLength, uint8_t* digest)
+{
+  hashWith(&compressGeneric, data, dataLength, digest);
+}
+
+#ifdef NDN_CXX_SHA256_HAVE_X86
+
+struct CpuFeatures
+{
+  CpuFeatures()
+    : hasShaNi(false)
+    , hasAvx2(false)
+  {
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, nullptr) < 7)
+      return;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    bool hasSsse3 = (ecx & (1u << 9)) != 0;
+    bool hasSse41 = (ecx & (1u << 19)) != 0;
+    bool hasOsxsave = (ecx & (1u << 27)) != 0;
+    bool hasAvx = (ecx & (1u << 28)) != 0;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    hasShaNi = hasSsse3 && hasSse41 && (ebx & (1u << 29)) != 0;
+
+    if (hasOsxsave && hasAvx && (ebx & (1u << 5)) != 0) {
+      // the OS must save the YMM registers on context switches
+      uint32_t xcr0Low, xcr0High;
+      __asm__ (".byte 0x0f, 0x01, 0xd0" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+      hasAvx2 = (xcr0Low & 0x6) == 0x6;
+    }
+  }
+
+  bool hasShaNi;
+  bool hasAvx2;
+};
+
+static const CpuFeatures&
+getCpuFeatures()
+{
+  static const CpuFeatures features;
+  return features;
+}
+
+bool
+hasShaNi()
+{
+  return getCpuFeatures().hasShaNi;
+}
+
+bool
+hasAvx2()
+{
+  return getCpuFeatures().hasAvx2;
+}
+
+/// @brief convert the state to the ABEF and CDGH layout used by the sha256rnds2 instruction
+__attribute__((target("sha,sse4.1")))
+static inline void
+loadShaNiState(const uint32_t state[8], __m128i& abef, __m128i& cdgh)
+{
+  __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+  __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)),
+                                   0x1B);
+  abef = _mm_alignr_epi8(cdab, efgh, 8);
+  cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+}
+
+__attribute__((target("sha,sse4.1")))
+static inline void
+storeShaNiState(__m128i abef, __m128i cdgh, uint32_t state[8])
+{
+  __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+  __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+/**
+ * @brief process one block of each of N independent messages
+ *
+ * sha256rnds2 has a long latency, so interleaving the rounds of two messages keeps
+ * the SHA unit busy while each message waits for the result of its previous round.
+ */
+template<size_t N>
+__attribute__((target("sha,sse4.1")))
+static inline void
+processBlockShaNi(__m128i abef[N], __m128i cdgh[N], const uint8_t* const blocks[N])
+{
+  const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  __m128i savedAbef[N];
+  __m128i savedCdgh[N];
+  // w[n][i % 4] holds words 4i .. 4i+3 of the message schedule of message n
+  __m128i w[N][4];
+  for (size_t n = 0; n < N; ++n) {
+    savedAbef[n] = abef[n];
+    savedCdgh[n] = cdgh[n];
+  }
+
+  NDN_CXX_SHA256_UNROLL
+  for (size_t i = 0; i < 16; ++i) {
+    __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(K) + i);
+    for (size_t n = 0; n < N; ++n) {
+      if (i < 4) {
+        w[n][i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[n]) + i),
+                                   byteSwap);
+      }
+      else {
+        __m128i previous = w[n][(i + 3) % 4];
+        w[n][i % 4] = _mm_sha256msg2_epu32(
+                        _mm_add_epi32(_mm_sha256msg1_epu32(w[n][i % 4], w[n][(i + 1) % 4]),
+                                      _mm_alignr_epi8(previous, w[n][(i + 2) % 4], 4)),
+                        previous);
+      }
+
+      __m128i message = _mm_add_epi32(w[n][i % 4], k);
+      cdgh[n] = _mm_sha256rnds2_epu32(cdgh[n], abef[n], message);
+      abef[n] = _mm_sha256rnds2_epu32(abef[n], cdgh[n], _mm_shuffle_epi32(message, 0x0E));
+    }
+  }
+
+  for (size_t n = 0; n < N; ++n) {
+    abef[n] = _mm_add_epi32(abef[n], savedAbef[n]);
+    cdgh[n] = _mm_add_epi32(cdgh[n], savedCdgh[n]);
+  }
+}
+
+__attribute__((target("sha,sse4.1")))
+static void
+compressShaNi(uint32_t state[8], const uint8_t* blocks, size_t nBlocks)
+{
+  __m128i abef, cdgh;
+  loadShaNiState(state, abef, cdgh);
+  for (; nBlocks > 0; --nBlocks, blocks += BLOCK_SIZE) {
+    processBlockShaNi<1>(&abef, &cdgh, &blocks);
+  }
+  storeShaNiState(abef, cdgh, state);
+}
+
+__attribute__((target("sha,sse4.1")))
+static void
+hashShaNiX2(const uint8_t* const* data, const size_t* dataLength, uint8_t* const* digests)
+{
+  PaddedMessage messages[2] = {PaddedMessage(data[0], dataLength[0]),
+                               PaddedMessage(data[1], dataLength[1])};
+  uint32_t state[2][8];
+  __m128i abef[2], cdgh[2];
+  for (size_t n = 0; n < 2; ++n) {
+    loadShaNiState(INITIAL_STATE, abef[n], cdgh[n]);
+  }
+
+  size_t nCommonBlocks = std::min(messages[0].nBlocks, messages[1].nBlocks);
+  for (size_t k = 0; k < nCommonBlocks; ++k) {
+    const uint8_t* blocks[2] = {messages[0].getBlock(k), messages[1].getBlock(k)};
+    processBlockShaNi<2>(abef, cdgh, blocks);
+  }
+
+  // the longer message is finished alone
+  for (size_t n = 0; n < 2; ++n) {
+    for (size_t k = nCommonBlocks; k < messages[n].nBlocks; ++k) {
+      const uint8_t* block = messages[n].getBlock(k);
+      processBlockShaNi<1>(&abef[n], &cdgh[n], &block);
+    }
+    storeShaNiState(abef[n], cdgh[n], state[n]);
+    storeBigEndian(state[n], digests[n]);
+  }
+}
+
+void
+sha256ShaNi(const uint8_t* data, size_t dataLength, uint8_t* digest)
+{
+  BOOST_ASSERT(hasShaNi());
+  hashWith(&compressShaNi, data, dataLength, digest);
+}
+
+void
+sha256ShaNiX2(const uint8_t* const* data, const size_t* dataLength, uint8_t* const* digests)
+{
+  BOOST_ASSERT(hasShaNi());
+  hashShaNiX2(data, dataLength, digests);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i
+rotr(__m256i x, int n)
+{
+  return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+/**
+ * @brief load word @p t .. t+7 of one block from each of the 8 lanes
+ *
+ * The 8x8 matrix of 32-bit words is transposed so that out[i] holds word t+i of every lane.
+ */
+__attribute__((target("avx2")))
+static inline void
+loadTransposed(const uint8_t* const blocks[8], size_t offset, __m256i out[8])
+{
+  const __m256i byteSwap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                           12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  __m256i r[8];
+  for (size_t j = 0; j < 8; ++j) {
+    r[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[j] + offset));
+  }
+
+  __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+  __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+  __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+  __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+  __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+  __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+  out[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x20), byteSwap);
+  out[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x20), byteSwap);
+  out[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x20), byteSwap);
+  out[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x20), byteSwap);
+  out[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x31), byteSwap);
+  out[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x31), byteSwap);
+  out[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x31), byteSwap);
+  out[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x31), byteSwap);
+}
+
+/**
+ * @brief process one block of each lane
+ * @param isActive lanes with all bits set are updated, the state of other lanes is kept
+ */
+__attribute__((target("avx2")))
+static void
+compressAvx2(__m256i state[8], const uint8_t* const blocks[8], __m256i isActive)
+{
+  __m256i w[64];
+  loadTransposed(blocks, 0, w);
+  loadTransposed(blocks, 32, w + 8);
+  for (size_t t = 16; t < 64; ++t) {
+    __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr(w[t - 15], 7), rotr(w[t - 15], 18)),
+                                  _mm256_srli_epi32(w[t - 15], 3));
+    __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr(w[t - 2], 17), rotr(w[t - 2], 19)),
+                                  _mm256_srli_epi32(w[t - 2], 10));
+    w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+  }
+
+  __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+  __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+  for (size_t t = 0; t < 64; ++t) {
+    __m256i bigSigma1 = _mm256_xor_si256(_mm256_xor_si256(rotr(e, 6), rotr(e, 11)), rotr(e, 25));
+    __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, bigSigma1),
+                                  _mm256_add_epi32(_mm256_add_epi32(ch, w[t]),
+                                                   _mm256_set1_epi32(K[t])));
+    __m256i bigSigma0 = _mm256_xor_si256(_mm256_xor_si256(rotr(a, 2), rotr(a, 13)), rotr(a, 22));
+    __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    __m256i t2 = _mm256_add_epi32(bigSigma0, maj);
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi32(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi32(t1, t2);
+  }
+
+  __m256i result[8] = {a, b, c, d, e, f, g, h};
+  for (size_t i = 0; i < 8; ++i) {
+    state[i] = _mm256_blendv_epi8(state[i], _mm256_add_epi32(state[i], result[i]), isActive);
+  }
+}
+
+__attribute__((target("avx2")))
+static void
+hashAvx2(size_t nBuffers, const uint8_t* const* data, const size_t* dataLength,
+         uint8_t* const* digests)
+{
+  // unused lanes hash an empty message whose result is discarded
+  PaddedMessage messages[8];
+  size_t maxBlocks = 0;
+  for (size_t j = 0; j < nBuffers; ++j) {
+    messages[j] = PaddedMessage(data[j], dataLength[j]);
+    maxBlocks = std::max(maxBlocks, messages[j].nBlocks);
+  }
+
+  __m256i state[8];
+  for (size_t i = 0; i < 8; ++i) {
+    state[i] = _mm256_set1_epi32(INITIAL_STATE[i]);
+  }
+
+  for (size_t k = 0; k < maxBlocks; ++k) {
+    const uint8_t* blocks[8];
+    uint32_t isActive[8];
+    for (size_t j = 0; j < 8; ++j) {
+      bool hasBlock = k < messages[j].nBlocks;
+      blocks[j] = messages[j].getBlock(hasBlock ? k : 0);
+      isActive[j] = hasBlock ? 0xFFFFFFFF : 0;
+    }
+    compressAvx2(state, blocks, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(isActive)));
+  }
+
+  uint32_t words[8][8]; // [word][lane]
+  for (size_t i = 0; i < 8; ++i) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[i]), state[i]);
+  }
+  for (size_t j = 0; j < nBuffers; ++j) {
+    uint32_t laneState[8];
+    for (size_t i = 0; i < 8; ++i) {
+      laneState[i] = words[i][j];
+    }
+    storeBigEndian(laneState, digests[j]);
+  }
+}
+
+void
+sha256Avx2(size_t nBuffers, const uint8_t* const* data, const size_t* dataLength,
+           uint8_t* const* digests)
+{
+  BOOST_ASSERT(hasAvx2());
+  BOOST_ASSERT(nBuffers <= SHA256_AVX2_LANES);
+  hashAvx2(nBuffers, data, dataLength, digests);
+}
+
+#else // NDN_CXX_SHA256_HAVE_X86
+
+bool
+hasShaNi()
+{
+  return false;
+}
+
+void
+sha256ShaNi(const uint8_t* data, size_t dataLength, uint8_t* digest)
+{
+  BOOST_ASSERT(false);
+  sha256Generic(data, dataLength, digest);
+}
+
+void
+sha256ShaNiX2(const uint8_t* const* data, const size_t* dataLength, uint8_t* const* digests)
+{
+  BOOST_ASSERT(false);
+  for (size_t n = 0; n < 2; ++n) {
+    sha256Generic(data[n], dataLength[n], digests[n]);
+  }
+}
+
+bool
+hasAvx2()
+{
+  return false;
+}
+
+void
+sha256Avx2(size_t nBuffers, const uint8_t* const* data, const size_t* dataLength,
+           uint8_t* const* digests)
+{
+  BOOST_ASSERT(false);
+  for (size_t j = 0; j < nBuffers; ++j) {
+    sha256Generic(data[j], dataLength[j], digests[j]);
+  }
+}
+
+#endif // NDN_CXX_SHA256_HAVE_X86
+
+} // namespace detail
+} // namespace crypto
+} // namespace ndn
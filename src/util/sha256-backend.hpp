@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_SHA256_BACKEND_HPP
+#define NDN_UTIL_SHA256_BACKEND_HPP
+
+#include "../common.hpp"
+
+namespace ndn {
+namespace crypto {
+namespace detail {
+
+/**
+ * @brief SHA-256 implementations used by crypto::sha256
+ *
+ * crypto::sha256 picks the fastest implementation supported by the CPU at runtime.
+ * The individual implementations are exposed so that they can be tested and benchmarked
+ * against each other; applications should use the functions in crypto.hpp.
+ */
+
+/// @brief portable implementation
+void
+sha256Generic(const uint8_t* data, size_t dataLength, uint8_t* digest);
+
+/// @brief whether the CPU supports the SHA extensions (SHA-NI)
+bool
+hasShaNi();
+
+/**
+ * @brief implementation using the SHA extensions
+ * @pre hasShaNi()
+ */
+void
+sha256ShaNi(const uint8_t* data, size_t dataLength, uint8_t* digest);
+
+/**
+ * @brief hash two buffers with interleaved SHA-NI instructions
+ * @pre hasShaNi()
+ */
+void
+sha256ShaNiX2(const uint8_t* const* data, const size_t* dataLength, uint8_t* const* digests);
+
+/// @brief whether the CPU and the OS support AVX2
+bool
+hasAvx2();
+
+/// @brief number of buffers hashed in parallel by sha256Avx2
+static const size_t SHA256_AVX2_LANES = 8;
+
+/**
+ * @brief hash up to SHA256_AVX2_LANES buffers in parallel, one buffer per 32-bit lane
+ *        of the AVX2 registers
+ * @pre hasAvx2() && nBuffers <= SHA256_AVX2_LANES
+ *
+ * The blocks of all buffers are processed in lockstep, so this is most efficient when
+ * the buffers have similar sizes.
+ */
+void
+sha256Avx2(size_t nBuffers, const uint8_t* const* data, const size_t* dataLength,
+           uint8_t* const* digests);
+
+} // namespace detail
+} // namespace crypto
+} // namespace ndn
+
+#endif // NDN_UTIL_SHA256_BACKEND_HPP
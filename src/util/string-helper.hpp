@@ -97,6 +97,19 @@ trim(std::string& str)
   trimRight(str);
 }
 
+/**
+ * @brief Move begin forward and end backward past whitespace, without copying the string
+ */
+inline void
+trim(const char*& begin, const char*& end)
+{
+  auto isWhitespace = [] (char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+  while (begin != end && isWhitespace(*begin))
+    ++begin;
+  while (end != begin && isWhitespace(*(end - 1)))
+    --end;
+}
+
 /**
  * @brief Convert the hex character to an integer from 0 to 15, or -1 if not a hex character
  */
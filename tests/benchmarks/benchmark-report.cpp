@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "benchmark-report.hpp"
+#include "version.hpp"
+
+#include "boost-test.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+BenchmarkReport&
+BenchmarkReport::getInstance()
+{
+  static BenchmarkReport instance;
+  return instance;
+}
+
+void
+BenchmarkReport::addResult(Result& result)
+{
+  using boost::unit_test::framework::current_test_case;
+  using boost::unit_test::framework::get;
+  using boost::unit_test::test_suite;
+
+  const boost::unit_test::test_case& testCase = current_test_case();
+  result.suite = get<test_suite>(testCase.p_parent_id).p_name;
+  result.testCase = testCase.p_name;
+  m_results.push_back(result);
+}
+
+void
+BenchmarkReport::add(const std::string& operation, const time::nanoseconds& duration,
+                     size_t nIterations, const std::string& unit, size_t nOctets)
+{
+  Result result;
+  result.operation = operation;
+  result.unit = unit;
+  result.nIterations = nIterations;
+  result.duration = duration;
+  result.nOctets = nOctets;
+  result.ratio = -1;
+  addResult(result);
+
+  std::cout << operation << ": " << duration.count() / nIterations << " ns/" << unit;
+  if (nOctets > 0) {
+    std::cout << ", " << nOctets / (duration.count() / 1e9) / 1e6 << " MB/s";
+  }
+  std::cout << std::endl;
+}
+
+void
+BenchmarkReport::addRatio(const std::string& operation, size_t nHits, size_t nIterations,
+                          const std::string& unit)
+{
+  Result result;
+  result.operation = operation;
+  result.unit = unit;
+  result.nIterations = nIterations;
+  result.duration = time::nanoseconds::zero();
+  result.nOctets = 0;
+  result.ratio = static_cast<double>(nHits) / nIterations;
+  addResult(result);
+
+  std::cout << operation << ": " << result.ratio * 100 << "% of " << nIterations << " "
+            << unit << "s" << std::endl;
+}
+
+static void
+writeJsonString(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+             << static_cast<int>(c) << std::dec;
+        }
+        else {
+          os << c;
+        }
+        break;
+    }
+  }
+  os << '"';
+}
+
+void
+BenchmarkReport::writeJson(std::ostream& os) const
+{
+  os << "{\n"
+     << "  \"version\": ";
+  writeJsonString(os, NDN_CXX_VERSION_BUILD_STRING);
+  os << ",\n"
+     << "  \"timestamp\": " << time::toUnixTimestamp(time::system_clock::now()).count() << ",\n"
+     << "  \"results\": [";
+
+  for (auto it = m_results.begin(); it != m_results.end(); ++it) {
+    os << (it == m_results.begin() ? "\n" : ",\n")
+       << "    {\"suite\": ";
+    writeJsonString(os, it->suite);
+    os << ", \"case\": ";
+    writeJsonString(os, it->testCase);
+    os << ", \"operation\": ";
+    writeJsonString(os, it->operation);
+    os << ", \"unit\": ";
+    writeJsonString(os, it->unit);
+    os << ", \"iterations\": " << it->nIterations;
+    if (it->ratio >= 0) {
+      os << ", \"ratio\": " << it->ratio << "}";
+      continue;
+    }
+    os << ", \"totalNs\": " << it->duration.count()
+       << ", \"nsPerUnit\": " << static_cast<double>(it->duration.count()) / it->nIterations;
+    if (it->nOctets > 0) {
+      os << ", \"octets\": " << it->nOctets
+         << ", \"octetsPerSecond\": " << it->nOctets / (it->duration.count() / 1e9);
+    }
+    os << "}";
+  }
+
+  os << "\n  ]\n"
+     << "}\n";
+}
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TESTS_BENCHMARKS_BENCHMARK_REPORT_HPP
+#define NDN_TESTS_BENCHMARKS_BENCHMARK_REPORT_HPP
+
+#include "common.hpp"
+#include "util/time.hpp"
+
+#include <vector>
+
+namespace ndn {
+namespace tests {
+
+/** \brief collects the results of all benchmarks and writes them as a JSON document
+ *
+ *  Every result is also printed to stdout in a human-readable form as it is added.
+ *  The JSON document is written by the benchmarks program when all test cases are finished,
+ *  see tests/benchmarks/main.cpp.
+ */
+class BenchmarkReport : noncopyable
+{
+public:
+  static BenchmarkReport&
+  getInstance();
+
+  /** \brief record that \p nIterations iterations of \p operation took \p duration
+   *  \param unit what is processed by one iteration, e.g. "op" or "packet"
+   *  \param nOctets total number of octets processed by all iterations, used to report
+   *                 throughput; 0 if throughput is not meaningful for \p operation
+   *
+   *  The result is attributed to the currently running test case.
+   */
+  void
+  add(const std::string& operation, const time::nanoseconds& duration, size_t nIterations,
+      const std::string& unit = "op", size_t nOctets = 0);
+
+  /** \brief record that \p nHits out of \p nIterations iterations of \p operation succeeded,
+   *         e.g. the hit ratio of a cache over a request trace
+   */
+  void
+  addRatio(const std::string& operation, size_t nHits, size_t nIterations,
+           const std::string& unit = "op");
+
+  void
+  writeJson(std::ostream& os) const;
+
+private:
+  BenchmarkReport() = default;
+
+  struct Result;
+
+  void
+  addResult(Result& result);
+
+private:
+  struct Result
+  {
+    std::string suite;
+    std::string testCase;
+    std::string operation;
+    std::string unit;
+    size_t nIterations;
+    time::nanoseconds duration;
+    size_t nOctets;
+    double ratio; ///< negative if the result is a duration
+  };
+
+  std::vector<Result> m_results;
+};
+
+} // namespace tests
+} // namespace ndn
+
+#endif // NDN_TESTS_BENCHMARKS_BENCHMARK_REPORT_HPP
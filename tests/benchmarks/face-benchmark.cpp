@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/dummy-client-face.hpp"
+#include "util/load-generator.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+using util::DummyClientFace;
+using util::LoadGenerator;
+using util::makeDummyClientFace;
+
+BOOST_AUTO_TEST_SUITE(FaceBenchmark)
+
+/** \brief Interest/Data exchange between a consumer and a producer through two linked
+ *         DummyClientFaces, including Face processing on both ends
+ */
+BOOST_AUTO_TEST_CASE(Loopback)
+{
+  for (double rate : {10000.0, 100000.0}) {
+    boost::asio::io_service io;
+    shared_ptr<DummyClientFace> consumerFace = makeDummyClientFace(io, {false, false});
+    shared_ptr<DummyClientFace> producerFace = makeDummyClientFace(io, {false, false});
+    consumerFace->linkTo(*producerFace);
+
+    LoadGenerator::Options options = LoadGenerator::DEFAULT_OPTIONS;
+    options.interestRate = rate;
+    options.nInterests = static_cast<uint64_t>(rate); // one second
+    options.contentSize = 1024;
+    LoadGenerator generator(options);
+    generator.startProducer(*producerFace);
+
+    time::nanoseconds duration = timedExecute([&] {
+      generator.startConsumer(*consumerFace, [&io] { io.stop(); });
+      io.run();
+    });
+    BOOST_CHECK_EQUAL(generator.getNReceivedData(), options.nInterests);
+
+    std::string operation = "Interest/Data exchange at " +
+                            std::to_string(static_cast<int>(rate)) + " Interests/s";
+    BenchmarkReport::getInstance().add(operation, duration, options.nInterests, "exchange");
+    std::cout << "  latency: " << generator.getLatencies() << std::endl;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
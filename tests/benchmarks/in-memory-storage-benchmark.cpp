@@ -0,0 +1,319 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-persistent.hpp"
+#include "util/in-memory-storage-fifo.hpp"
+#include "util/in-memory-storage-lfu.hpp"
+#include "util/in-memory-storage-lru.hpp"
+#include "util/in-memory-storage-arc.hpp"
+#include "util/in-memory-storage-sharded.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/mpl/list.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+using namespace ndn::util;
+
+static const size_t N_PACKETS = 50000;
+
+/** \brief how to name and construct an InMemoryStorage with a given replacement policy
+ */
+template<typename Storage>
+struct StorageTraits
+{
+  static unique_ptr<InMemoryStorage>
+  create(size_t limit)
+  {
+    return unique_ptr<InMemoryStorage>(new Storage(limit));
+  }
+};
+
+template<>
+struct StorageTraits<InMemoryStoragePersistent>
+{
+  static unique_ptr<InMemoryStorage>
+  create(size_t)
+  {
+    // persistent storage never evicts, so the limit does not apply
+    return unique_ptr<InMemoryStorage>(new InMemoryStoragePersistent());
+  }
+};
+
+static std::string
+getPolicyName(const InMemoryStoragePersistent*)
+{
+  return "Persistent";
+}
+
+static std::string
+getPolicyName(const InMemoryStorageFifo*)
+{
+  return "Fifo";
+}
+
+static std::string
+getPolicyName(const InMemoryStorageLfu*)
+{
+  return "Lfu";
+}
+
+static std::string
+getPolicyName(const InMemoryStorageLru*)
+{
+  return "Lru";
+}
+
+static std::string
+getPolicyName(const InMemoryStorageArc*)
+{
+  return "Arc";
+}
+
+class InMemoryStorageFixture
+{
+public:
+  InMemoryStorageFixture()
+  {
+    SignatureSha256WithRsa signature(KeyLocator(Name("/ndn/KEY/ksk-1/ID-CERT")));
+    std::vector<uint8_t> signatureValue(256, 0xAB);
+    signature.setValue(dataBlock(tlv::SignatureValue, &signatureValue[0], signatureValue.size()));
+    std::vector<uint8_t> content(1024, 0xCD);
+
+    packets.reserve(N_PACKETS);
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      Name name("/ndn/edu/ucla/cs/irl/benchmark");
+      name.appendNumber(i % 100).appendSegment(i);
+      shared_ptr<Data> data = make_shared<Data>(name);
+      data->setFreshnessPeriod(time::seconds(10));
+      data->setContent(&content[0], content.size());
+      data->setSignature(signature);
+      data->wireEncode();
+      packets.push_back(data);
+    }
+  }
+
+  template<typename Storage>
+  void
+  report(const std::string& operation, const time::nanoseconds& duration)
+  {
+    std::string name = "InMemoryStorage" + getPolicyName(static_cast<Storage*>(nullptr)) +
+                       "::" + operation;
+    BenchmarkReport::getInstance().add(name, duration, N_PACKETS, "packet");
+  }
+
+public:
+  std::vector<shared_ptr<Data>> packets;
+};
+
+typedef boost::mpl::list<InMemoryStoragePersistent, InMemoryStorageFifo, InMemoryStorageLfu,
+                         InMemoryStorageLru, InMemoryStorageArc> InMemoryStorages;
+
+typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru,
+                         InMemoryStorageArc> EvictingInMemoryStorages;
+
+static const size_t TRACE_CACHE_SIZE = 1000;
+static const size_t TRACE_N_HOT = 2000;
+static const size_t TRACE_LENGTH = 200000;
+static const size_t TRACE_SCAN_INTERVAL = 20000;
+static const size_t TRACE_SCAN_LENGTH = 5000;
+
+/** \brief a request trace of a cache in front of a producer: requests for a working set
+ *         with Zipf-distributed popularity, interrupted by sequential bulk transfers of
+ *         packets that are requested only once
+ *
+ *  Packets [0, TRACE_N_HOT) form the working set; the others belong to the bulk transfers.
+ */
+static std::vector<size_t>
+makeTrace()
+{
+  std::vector<double> cdf(TRACE_N_HOT);
+  double sum = 0;
+  for (size_t rank = 0; rank < TRACE_N_HOT; ++rank) {
+    sum += 1.0 / std::pow(rank + 1, 0.9);
+    cdf[rank] = sum;
+  }
+
+  std::mt19937 rng(2015);
+  std::uniform_real_distribution<double> uniform(0, sum);
+  std::vector<size_t> trace;
+  trace.reserve(TRACE_LENGTH);
+  size_t nextBulk = TRACE_N_HOT;
+  while (trace.size() < TRACE_LENGTH) {
+    if (trace.size() % TRACE_SCAN_INTERVAL == TRACE_SCAN_INTERVAL / 2) {
+      for (size_t i = 0; i < TRACE_SCAN_LENGTH; ++i) {
+        trace.push_back(nextBulk++);
+      }
+    }
+    trace.push_back(std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+  }
+  return trace;
+}
+
+BOOST_FIXTURE_TEST_SUITE(InMemoryStorageBenchmark, InMemoryStorageFixture)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Insert, Storage, InMemoryStorages)
+{
+  // half of the insertions evict another packet, except with the persistent policy
+  unique_ptr<InMemoryStorage> storage = StorageTraits<Storage>::create(N_PACKETS / 2);
+  report<Storage>("insert", timedExecute([&] {
+    for (const shared_ptr<Data>& data : packets) {
+      storage->insert(*data);
+    }
+  }));
+  BOOST_CHECK_GE(storage->size(), N_PACKETS / 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Find, Storage, InMemoryStorages)
+{
+  unique_ptr<InMemoryStorage> storage = StorageTraits<Storage>::create(N_PACKETS);
+  for (const shared_ptr<Data>& data : packets) {
+    storage->insert(*data);
+  }
+  BOOST_REQUIRE_EQUAL(storage->size(), N_PACKETS);
+
+  size_t nFound = 0;
+  report<Storage>("find(Name)", timedExecute([&] {
+    for (const shared_ptr<Data>& data : packets) {
+      nFound += storage->find(data->getName()) != nullptr;
+    }
+  }));
+  BOOST_CHECK_EQUAL(nFound, N_PACKETS);
+
+  std::vector<Interest> interests;
+  interests.reserve(N_PACKETS);
+  for (const shared_ptr<Data>& data : packets) {
+    interests.push_back(Interest(data->getName()));
+  }
+
+  nFound = 0;
+  report<Storage>("find(Interest)", timedExecute([&] {
+    for (const Interest& interest : interests) {
+      nFound += storage->find(interest) != nullptr;
+    }
+  }));
+  BOOST_CHECK_EQUAL(nFound, N_PACKETS);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(HitRatio, Storage, EvictingInMemoryStorages)
+{
+  std::vector<size_t> trace = makeTrace();
+  size_t nPackets = *std::max_element(trace.begin(), trace.end()) + 1;
+
+  std::vector<shared_ptr<Data>> tracePackets(nPackets);
+  for (size_t i = 0; i < nPackets; ++i) {
+    tracePackets[i] = make_shared<Data>(Name("/trace").appendNumber(i));
+    tracePackets[i]->setSignature(packets[0]->getSignature());
+    tracePackets[i]->wireEncode();
+  }
+
+  // a miss is served by the producer and inserted
+  unique_ptr<InMemoryStorage> storage = StorageTraits<Storage>::create(TRACE_CACHE_SIZE);
+  size_t nHits = 0;
+  time::nanoseconds duration = timedExecute([&] {
+    for (size_t i : trace) {
+      if (storage->find(tracePackets[i]->getName()) != nullptr)
+        ++nHits;
+      else
+        storage->insert(*tracePackets[i]);
+    }
+  });
+
+  std::string name = "InMemoryStorage" + getPolicyName(static_cast<Storage*>(nullptr));
+  BenchmarkReport::getInstance().addRatio(name + "::hit ratio", nHits, trace.size(), "request");
+  BenchmarkReport::getInstance().add(name + "::find+insert", duration, trace.size(), "request");
+}
+
+static const size_t N_THREADS = 4;
+
+/** \brief each thread inserts its share of the packets and looks every one of them up,
+ *         as producers that sign Data on worker threads and serve them at the same time
+ */
+template<typename InsertFind>
+static time::nanoseconds
+measureConcurrent(const std::vector<shared_ptr<Data>>& packets, const InsertFind& insertFind)
+{
+  std::vector<std::vector<Interest>> interests(N_THREADS);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    interests[i % N_THREADS].push_back(Interest(packets[i]->getName()));
+  }
+
+  return timedExecute([&] {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < N_THREADS; ++t) {
+      threads.push_back(std::thread([&, t] {
+        for (size_t i = t; i < packets.size(); i += N_THREADS) {
+          insertFind(*packets[i], interests[t][i / N_THREADS]);
+        }
+      }));
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(Concurrent)
+{
+  for (const shared_ptr<Data>& data : packets) {
+    data->getFullName();
+  }
+
+  // InMemoryStorageLru serialized by one mutex
+  InMemoryStorageLru lru(N_PACKETS / 2);
+  std::mutex mutex;
+  size_t nFound = 0;
+  BenchmarkReport::getInstance().add("InMemoryStorageLru+mutex::insert+find (" +
+                                     std::to_string(N_THREADS) + " threads)",
+    measureConcurrent(packets, [&] (const Data& data, const Interest& interest) {
+      std::lock_guard<std::mutex> lock(mutex);
+      lru.insert(data);
+      nFound += lru.find(interest) != nullptr;
+    }), N_PACKETS, "packet");
+  BOOST_CHECK_EQUAL(nFound, N_PACKETS);
+
+  // the components before appendNumber choose the shard
+  InMemoryStorageSharded sharded(7, N_PACKETS / 2);
+  std::atomic<size_t> nFoundSharded(0);
+  BenchmarkReport::getInstance().add("InMemoryStorageSharded::insert+find (" +
+                                     std::to_string(N_THREADS) + " threads)",
+    measureConcurrent(packets, [&] (const Data& data, const Interest& interest) {
+      sharded.insert(data);
+      nFoundSharded += sharded.find(interest) != nullptr;
+    }), N_PACKETS, "packet");
+  BOOST_CHECK_EQUAL(nFoundSharded, N_PACKETS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Benchmarks
+
+#include "benchmark-report.hpp"
+
+#include "boost-test.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+/** \brief writes the JSON report after all benchmarks have finished
+ *
+ *  The report is written to the file named by the NDN_CXX_BENCHMARK_REPORT environment
+ *  variable, or to "benchmarks.json" in the current directory if the variable is not set.
+ */
+class BenchmarkReportWriter
+{
+public:
+  ~BenchmarkReportWriter()
+  {
+    const char* path = std::getenv("NDN_CXX_BENCHMARK_REPORT");
+    if (path == nullptr)
+      path = "benchmarks.json";
+
+    std::ofstream os(path);
+    BenchmarkReport::getInstance().writeJson(os);
+    if (!os)
+      std::cerr << "Cannot write benchmark report to " << path << std::endl;
+    else
+      std::cout << "Benchmark report written to " << path << std::endl;
+  }
+};
+
+BOOST_GLOBAL_FIXTURE(BenchmarkReportWriter);
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+namespace ndn {
+namespace tests {
+
+static const int N_ITERATIONS = 100000;
+
+static void
+report(const std::string& operation, const time::nanoseconds& duration)
+{
+  BenchmarkReport::getInstance().add(operation, duration, N_ITERATIONS);
+}
+
+static Name
+makeName(int i)
+{
+  Name name("/ndn/edu/ucla/cs/irl/benchmark");
+  name.appendVersion(i).appendSegment(i);
+  return name;
+}
+
+BOOST_AUTO_TEST_SUITE(NameBenchmark)
+
+BOOST_AUTO_TEST_CASE(Build)
+{
+  size_t nOctets = 0;
+  report("Name::append + wireEncode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nOctets += makeName(i).wireEncode().size();
+    }
+  }));
+  BOOST_CHECK_GT(nOctets, 0);
+
+  Block wire = makeName(0).wireEncode();
+  size_t nComponents = 0;
+  report("Name::wireDecode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nComponents += Name(wire).size();
+    }
+  }));
+  BOOST_CHECK_EQUAL(nComponents, N_ITERATIONS * 8);
+}
+
+BOOST_AUTO_TEST_CASE(Prefix)
+{
+  Name name = makeName(0);
+  name.wireEncode();
+
+  size_t nOctets = 0;
+  report("Name::getPrefix + wireEncode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nOctets += name.getPrefix(-1 - i % 4).wireEncode().size();
+    }
+  }));
+  BOOST_CHECK_GT(nOctets, 0);
+
+  Name suffix("/suffix/component");
+  report("Name::append(Name) + wireEncode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nOctets += Name(name).append(suffix).wireEncode().size();
+    }
+  }));
+}
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  Name name1 = makeName(1);
+  Name name2 = makeName(1);
+  Name name3 = makeName(2);
+  Name prefix = name1.getPrefix(6);
+  name1.wireEncode();
+  name2.wireEncode();
+  name3.wireEncode();
+
+  int nMatches = 0;
+  report("Name::equals", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nMatches += name1 == name2;
+    }
+  }));
+  BOOST_CHECK_EQUAL(nMatches, N_ITERATIONS);
+
+  nMatches = 0;
+  report("Name::isPrefixOf", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nMatches += prefix.isPrefixOf(name3);
+    }
+  }));
+  BOOST_CHECK_EQUAL(nMatches, N_ITERATIONS);
+
+  nMatches = 0;
+  report("Name::compare", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nMatches += name1.compare(name3) < 0;
+    }
+  }));
+  BOOST_CHECK_EQUAL(nMatches, N_ITERATIONS);
+}
+
+BOOST_AUTO_TEST_CASE(Uri)
+{
+  Name name = makeName(0);
+  std::string uri = name.toUri();
+
+  size_t nOctets = 0;
+  report("Name::toUri", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nOctets += name.toUri().size();
+    }
+  }));
+  BOOST_CHECK_EQUAL(nOctets, N_ITERATIONS * uri.size());
+
+  nOctets = 0;
+  char buffer[256];
+  report("Name::toUri(char*, size_t)", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nOctets += name.toUri(buffer, sizeof(buffer));
+    }
+  }));
+  BOOST_CHECK_EQUAL(nOctets, N_ITERATIONS * uri.size());
+
+  size_t nComponents = 0;
+  report("Name(uri)", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nComponents += Name(uri).size();
+    }
+  }));
+  BOOST_CHECK_EQUAL(nComponents, N_ITERATIONS * name.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "interest.hpp"
+#include "data.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+#include <unordered_map>
+
+namespace ndn {
+namespace tests {
+
+static const int N_ITERATIONS = 100000;
+
+static void
+report(const std::string& operation, const time::nanoseconds& duration)
+{
+  BenchmarkReport::getInstance().add(operation, duration, N_ITERATIONS, "packet");
+}
+
+class PacketDecodeFixture
+{
+public:
+  PacketDecodeFixture()
+    : prefix("/ndn/edu/ucla/cs/irl")
+  {
+    Interest interest(Name(prefix).append("benchmark").appendSegment(42));
+    interest.setMustBeFresh(true);
+    interest.setMaxSuffixComponents(2);
+    Exclude exclude;
+    exclude.excludeBefore(name::Component("aaaa")).excludeAfter(name::Component("zzzz"));
+    interest.setExclude(exclude);
+    interest.setPublisherPublicKeyLocator(KeyLocator(Name("/ndn/KEY/ksk-1/ID-CERT")));
+    interestWire = interest.wireEncode();
+
+    Data data(interest.getName());
+    data.setFreshnessPeriod(time::seconds(10));
+    data.setContent(reinterpret_cast<const uint8_t*>("benchmark content"), 17);
+    SignatureSha256WithRsa signature(KeyLocator(Name("/ndn/KEY/ksk-1/ID-CERT")));
+    signature.setValue(dataBlock(tlv::SignatureValue, reinterpret_cast<const uint8_t*>("sig"), 3));
+    data.setSignature(signature);
+    dataWire = data.wireEncode();
+
+    filters[prefix] = 1;
+  }
+
+  /** \brief dispatch by longest prefix match on the Name only, as Face does for most packets
+   */
+  int
+  dispatch(const Name& name)
+  {
+    for (size_t len = name.size(); len > 0; --len) {
+      auto it = filters.find(name.getPrefix(len));
+      if (it != filters.end())
+        return it->second;
+    }
+    return 0;
+  }
+
+public:
+  Name prefix;
+  Block interestWire;
+  Block dataWire;
+  std::unordered_map<Name, int> filters;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PacketDecodeBenchmark, PacketDecodeFixture)
+
+BOOST_AUTO_TEST_CASE(InterestDispatch)
+{
+  int nDispatched = 0;
+  report("Interest::wireDecode + dispatch", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Interest interest;
+      interest.wireDecode(interestWire);
+      nDispatched += dispatch(interest.getName());
+    }
+  }));
+  BOOST_CHECK_EQUAL(nDispatched, N_ITERATIONS);
+
+  nDispatched = 0;
+  report("Interest::lazyWireDecode + dispatch", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Interest interest;
+      interest.lazyWireDecode(interestWire);
+      nDispatched += dispatch(interest.getName());
+    }
+  }));
+  BOOST_CHECK_EQUAL(nDispatched, N_ITERATIONS);
+}
+
+BOOST_AUTO_TEST_CASE(DataDispatch)
+{
+  int nDispatched = 0;
+  report("Data::wireDecode + dispatch", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Data data;
+      data.wireDecode(dataWire);
+      nDispatched += dispatch(data.getName());
+    }
+  }));
+  BOOST_CHECK_EQUAL(nDispatched, N_ITERATIONS);
+
+  nDispatched = 0;
+  report("Data::lazyWireDecode + dispatch", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Data data;
+      data.lazyWireDecode(dataWire);
+      nDispatched += dispatch(data.getName());
+    }
+  }));
+  BOOST_CHECK_EQUAL(nDispatched, N_ITERATIONS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "interest.hpp"
+#include "data.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+namespace ndn {
+namespace tests {
+
+static const int N_ITERATIONS = 100000;
+
+static void
+report(const std::string& operation, const time::nanoseconds& duration)
+{
+  BenchmarkReport::getInstance().add(operation, duration, N_ITERATIONS, "packet");
+}
+
+class PacketEncodeFixture
+{
+public:
+  PacketEncodeFixture()
+    : interest(Name("/ndn/edu/ucla/cs/irl/benchmark").appendSegment(42))
+    , data(interest.getName())
+  {
+    interest.setMustBeFresh(true);
+    interest.setMaxSuffixComponents(2);
+    Exclude exclude;
+    exclude.excludeBefore(name::Component("aaaa")).excludeAfter(name::Component("zzzz"));
+    interest.setExclude(exclude);
+    interest.setNonce(1);
+
+    data.setFreshnessPeriod(time::seconds(10));
+    SignatureSha256WithRsa signature(KeyLocator(Name("/ndn/KEY/ksk-1/ID-CERT")));
+    std::vector<uint8_t> signatureValue(256, 0xAB);
+    signature.setValue(dataBlock(tlv::SignatureValue, &signatureValue[0], signatureValue.size()));
+    data.setSignature(signature);
+  }
+
+public:
+  Interest interest;
+  Data data;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PacketEncodeBenchmark, PacketEncodeFixture)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  // changing InterestLifetime discards the cached wire encoding, but not the encodings
+  // of Name and Selectors
+  size_t nOctets = 0;
+  report("Interest::wireEncode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      interest.setInterestLifetime(time::milliseconds(1000 + i % 2));
+      nOctets += interest.wireEncode().size();
+    }
+  }));
+  BOOST_CHECK_GT(nOctets, 0);
+
+  std::vector<uint8_t> content(1024, 0xCD);
+  nOctets = 0;
+  report("Data::setContent + wireEncode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      data.setContent(&content[0], content.size());
+      nOctets += data.wireEncode().size();
+    }
+  }));
+  BOOST_CHECK_GT(nOctets, N_ITERATIONS * content.size());
+}
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  Block interestWire = interest.wireEncode();
+  size_t nComponents = 0;
+  report("Interest::wireDecode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nComponents += Interest(interestWire).getName().size();
+    }
+  }));
+  BOOST_CHECK_EQUAL(nComponents, N_ITERATIONS * interest.getName().size());
+
+  std::vector<uint8_t> content(1024, 0xCD);
+  data.setContent(&content[0], content.size());
+  Block dataWire = data.wireEncode();
+  size_t nOctets = 0;
+  report("Data::wireDecode", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nOctets += Data(dataWire).getContent().value_size();
+    }
+  }));
+  BOOST_CHECK_EQUAL(nOctets, N_ITERATIONS * content.size());
+}
+
+BOOST_AUTO_TEST_CASE(MatchesData)
+{
+  data.wireEncode();
+
+  int nMatches = 0;
+  Interest prefixInterest(interest.getName().getPrefix(-1));
+  report("Interest::matchesData (prefix)", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nMatches += prefixInterest.matchesData(data);
+    }
+  }));
+  BOOST_CHECK_EQUAL(nMatches, N_ITERATIONS);
+
+  Interest selectorsInterest(prefixInterest);
+  selectorsInterest.setMustBeFresh(true);
+  selectorsInterest.setMinSuffixComponents(1);
+  selectorsInterest.setMaxSuffixComponents(2);
+  Exclude exclude;
+  exclude.excludeOne(name::Component("excluded"));
+  selectorsInterest.setExclude(exclude);
+
+  nMatches = 0;
+  report("Interest::matchesData (selectors)", timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      nMatches += selectorsInterest.matchesData(data);
+    }
+  }));
+  BOOST_CHECK_EQUAL(nMatches, N_ITERATIONS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
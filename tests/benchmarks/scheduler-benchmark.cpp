@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/scheduler.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace tests {
+
+using util::scheduler::Scheduler;
+using util::scheduler::EventId;
+
+static const size_t N_EVENTS = 100000;
+
+static void
+report(const std::string& operation, const time::nanoseconds& duration)
+{
+  BenchmarkReport::getInstance().add(operation, duration, N_EVENTS, "event");
+}
+
+BOOST_AUTO_TEST_SUITE(SchedulerBenchmark)
+
+BOOST_AUTO_TEST_CASE(ScheduleCancel)
+{
+  boost::asio::io_service io;
+  Scheduler scheduler(io);
+  std::vector<EventId> eventIds;
+  eventIds.reserve(N_EVENTS);
+
+  // delays are spread over a range, so that events are not always appended at the end
+  report("Scheduler::scheduleEvent", timedExecute([&] {
+    for (size_t i = 0; i < N_EVENTS; ++i) {
+      eventIds.push_back(scheduler.scheduleEvent(time::seconds(10 + (i * 7919) % 1000),
+                                                 [] { BOOST_ERROR("Unexpected event"); }));
+    }
+  }));
+
+  report("Scheduler::cancelEvent", timedExecute([&] {
+    for (const EventId& eventId : eventIds) {
+      scheduler.cancelEvent(eventId);
+    }
+  }));
+
+  io.poll();
+}
+
+BOOST_AUTO_TEST_CASE(Expire)
+{
+  boost::asio::io_service io;
+  Scheduler scheduler(io);
+
+  size_t nExpired = 0;
+  report("Scheduler::scheduleEvent + expire", timedExecute([&] {
+    for (size_t i = 0; i < N_EVENTS; ++i) {
+      scheduler.scheduleEvent(time::nanoseconds(i), [&nExpired] { ++nExpired; });
+    }
+    io.run();
+  }));
+  BOOST_CHECK_EQUAL(nExpired, N_EVENTS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/key-chain.hpp"
+#include "security/validator.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "identity-management-fixture.hpp"
+#include "timed-execute.hpp"
+
+namespace ndn {
+namespace tests {
+
+static const size_t N_SIGNATURES = 1000;
+
+class SecurityFixture : public security::IdentityManagementFixture
+{
+public:
+  void
+  measure(const std::string& algorithm, const KeyParams& params)
+  {
+    Name identity("/ndn-cxx-benchmark/" + algorithm);
+    BOOST_REQUIRE(addIdentity(identity, params));
+    Name certificateName = m_keyChain.getDefaultCertificateNameForIdentity(identity);
+    shared_ptr<IdentityCertificate> certificate = m_keyChain.getCertificate(certificateName);
+    const PublicKey& publicKey = certificate->getPublicKeyInfo();
+
+    std::vector<uint8_t> content(1024, 0xCD);
+    std::vector<Data> packets;
+    packets.reserve(N_SIGNATURES);
+    for (size_t i = 0; i < N_SIGNATURES; ++i) {
+      packets.push_back(Data(Name("/ndn/edu/ucla/cs/irl/benchmark").appendSegment(i)));
+      packets.back().setContent(&content[0], content.size());
+    }
+
+    BenchmarkReport& report = BenchmarkReport::getInstance();
+    report.add("KeyChain::sign(Data) with " + algorithm, timedExecute([&] {
+      for (Data& data : packets) {
+        m_keyChain.sign(data, certificateName);
+      }
+    }), N_SIGNATURES, "signature");
+
+    size_t nValid = 0;
+    report.add("Validator::verifySignature(Data) with " + algorithm, timedExecute([&] {
+      for (const Data& data : packets) {
+        nValid += Validator::verifySignature(data, publicKey);
+      }
+    }), N_SIGNATURES, "signature");
+    BOOST_CHECK_EQUAL(nValid, N_SIGNATURES);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(SecurityBenchmark, SecurityFixture)
+
+BOOST_AUTO_TEST_CASE(Rsa)
+{
+  measure("RSA", RsaKeyParams());
+}
+
+BOOST_AUTO_TEST_CASE(Ecdsa)
+{
+  measure("ECDSA", EcdsaKeyParams());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
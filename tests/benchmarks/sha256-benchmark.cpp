@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/crypto.hpp"
+#include "util/sha256-backend.hpp"
+#include "security/cryptopp.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+namespace ndn {
+namespace tests {
+
+/// @brief number of packets in a batch passed to the multi-buffer function
+static const size_t BATCH_SIZE = 64;
+
+/// @brief total size of the packets hashed by each measurement
+static const size_t N_OCTETS = 256 * 1024 * 1024;
+
+class Sha256BenchmarkFixture
+{
+public:
+  void
+  makeBatch(size_t packetSize)
+  {
+    this->packetSize = packetSize;
+    buffer.resize(BATCH_SIZE * packetSize);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+      buffer[i] = static_cast<uint8_t>(i);
+    }
+
+    digests.resize(BATCH_SIZE * crypto::SHA256_DIGEST_SIZE);
+    packets.resize(BATCH_SIZE);
+    packetSizes.assign(BATCH_SIZE, packetSize);
+    digestPtrs.resize(BATCH_SIZE);
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+      packets[i] = &buffer[i * packetSize];
+      digestPtrs[i] = &digests[i * crypto::SHA256_DIGEST_SIZE];
+    }
+  }
+
+  size_t
+  getNPackets() const
+  {
+    return N_OCTETS / packetSize / BATCH_SIZE * BATCH_SIZE;
+  }
+
+  /// @brief hash batches of packets one by one with @p hash
+  template<typename Hash>
+  void
+  measureSingle(const std::string& implementation, const Hash& hash)
+  {
+    size_t nPackets = getNPackets();
+    time::nanoseconds duration = timedExecute([&] {
+      for (size_t i = 0; i < nPackets; ++i) {
+        hash(packets[i % BATCH_SIZE], packetSize, digestPtrs[i % BATCH_SIZE]);
+      }
+    });
+    report(implementation, duration);
+  }
+
+  void
+  report(const std::string& implementation, const time::nanoseconds& duration)
+  {
+    size_t nPackets = getNPackets();
+    BenchmarkReport::getInstance().add(implementation + " (" + std::to_string(packetSize) +
+                                       "-octet packets)", duration, nPackets, "packet",
+                                       nPackets * packetSize);
+  }
+
+public:
+  size_t packetSize;
+  std::vector<uint8_t> buffer;
+  std::vector<uint8_t> digests;
+  std::vector<const uint8_t*> packets;
+  std::vector<size_t> packetSizes;
+  std::vector<uint8_t*> digestPtrs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Sha256Benchmark, Sha256BenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Throughput)
+{
+  BOOST_TEST_MESSAGE("SHA-256 implementation: " << crypto::getSha256Implementation());
+
+  for (size_t packetSize : {1024, 8192}) {
+    makeBatch(packetSize);
+
+    measureSingle("CryptoPP::SHA256", [] (const uint8_t* data, size_t size, uint8_t* digest) {
+      CryptoPP::SHA256().CalculateDigest(digest, data, size);
+    });
+
+    measureSingle("generic", &crypto::detail::sha256Generic);
+
+    measureSingle("crypto::sha256", [] (const uint8_t* data, size_t size, uint8_t* digest) {
+      crypto::sha256(data, size, digest);
+    });
+
+    size_t nPackets = getNPackets();
+    report("crypto::sha256 multi-buffer", timedExecute([&] {
+      for (size_t i = 0; i < nPackets; i += BATCH_SIZE) {
+        crypto::sha256(BATCH_SIZE, &packets[0], &packetSizes[0], &digestPtrs[0]);
+      }
+    }));
+
+    uint8_t expected[crypto::SHA256_DIGEST_SIZE];
+    crypto::detail::sha256Generic(packets.back(), packetSize, expected);
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected, expected + sizeof(expected),
+                                  digestPtrs.back(), digestPtrs.back() + sizeof(expected));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "transport/shm-transport.hpp"
+#include "transport/tcp-transport.hpp"
+#include "transport/udp-transport.hpp"
+#include "transport/unix-transport.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+#include "benchmark-report.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio.hpp>
+
+#include <unistd.h>
+
+namespace ndn {
+namespace tests {
+
+static const size_t N_PACKETS = 200000;
+
+static void
+report(const std::string& transport, size_t packetSize, const time::nanoseconds& duration)
+{
+  std::string operation = transport + " (" + std::to_string(packetSize) + "-octet packets)";
+  BenchmarkReport::getInstance().add(operation, duration, N_PACKETS, "packet",
+                                     N_PACKETS * packetSize);
+}
+
+static Block
+makePacket(size_t packetSize)
+{
+  size_t headerSize = packetSize - 2 < 253 ? 2 : 4;
+  std::vector<uint8_t> value(packetSize - headerSize, 0xAB);
+  Block packet = dataBlock(tlv::Content, &value[0], value.size());
+  BOOST_REQUIRE_EQUAL(packet.size(), packetSize);
+  return packet;
+}
+
+/** @brief one-way throughput: every packet is sent with a separate Transport::send call,
+ *         and received, parsed and delivered to the receive callback on the other end
+ */
+static time::nanoseconds
+measureShm(const Block& packet)
+{
+  boost::asio::io_service io;
+  std::pair<shared_ptr<ShmTransport>, shared_ptr<ShmTransport>> endpoints =
+    ShmTransport::createLoopback();
+
+  size_t nReceived = 0;
+  endpoints.first->connect(io, [] (const Block&) {});
+  endpoints.second->connect(io, [&] (const Block&) {
+    if (++nReceived == N_PACKETS)
+      io.stop();
+  });
+
+  time::nanoseconds duration = timedExecute([&] {
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      endpoints.first->send(packet);
+    }
+    io.run();
+  });
+
+  BOOST_CHECK_EQUAL(nReceived, N_PACKETS);
+  return duration;
+}
+
+/** @brief one-way throughput through a stream socket; the receiving end only counts
+ *         octets and does not parse packets, which favors this transport
+ *  @param makeTransport creates the sending transport, given the listening endpoint
+ */
+template<class Protocol, class MakeTransport>
+static time::nanoseconds
+measureStream(const Block& packet, const typename Protocol::endpoint& listenEndpoint,
+              const MakeTransport& makeTransport)
+{
+  boost::asio::io_service io;
+  typename Protocol::acceptor acceptor(io, listenEndpoint);
+  typename Protocol::socket socket(io);
+  std::vector<uint8_t> buffer(MAX_NDN_PACKET_SIZE * 8);
+  size_t nExpectedOctets = N_PACKETS * packet.size();
+  size_t nReceivedOctets = 0;
+
+  function<void(const boost::system::error_code&, size_t)> onRead =
+    [&] (const boost::system::error_code& error, size_t nOctets) {
+      nReceivedOctets += nOctets;
+      if (error || nReceivedOctets >= nExpectedOctets)
+        io.stop();
+      else
+        socket.async_read_some(boost::asio::buffer(buffer), onRead);
+    };
+  acceptor.async_accept(socket, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    socket.async_read_some(boost::asio::buffer(buffer), onRead);
+  });
+
+  shared_ptr<Transport> transport = makeTransport(acceptor.local_endpoint());
+  time::nanoseconds duration = timedExecute([&] {
+    transport->connect(io, [] (const Block&) {});
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      transport->send(packet);
+    }
+    io.run();
+  });
+
+  BOOST_CHECK_EQUAL(nReceivedOctets, nExpectedOctets);
+  transport->close();
+  return duration;
+}
+
+static time::nanoseconds
+measureUnix(const Block& packet)
+{
+  namespace local = boost::asio::local;
+
+  std::string socketPath = "/tmp/ndn-cxx-transport-benchmark-" +
+                           std::to_string(::getpid()) + ".sock";
+  ::unlink(socketPath.c_str());
+
+  time::nanoseconds duration = measureStream<local::stream_protocol>(packet,
+    local::stream_protocol::endpoint(socketPath),
+    [] (const local::stream_protocol::endpoint& endpoint) {
+      return make_shared<UnixTransport>(endpoint.path());
+    });
+
+  ::unlink(socketPath.c_str());
+  return duration;
+}
+
+static time::nanoseconds
+measureTcp(const Block& packet)
+{
+  namespace ip = boost::asio::ip;
+
+  return measureStream<ip::tcp>(packet, ip::tcp::endpoint(ip::address_v4::loopback(), 0),
+    [] (const ip::tcp::endpoint& endpoint) {
+      return make_shared<TcpTransport>("127.0.0.1", std::to_string(endpoint.port()));
+    });
+}
+
+/** @brief throughput between two UdpTransports over the loopback interface
+ *
+ *  UDP has no flow control, so the sender keeps a window of packets in flight, small enough
+ *  for the receive buffer of the socket, and sends a new packet whenever one is received.
+ *  The receiving end parses every datagram, unlike the stream measurements.
+ */
+static time::nanoseconds
+measureUdp(const Block& packet)
+{
+  static const size_t MAX_WINDOW = 2 * UdpTransport::MAX_BATCH_SIZE;
+  static const size_t MAX_WINDOW_OCTETS = 65536;
+  size_t window = std::max<size_t>(1, std::min(MAX_WINDOW, MAX_WINDOW_OCTETS / packet.size()));
+
+  boost::asio::io_service io;
+  std::pair<shared_ptr<UdpTransport>, shared_ptr<UdpTransport>> endpoints =
+    UdpTransport::createLoopback();
+
+  size_t nSent = 0;
+  size_t nReceived = 0;
+  endpoints.first->connect(io, [] (const Block&) {});
+  endpoints.second->connect(io, [&] (const Block&) {
+    if (++nReceived == N_PACKETS) {
+      io.stop();
+    }
+    else if (nSent < N_PACKETS) {
+      endpoints.first->send(packet);
+      ++nSent;
+    }
+  });
+
+  time::nanoseconds duration = timedExecute([&] {
+    for (; nSent < window; ++nSent) {
+      endpoints.first->send(packet);
+    }
+    io.run();
+  });
+
+  BOOST_CHECK_EQUAL(nReceived, N_PACKETS);
+  return duration;
+}
+
+BOOST_AUTO_TEST_SUITE(TransportBenchmark)
+
+BOOST_AUTO_TEST_CASE(Throughput)
+{
+  for (size_t packetSize : {100, 1400, 8000}) {
+    Block packet = makePacket(packetSize);
+    report("ShmTransport", packetSize, measureShm(packet));
+    report("UnixTransport", packetSize, measureUnix(packet));
+    report("TcpTransport", packetSize, measureTcp(packet));
+    report("UdpTransport", packetSize, measureUdp(packet));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/block-stream-reader.hpp"
+
+#include "boost-test.hpp"
+#include <sstream>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(EncodingBlockStreamReader)
+
+static const uint8_t STREAM[] = {
+  0x00, 0x01, 0xfa,
+  0x01, 0x00,
+  0x02, 0x03, 0x08, 0x01, 0x41,
+  0x03, 0xfd, 0x00, 0x02, 0xfb, 0xfc
+};
+
+static std::string
+makeStream(size_t nBytes = sizeof(STREAM))
+{
+  return std::string(reinterpret_cast<const char*>(STREAM), nBytes);
+}
+
+BOOST_AUTO_TEST_CASE(ReadAll)
+{
+  for (size_t chunkSize : {6, 7, 9, 16, 1024}) {
+    std::istringstream is(makeStream());
+    BlockStreamReader reader(is, chunkSize);
+
+    Block block;
+    BOOST_REQUIRE(reader.read(block));
+    BOOST_CHECK_EQUAL(block.type(), 0);
+    BOOST_CHECK_EQUAL(block.size(), 3);
+    BOOST_CHECK_EQUAL(*block.value(), 0xfa);
+
+    BOOST_REQUIRE(reader.read(block));
+    BOOST_CHECK_EQUAL(block.type(), 1);
+    BOOST_CHECK_EQUAL(block.value_size(), 0);
+
+    BOOST_REQUIRE(reader.read(block));
+    BOOST_CHECK_EQUAL(block.type(), 2);
+    block.parse();
+    BOOST_CHECK_EQUAL(block.elements_size(), 1);
+
+    BOOST_REQUIRE(reader.read(block));
+    BOOST_CHECK_EQUAL(block.type(), 3);
+    BOOST_CHECK_EQUAL(block.size(), 6);
+    BOOST_CHECK_EQUAL(block.value()[1], 0xfc);
+
+    BOOST_CHECK(!reader.read(block));
+    BOOST_CHECK(!reader.read(block));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SharedBuffer)
+{
+  std::istringstream is(makeStream());
+  BlockStreamReader reader(is);
+
+  Block first, second;
+  BOOST_REQUIRE(reader.read(first));
+  BOOST_REQUIRE(reader.read(second));
+  BOOST_CHECK(first.wire() + first.size() == second.wire());
+}
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  std::istringstream is;
+  BlockStreamReader reader(is);
+
+  Block block;
+  BOOST_CHECK(!reader.read(block));
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  std::istringstream is(makeStream(sizeof(STREAM) - 1));
+  BlockStreamReader reader(is, 8);
+
+  Block block;
+  BOOST_REQUIRE(reader.read(block));
+  BOOST_REQUIRE(reader.read(block));
+  BOOST_REQUIRE(reader.read(block));
+  BOOST_CHECK_THROW(reader.read(block), BlockStreamReader::Error);
+}
+
+BOOST_AUTO_TEST_CASE(TooLarge)
+{
+  std::istringstream is(makeStream());
+  BlockStreamReader reader(is, 4);
+
+  Block block;
+  BOOST_REQUIRE(reader.read(block));
+  BOOST_REQUIRE(reader.read(block));
+  BOOST_CHECK_THROW(reader.read(block), BlockStreamReader::Error);
+
+  BOOST_CHECK_THROW(BlockStreamReader(is, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -235,6 +235,232 @@ BOOST_FIXTURE_TEST_CASE(OptionsTimeout, CommandFixture)
   BOOST_CHECK_EQUAL(commandFailHistory[0].get<0>(), Controller::ERROR_TIMEOUT);
 }
 
+BOOST_FIXTURE_TEST_CASE(CommandBatch, CommandFixture)
+{
+  const size_t nCommands = Controller::BATCH_WINDOW_SIZE + 2;
+  std::vector<ControlParameters> parametersList;
+  for (size_t i = 0; i < nCommands; ++i) {
+    ControlParameters parameters;
+    parameters.setName(Name("/batch").appendNumber(i));
+    parametersList.push_back(parameters);
+  }
+
+  std::vector<size_t> succeeded, failed;
+  controller.startBatch<RibRegisterCommand>(parametersList,
+    [&succeeded] (size_t index, const ControlParameters&) { succeeded.push_back(index); },
+    [&failed] (size_t index, uint32_t, const std::string&) { failed.push_back(index); });
+  advanceClocks(time::milliseconds(1));
+
+  // window is full
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), Controller::BATCH_WINDOW_SIZE);
+  std::vector<Interest> requests = face->sentInterests;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    BOOST_CHECK(Name("/localhost/nfd/rib/register").isPrefixOf(requests[i].getName()));
+    // all requests are signed with the same key
+    BOOST_CHECK_EQUAL(requests[i].getName()[-2], requests[0].getName()[-2]);
+  }
+
+  ControlParameters responseBody;
+  responseBody.setName("/batch")
+              .setFaceId(1)
+              .setOrigin(0)
+              .setCost(0)
+              .setFlags(0);
+
+  ControlResponse successPayload(200, "OK");
+  successPayload.setBody(responseBody.wireEncode());
+
+  Data successData(requests[0].getName());
+  successData.setContent(successPayload.wireEncode());
+  keyChain.sign(successData);
+  face->receive(successData);
+
+  Data failureData(requests[1].getName());
+  failureData.setContent(ControlResponse(403, "Forbidden").wireEncode());
+  keyChain.sign(failureData);
+  face->receive(failureData);
+
+  face->sentInterests.clear();
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK((succeeded == std::vector<size_t>{0}));
+  BOOST_CHECK((failed == std::vector<size_t>{1}));
+  // two completed commands make room for the remaining two
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(CommandBatchInvalidRequest, CommandFixture)
+{
+  std::vector<ControlParameters> parametersList(2);
+  parametersList[0].setName("/valid");
+  // parametersList[1] has no Name
+
+  BOOST_CHECK_THROW(controller.startBatch<RibRegisterCommand>(parametersList, nullptr, nullptr),
+                    ControlCommand::ArgumentError);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 0);
+}
+
+class DatasetFixture : public CommandFixture
+{
+protected:
+  DatasetFixture()
+    : nSuccesses(0)
+  {
+  }
+
+public:
+  void
+  onFaceStatus(const FaceStatus& status)
+  {
+    faceIds.push_back(status.getFaceId());
+  }
+
+  void
+  onDatasetSucceed()
+  {
+    ++nSuccesses;
+  }
+
+  /** \brief respond to a segment Interest with part of the dataset payload
+   */
+  void
+  sendSegment(const Name& versionedName, uint64_t segmentNo,
+              const uint8_t* payload, size_t payloadSize, bool isFinal)
+  {
+    shared_ptr<Data> data = make_shared<Data>(Name(versionedName).appendSegment(segmentNo));
+    data->setContent(payload, payloadSize);
+    if (isFinal)
+      data->setFinalBlockId(data->getName()[-1]);
+    keyChain.sign(*data);
+    face->receive(*data);
+  }
+
+protected:
+  std::vector<uint64_t> faceIds;
+  int nSuccesses;
+};
+
+BOOST_FIXTURE_TEST_CASE(DatasetFetch, DatasetFixture)
+{
+  EncodingBuffer payload;
+  for (uint64_t faceId = 3; faceId > 0; --faceId) {
+    FaceStatus status;
+    status.setFaceId(faceId)
+          .setRemoteUri("udp4://192.0.2.1:6363")
+          .setLocalUri("udp4://192.0.2.2:6363");
+    status.wireEncode(payload);
+  }
+  const uint8_t* payloadBytes = payload.buf();
+  size_t payloadSize = payload.size();
+  size_t splitAt = payloadSize / 2; // the second item spans both segments
+
+  controller.fetch<FaceDataset>(bind(&DatasetFixture::onFaceStatus, this, _1),
+                                bind(&DatasetFixture::onDatasetSucceed, this),
+                                commandFailCallback);
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 1);
+  const Interest& initialInterest = face->sentInterests[0];
+  BOOST_CHECK_EQUAL(initialInterest.getName(), "/localhost/nfd/faces/list");
+  BOOST_CHECK_EQUAL(initialInterest.getChildSelector(), 1);
+  BOOST_CHECK_EQUAL(initialInterest.getMustBeFresh(), true);
+
+  Name versionedName("/localhost/nfd/faces/list");
+  versionedName.appendVersion(1);
+
+  // latest segment arrives first; nothing can be decoded until segment 0 arrives
+  face->sentInterests.clear();
+  this->sendSegment(versionedName, 1, payloadBytes + splitAt, payloadSize - splitAt, true);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK(faceIds.empty());
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face->sentInterests[0].getName(), Name(versionedName).appendSegment(0));
+
+  this->sendSegment(versionedName, 0, payloadBytes, splitAt, false);
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK((faceIds == std::vector<uint64_t>{1, 2, 3}));
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+  BOOST_CHECK_EQUAL(commandFailHistory.size(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(DatasetPipelined, DatasetFixture)
+{
+  controller.fetch<FaceDataset>(bind(&DatasetFixture::onFaceStatus, this, _1),
+                                bind(&DatasetFixture::onDatasetSucceed, this),
+                                commandFailCallback);
+  advanceClocks(time::milliseconds(1));
+
+  Name versionedName("/localhost/nfd/faces/list");
+  versionedName.appendVersion(1);
+
+  FaceStatus status;
+  status.setFaceId(1);
+  const Block& item = status.wireEncode();
+
+  face->sentInterests.clear();
+  this->sendSegment(versionedName, 0, item.wire(), item.size(), false);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(faceIds.size(), 1);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), Controller::DATASET_WINDOW_SIZE);
+
+  this->sendSegment(versionedName, 1, item.wire(), item.size(), true);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(faceIds.size(), 2);
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+
+  // remaining Interests are canceled and do not cause a failure
+  advanceClocks(time::milliseconds(100), 101);
+  BOOST_CHECK_EQUAL(commandFailHistory.size(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(DatasetItemSpansManySegments, DatasetFixture)
+{
+  EncodingBuffer payload;
+  for (uint64_t faceId = 2; faceId > 0; --faceId) {
+    FaceStatus status;
+    status.setFaceId(faceId)
+          .setRemoteUri("udp4://192.0.2.1:6363")
+          .setLocalUri("udp4://192.0.2.2:6363");
+    status.wireEncode(payload);
+  }
+
+  controller.fetch<FaceDataset>(bind(&DatasetFixture::onFaceStatus, this, _1),
+                                bind(&DatasetFixture::onDatasetSucceed, this),
+                                commandFailCallback);
+  advanceClocks(time::milliseconds(1));
+
+  Name versionedName("/localhost/nfd/faces/list");
+  versionedName.appendVersion(1);
+
+  // every segment carries a single octet, so headers are split as well
+  for (size_t i = 0; i < payload.size(); ++i) {
+    this->sendSegment(versionedName, i, payload.buf() + i, 1, i + 1 == payload.size());
+    advanceClocks(time::milliseconds(1));
+  }
+
+  BOOST_CHECK((faceIds == std::vector<uint64_t>{1, 2}));
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+  BOOST_CHECK_EQUAL(commandFailHistory.size(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(DatasetTimeout, DatasetFixture)
+{
+  CommandOptions options;
+  options.setTimeout(time::milliseconds(50));
+
+  controller.fetch<FibDataset>(nullptr,
+                               bind(&DatasetFixture::onDatasetSucceed, this),
+                               commandFailCallback,
+                               options);
+  advanceClocks(time::milliseconds(1), 101); // Face's PIT granularity is 100ms
+
+  BOOST_CHECK_EQUAL(nSuccesses, 0);
+  BOOST_REQUIRE_EQUAL(commandFailHistory.size(), 1);
+  BOOST_CHECK_EQUAL(commandFailHistory[0].get<0>(), Controller::ERROR_TIMEOUT);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -20,6 +20,7 @@
  */
 
 #include "security/certificate-cache-ttl.hpp"
+#include "security/certificate-cache-lru.hpp"
 #include "face.hpp"
 #include "util/time-unit-test-clock.hpp"
 
@@ -131,6 +132,94 @@ BOOST_FIXTURE_TEST_CASE(Reset, CertificateCacheFixture)
   BOOST_CHECK_EQUAL(cache->getSize(), 0);
 }
 
+class CertificateCacheLruFixture : public UnitTestTimeFixture
+{
+public:
+  CertificateCacheLruFixture()
+    : cache(2, time::seconds(1))
+  {
+    for (int i = 0; i < 3; ++i) {
+      shared_ptr<IdentityCertificate> cert = make_shared<IdentityCertificate>();
+      cert->setName(Name("/tmp/KEY/ksk-" + std::to_string(i) + "/ID-CERT/1"));
+      certs.push_back(cert);
+      names.push_back(cert->getName().getPrefix(-1));
+    }
+    certs[0]->setFreshnessPeriod(time::milliseconds(500));
+  }
+
+public:
+  CertificateCacheLru cache;
+  std::vector<shared_ptr<IdentityCertificate>> certs;
+  std::vector<Name> names;
+};
+
+BOOST_FIXTURE_TEST_CASE(LruExpiration, CertificateCacheLruFixture)
+{
+  cache.insertCertificate(certs[0]); // 500ms
+  cache.insertCertificate(certs[1]); // default TTL 1s
+  BOOST_CHECK_EQUAL(cache.getSize(), 2);
+
+  advanceClocks(time::milliseconds(499));
+  BOOST_CHECK(cache.getCertificate(names[0]) == certs[0]);
+  BOOST_CHECK(cache.getCertificate(names[1]) == certs[1]);
+
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK(cache.getCertificate(names[0]) == nullptr);
+  BOOST_CHECK(cache.getVerifier(names[0]) == nullptr);
+  BOOST_CHECK_EQUAL(cache.getSize(), 1);
+
+  // re-inserting extends the lifetime
+  advanceClocks(time::milliseconds(400));
+  cache.insertCertificate(certs[1]);
+  advanceClocks(time::milliseconds(900));
+  BOOST_CHECK(cache.getCertificate(names[1]) == certs[1]);
+  BOOST_CHECK_EQUAL(cache.getSize(), 1);
+
+  advanceClocks(time::milliseconds(100));
+  BOOST_CHECK_EQUAL(cache.getSize(), 0);
+  BOOST_CHECK(cache.isEmpty());
+}
+
+BOOST_FIXTURE_TEST_CASE(LruEviction, CertificateCacheLruFixture)
+{
+  BOOST_CHECK_EQUAL(cache.getCapacity(), 2);
+
+  cache.insertCertificate(certs[0]);
+  cache.insertCertificate(certs[1]);
+
+  // certs[0] becomes the most recently used, so certs[1] is evicted
+  BOOST_CHECK(cache.getCertificate(names[0]) == certs[0]);
+  cache.insertCertificate(certs[2]);
+  BOOST_CHECK_EQUAL(cache.getSize(), 2);
+  BOOST_CHECK(cache.getCertificate(names[0]) == certs[0]);
+  BOOST_CHECK(cache.getCertificate(names[1]) == nullptr);
+  BOOST_CHECK(cache.getCertificate(names[2]) == certs[2]);
+
+  // an expired certificate is evicted before the least recently used one
+  advanceClocks(time::milliseconds(500));
+  cache.insertCertificate(certs[1]);
+  BOOST_CHECK(cache.getCertificate(names[0]) == nullptr);
+  BOOST_CHECK(cache.getCertificate(names[1]) == certs[1]);
+  BOOST_CHECK(cache.getCertificate(names[2]) == certs[2]);
+
+  cache.reset();
+  BOOST_CHECK_EQUAL(cache.getSize(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(LruVerifier, CertificateCacheLruFixture)
+{
+  BOOST_CHECK(cache.getVerifier(names[1]) == nullptr);
+
+  cache.insertCertificate(certs[1]);
+  shared_ptr<const PublicKeyVerifier> verifier = cache.getVerifier(names[1]);
+  BOOST_REQUIRE(verifier != nullptr);
+
+  // the decoded key is kept with the certificate, also when the certificate is refreshed
+  BOOST_CHECK_EQUAL(cache.getVerifier(names[1]), verifier);
+  cache.insertCertificate(certs[1]);
+  BOOST_CHECK_EQUAL(cache.getVerifier(names[1]), verifier);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
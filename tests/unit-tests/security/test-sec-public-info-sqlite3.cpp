@@ -21,6 +21,8 @@
 
 #include "security/sec-public-info-sqlite3.hpp"
 #include "security/key-chain.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+#include "encoding/block-helpers.hpp"
 #include "security/cryptopp.hpp"
 #include "encoding/buffer-stream.hpp"
 #include "util/time.hpp"
@@ -143,6 +145,86 @@ BOOST_AUTO_TEST_CASE(KeyTypeNonExist)
 
 }
 
+static IdentityCertificate
+makeCertificate(const Name& keyName, const PublicKey& key, uint64_t version)
+{
+  Name certName = keyName.getPrefix(-1);
+  certName.append("KEY").append(keyName.get(-1)).append("ID-CERT").appendVersion(version);
+
+  IdentityCertificate certificate;
+  certificate.setName(certName);
+  certificate.setNotBefore(time::system_clock::now());
+  certificate.setNotAfter(time::system_clock::now() + time::days(1));
+  certificate.setPublicKeyInfo(key);
+  certificate.encode();
+
+  SignatureSha256WithRsa signature(KeyLocator(certName.getPrefix(-1)));
+  uint8_t signatureValue[] = {0x01};
+  signature.setValue(dataBlock(tlv::SignatureValue, signatureValue, sizeof(signatureValue)));
+  certificate.setSignature(signature);
+  return certificate;
+}
+
+BOOST_FIXTURE_TEST_CASE(EnumerateAll, PibTmpPathFixture)
+{
+  using namespace CryptoPP;
+
+  OBufferStream os;
+  StringSource ss(reinterpret_cast<const uint8_t*>(RSA_DER.c_str()), RSA_DER.size(),
+                  true, new Base64Decoder(new FileSink(os)));
+  PublicKey key(os.buf()->buf(), os.buf()->size());
+
+  SecPublicInfoSqlite3 pib(tmpPath.generic_string());
+  pib.addCertificate(makeCertificate("/alice/ksk-1", key, 1));
+  pib.addCertificate(makeCertificate("/alice/ksk-1", key, 2));
+  pib.addCertificate(makeCertificate("/alice/ksk-2", key, 3));
+  pib.addKey("/bob/dsk-3", key);
+  pib.addIdentity("/carol");
+  pib.setDefaultIdentity("/bob");
+  pib.setDefaultKeyNameForIdentity("/alice/ksk-2");
+  pib.setDefaultCertificateNameForKey(makeCertificate("/alice/ksk-1", key, 2).getName());
+
+  std::vector<SecPublicInfo::PibEntry> entries;
+  pib.enumerateAll([&] (const SecPublicInfo::PibEntry& entry) { entries.push_back(entry); });
+
+  // defaults first, then the others in the order they were added
+  BOOST_REQUIRE_EQUAL(entries.size(), 5);
+  BOOST_CHECK_EQUAL(entries[0].identity, Name("/bob"));
+  BOOST_CHECK(entries[0].isDefaultIdentity);
+  BOOST_CHECK_EQUAL(entries[0].keyName, Name("/bob/dsk-3"));
+  BOOST_CHECK(entries[0].certificateName.empty());
+
+  BOOST_CHECK_EQUAL(entries[1].keyName, Name("/alice/ksk-2"));
+  BOOST_CHECK(entries[1].isDefaultKey);
+  BOOST_CHECK_EQUAL(entries[1].certificateName, makeCertificate("/alice/ksk-2", key, 3).getName());
+
+  BOOST_CHECK_EQUAL(entries[2].keyName, Name("/alice/ksk-1"));
+  BOOST_CHECK(!entries[2].isDefaultKey);
+  BOOST_CHECK_EQUAL(entries[2].certificateName, makeCertificate("/alice/ksk-1", key, 2).getName());
+  BOOST_CHECK(entries[2].isDefaultCertificate);
+  BOOST_CHECK_EQUAL(entries[3].certificateName, makeCertificate("/alice/ksk-1", key, 1).getName());
+  BOOST_CHECK(!entries[3].isDefaultCertificate);
+
+  BOOST_CHECK_EQUAL(entries[4].identity, Name("/carol"));
+  BOOST_CHECK(!entries[4].isDefaultIdentity);
+  BOOST_CHECK(entries[4].keyName.empty());
+
+  // the joined query visits the same entries as the generic implementation
+  std::vector<SecPublicInfo::PibEntry> genericEntries;
+  pib.SecPublicInfo::enumerateAll([&] (const SecPublicInfo::PibEntry& entry) {
+    genericEntries.push_back(entry);
+  });
+  BOOST_REQUIRE_EQUAL(genericEntries.size(), entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    BOOST_CHECK_EQUAL(genericEntries[i].identity, entries[i].identity);
+    BOOST_CHECK_EQUAL(genericEntries[i].isDefaultIdentity, entries[i].isDefaultIdentity);
+    BOOST_CHECK_EQUAL(genericEntries[i].keyName, entries[i].keyName);
+    BOOST_CHECK_EQUAL(genericEntries[i].isDefaultKey, entries[i].isDefaultKey);
+    BOOST_CHECK_EQUAL(genericEntries[i].certificateName, entries[i].certificateName);
+    BOOST_CHECK_EQUAL(genericEntries[i].isDefaultCertificate, entries[i].isDefaultCertificate);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
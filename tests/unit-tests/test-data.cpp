@@ -248,6 +248,34 @@ BOOST_FIXTURE_TEST_CASE(Decode, TestDataFixture)
   BOOST_REQUIRE_EQUAL(signatureVerified, true);
 }
 
+BOOST_AUTO_TEST_CASE(LazyDecode)
+{
+  Block dataBlock(Data1, sizeof(Data1));
+
+  Data d;
+  d.lazyWireDecode(dataBlock);
+  BOOST_CHECK_EQUAL(d.getName().toUri(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(d.getContent().value_size(), sizeof(Content1));
+  BOOST_CHECK(d.wireEncode() == dataBlock);
+
+  // modifying the packet must not lose deferred MetaInfo and Signature
+  d.setContent(Content1, sizeof(Content1));
+  BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(d.getSignature().getType(), static_cast<uint32_t>(Signature::Sha256WithRsa));
+  BOOST_CHECK_EQUAL_COLLECTIONS(Data1, Data1 + sizeof(Data1),
+                                d.wireEncode().begin(), d.wireEncode().end());
+
+  Data d2;
+  d2.lazyWireDecode(dataBlock);
+  BOOST_CHECK_EQUAL(d2.getSignature().getKeyLocator().getName(), "/test/key/locator");
+
+  Data d3;
+  d3.lazyWireDecode(dataBlock);
+  d3.decodeDeferredFields();
+  BOOST_CHECK_EQUAL(d3.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK(d3.wireEncode() == dataBlock);
+}
+
 BOOST_FIXTURE_TEST_CASE(Encode, TestDataFixture)
 {
   // manual data packet creation for now
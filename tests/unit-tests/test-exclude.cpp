@@ -190,6 +190,27 @@ BOOST_AUTO_TEST_CASE(Malformed)
   //                   Exclude::Error);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeLarge)
+{
+  Exclude e;
+  for (int i = 0; i < 1000; i += 2) {
+    e.excludeOne(name::Component::fromNumber(i));
+  }
+  e.excludeRange(name::Component::fromNumber(2000), name::Component::fromNumber(3000));
+
+  Exclude e2;
+  e2.wireDecode(e.wireEncode());
+  BOOST_CHECK_EQUAL(e2.size(), 502);
+  BOOST_CHECK_EQUAL(e2.toUri(), e.toUri());
+
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(e2.isExcluded(name::Component::fromNumber(i)), i % 2 == 0);
+  }
+  BOOST_CHECK_EQUAL(e2.isExcluded(name::Component::fromNumber(1500)), false);
+  BOOST_CHECK_EQUAL(e2.isExcluded(name::Component::fromNumber(2500)), true);
+  BOOST_CHECK_EQUAL(e2.isExcluded(name::Component::fromNumber(3001)), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
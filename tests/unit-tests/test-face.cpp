@@ -28,6 +28,9 @@
 #include "unit-test-time-fixture.hpp"
 #include "test-make-interest-data.hpp"
 
+#include <mutex>
+#include <thread>
+
 namespace ndn {
 namespace tests {
 
@@ -119,6 +122,103 @@ BOOST_AUTO_TEST_CASE(RemovePendingInterest)
   advanceClocks(time::milliseconds(10), 100);
 }
 
+BOOST_AUTO_TEST_CASE(AggregateInterests)
+{
+  size_t nData = 0;
+  auto onData = [&] (const Interest&, const Data&) { ++nData; };
+  auto onTimeout = bind([] { BOOST_FAIL("Unexpected timeout"); });
+
+  // disabled by default
+  face->expressInterest(Interest("/A", time::milliseconds(100)), onData, onTimeout);
+  face->expressInterest(Interest("/A", time::milliseconds(100)), onData, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+
+  face->setInterestAggregation(true);
+  face->expressInterest(Interest("/B", time::milliseconds(100)), onData, onTimeout);
+  face->expressInterest(Interest("/B", time::milliseconds(100)), onData, onTimeout);
+  face->expressInterest(Interest("/B", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/B", time::milliseconds(100)).setMustBeFresh(true),
+                        onData, onTimeout);
+  face->expressInterest(Interest("/C", time::milliseconds(100)), onData, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 5);
+  BOOST_CHECK_EQUAL(face->sentInterests[2].getName(), "/B");
+  BOOST_CHECK(face->sentInterests[3].getMustBeFresh());
+  BOOST_CHECK_EQUAL(face->sentInterests[4].getName(), "/C");
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 7);
+
+  // one Data satisfies every aggregated Interest
+  face->receive(*util::makeData("/B/!"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 4);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 3);
+
+  face->receive(*util::makeData("/A/!"));
+  face->receive(*util::makeData("/C/!"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 7);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AggregateInterestsTimeout)
+{
+  face->setInterestAggregation(true);
+
+  size_t nTimeouts = 0;
+  auto onData = bind([] { BOOST_FAIL("Unexpected data"); });
+  auto onTimeout = bind([&nTimeouts] { ++nTimeouts; });
+
+  const PendingInterestId* firstId =
+    face->expressInterest(Interest("/A", time::milliseconds(100)), onData, onTimeout);
+  // would outlive the first Interest in the forwarder, so it is sent
+  face->expressInterest(Interest("/A", time::milliseconds(500)), onData, onTimeout);
+  // covered by the second Interest
+  face->expressInterest(Interest("/A", time::milliseconds(300)), onData, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+
+  // removing the first Interest does not affect the others
+  face->removePendingInterest(firstId);
+  advanceClocks(time::milliseconds(10), 40);
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 1);
+
+  advanceClocks(time::milliseconds(10), 20);
+  BOOST_CHECK_EQUAL(nTimeouts, 2);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+
+  // nothing is pending anymore
+  face->expressInterest(Interest("/A", time::milliseconds(100)), onData, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(AggregateInterestsStream)
+{
+  face->setInterestAggregation(true);
+
+  size_t nTimeouts = 0;
+  auto onData = bind([] { BOOST_FAIL("Unexpected data"); });
+  auto onTimeout = bind([&nTimeouts] { ++nTimeouts; });
+
+  // identical Interests expressed every 90 ms, over several lifetimes: each one sent covers
+  // the next one, but not the one after, which would outlive it in the forwarder
+  std::vector<size_t> nSent;
+  for (int i = 0; i < 10; ++i) {
+    face->expressInterest(Interest("/A", time::milliseconds(200)), onData, onTimeout);
+    advanceClocks(time::milliseconds(10), 9);
+    nSent.push_back(face->sentInterests.size());
+  }
+  std::vector<size_t> expectedNSent{1, 1, 2, 2, 3, 3, 4, 4, 5, 5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(nSent.begin(), nSent.end(),
+                                expectedNSent.begin(), expectedNSent.end());
+
+  advanceClocks(time::milliseconds(10), 30);
+  BOOST_CHECK_EQUAL(nTimeouts, 10);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(SetUnsetInterestFilter)
 {
   size_t nInterests = 0;
@@ -221,6 +321,40 @@ BOOST_FIXTURE_TEST_CASE(RegisterUnregisterPrefixFail, FacesNoRegistrationReplyFi
   BOOST_CHECK_EQUAL(nRegFailures, 1);
 }
 
+BOOST_AUTO_TEST_CASE(RegisterPrefixes)
+{
+  std::vector<Name> prefixes;
+  for (int i = 0; i < 100; ++i) {
+    prefixes.push_back(Name("/Hello/World").appendNumber(i));
+  }
+
+  std::set<Name> registered;
+  std::vector<const RegisteredPrefixId*> regPrefixIds =
+    face->registerPrefixes(prefixes,
+                           [&registered] (const Name& prefix) { registered.insert(prefix); },
+                           bind([] {
+                               BOOST_FAIL("Unexpected registerPrefixes failure");
+                             }));
+  BOOST_REQUIRE_EQUAL(regPrefixIds.size(), prefixes.size());
+  BOOST_CHECK_EQUAL(std::set<const RegisteredPrefixId*>(regPrefixIds.begin(),
+                                                        regPrefixIds.end()).size(),
+                    prefixes.size());
+
+  advanceClocks(time::milliseconds(10), 10);
+  BOOST_CHECK_EQUAL(registered.size(), prefixes.size());
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), prefixes.size());
+
+  size_t nUnregSuccesses = 0;
+  face->unregisterPrefix(regPrefixIds[42],
+                         bind([&nUnregSuccesses] { ++nUnregSuccesses; }),
+                         bind([] {
+                             BOOST_FAIL("Unexpected unregisterPrefix failure");
+                           }));
+
+  advanceClocks(time::milliseconds(10), 10);
+  BOOST_CHECK_EQUAL(nUnregSuccesses, 1);
+}
+
 BOOST_AUTO_TEST_CASE(SimilarFilters)
 {
   size_t nInInterests1 = 0;
@@ -364,5 +498,238 @@ BOOST_AUTO_TEST_CASE(ProcessEvents)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+/** @brief fixture for Face::startWorkers, using wall clock time
+ */
+class FaceWorkersFixture
+{
+public:
+  FaceWorkersFixture()
+    : face(makeDummyClientFace(io, {true, false}))
+    , mainThreadId(std::this_thread::get_id())
+    , isOnMainThread(false)
+  {
+  }
+
+  /** @brief process events of the Face on this thread until @p predicate becomes true
+   *  @return whether @p predicate became true within five seconds
+   */
+  template<typename Predicate>
+  bool
+  processEventsUntil(const Predicate& predicate)
+  {
+    time::steady_clock::TimePoint deadline = time::steady_clock::now() + time::seconds(5);
+    while (!predicate()) {
+      if (time::steady_clock::now() > deadline)
+        return false;
+      face->processEvents(time::milliseconds(-1));
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  /** @brief record that a callback for @p name was invoked
+   */
+  void
+  record(const Name& name)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    calls.push_back(name);
+    if (std::this_thread::get_id() == mainThreadId)
+      isOnMainThread = true;
+  }
+
+  size_t
+  getNCalls()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return calls.size();
+  }
+
+public:
+  boost::asio::io_service io;
+  shared_ptr<DummyClientFace> face;
+
+  std::thread::id mainThreadId;
+  std::mutex mutex;
+  std::vector<Name> calls;
+  bool isOnMainThread;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestFaceWorkers, FaceWorkersFixture)
+
+BOOST_AUTO_TEST_CASE(StartTwice)
+{
+  BOOST_CHECK_THROW(face->startWorkers(0, 4), Face::Error);
+  face->startWorkers(2, 4);
+  BOOST_CHECK_THROW(face->startWorkers(2, 4), Face::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestData)
+{
+  face->startWorkers(4, 8);
+
+  static const size_t N_INTERESTS = 200;
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    Name name(i % 2 == 0 ? "/A" : "/B");
+    name.appendSegment(i);
+    face->expressInterest(Interest(name, time::seconds(10)),
+                          [this] (const Interest& interest, const Data&) {
+                            this->record(interest.getName());
+                          },
+                          bind([] { BOOST_ERROR("Unexpected timeout"); }));
+  }
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), N_INTERESTS);
+  BOOST_REQUIRE(processEventsUntil([this] { return face->sentInterests.size() == N_INTERESTS; }));
+
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    face->receive(*util::makeData(Name(face->sentInterests[i].getName()).append("!")));
+  }
+  BOOST_REQUIRE(processEventsUntil([this] { return getNCalls() == N_INTERESTS; }));
+  BOOST_CHECK(!isOnMainThread);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+
+  // callbacks for one prefix are invoked in the order in which Data arrived
+  std::lock_guard<std::mutex> lock(mutex);
+  uint64_t lastA = 0, lastB = 0;
+  bool isFirstA = true, isFirstB = true;
+  for (const Name& name : calls) {
+    uint64_t segment = name.get(-1).toSegment();
+    if (name.get(0) == name::Component("A")) {
+      BOOST_CHECK(isFirstA || segment > lastA);
+      lastA = segment;
+      isFirstA = false;
+    }
+    else {
+      BOOST_CHECK(isFirstB || segment > lastB);
+      lastB = segment;
+      isFirstB = false;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ShortInterestName)
+{
+  // with prefixLength 2, an Interest for /A is in a different shard than Data /A/B/C
+  face->startWorkers(2, 16, 2);
+
+  face->expressInterest(Interest("/A", time::seconds(10)),
+                        [this] (const Interest& interest, const Data&) {
+                          this->record(interest.getName());
+                        },
+                        bind([] { BOOST_ERROR("Unexpected timeout"); }));
+  BOOST_REQUIRE(processEventsUntil([this] { return face->sentInterests.size() == 1; }));
+
+  face->receive(*util::makeData("/A/B/C"));
+  BOOST_REQUIRE(processEventsUntil([this] { return getNCalls() == 1; }));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestTimeout)
+{
+  face->startWorkers(2, 4);
+
+  face->expressInterest(Interest("/Hello/World", time::milliseconds(50)),
+                        bind([] { BOOST_ERROR("Unexpected data"); }),
+                        [this] (const Interest& interest) {
+                          this->record(interest.getName());
+                        });
+
+  BOOST_REQUIRE(processEventsUntil([this] { return getNCalls() == 1; }));
+  BOOST_CHECK(!isOnMainThread);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RemovePendingInterest)
+{
+  face->startWorkers(2, 4);
+
+  const PendingInterestId* interestId =
+    face->expressInterest(Interest("/Hello/World", time::seconds(10)),
+                          bind([] { BOOST_ERROR("Unexpected data"); }),
+                          bind([] { BOOST_ERROR("Unexpected timeout"); }));
+  face->removePendingInterest(interestId);
+  BOOST_REQUIRE(processEventsUntil([this] { return face->getNPendingInterests() == 0; }));
+
+  face->receive(*util::makeData("/Hello/World/!"));
+  face->processEvents(time::milliseconds(50));
+}
+
+BOOST_AUTO_TEST_CASE(AggregateInterests)
+{
+  face->setInterestAggregation(true);
+  face->startWorkers(2, 4);
+
+  static const size_t N_INTERESTS = 20;
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    face->expressInterest(Interest(i % 2 == 0 ? "/A" : "/B", time::seconds(10)),
+                          [this] (const Interest& interest, const Data&) {
+                            this->record(interest.getName());
+                          },
+                          bind([] { BOOST_ERROR("Unexpected timeout"); }));
+  }
+  BOOST_REQUIRE(processEventsUntil([this] { return face->sentInterests.size() == 2; }));
+
+  face->receive(*util::makeData("/A/!"));
+  face->receive(*util::makeData("/B/!"));
+  BOOST_REQUIRE(processEventsUntil([this] { return getNCalls() == N_INTERESTS; }));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(InterestFilters)
+{
+  face->startWorkers(4, 8);
+
+  size_t nRoot = 0;
+  face->setInterestFilter("/A", [this] (const InterestFilter&, const Interest& interest) {
+    this->record(interest.getName());
+  });
+  // shorter than the shard prefix length, so it is installed in every shard
+  face->setInterestFilter(InterestFilter("/", "<>*<B><>"),
+                          [this, &nRoot] (const InterestFilter&, const Interest&) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            ++nRoot;
+                          });
+  face->processEvents(time::milliseconds(-1));
+  face->processEvents(time::milliseconds(20)); // let the workers install the filters
+
+  static const size_t N_INTERESTS = 100;
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    face->receive(Interest(Name("/A").appendSegment(i)));
+    face->receive(Interest(Name("/B").appendSegment(i)));
+  }
+  BOOST_REQUIRE(processEventsUntil([this, &nRoot] {
+    std::lock_guard<std::mutex> lock(mutex);
+    return calls.size() == N_INTERESTS && nRoot == N_INTERESTS;
+  }));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    BOOST_CHECK_EQUAL(calls[i], Name("/A").appendSegment(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Shutdown)
+{
+  face->startWorkers(2, 4);
+
+  face->setInterestFilter("/A", [this] (const InterestFilter&, const Interest& interest) {
+    this->record(interest.getName());
+  });
+  face->expressInterest(Interest("/B", time::seconds(10)),
+                        bind([] { BOOST_ERROR("Unexpected data"); }),
+                        bind([] { BOOST_ERROR("Unexpected timeout"); }));
+  BOOST_REQUIRE(processEventsUntil([this] { return face->sentInterests.size() == 1; }));
+
+  // pending Interests are dropped, InterestFilters are kept, as without workers
+  face->shutdown();
+  BOOST_REQUIRE(processEventsUntil([this] { return face->getNPendingInterests() == 0; }));
+
+  face->receive(Interest("/A/1"));
+  BOOST_REQUIRE(processEventsUntil([this] { return getNCalls() == 1; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 } // tests
 } // namespace ndn
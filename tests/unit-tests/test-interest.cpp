@@ -286,6 +286,46 @@ BOOST_AUTO_TEST_CASE(Decode)
   BOOST_CHECK_EQUAL(i.getNonce(), 1U);
 }
 
+BOOST_AUTO_TEST_CASE(LazyDecode)
+{
+  Block interestBlock(Interest1, sizeof(Interest1));
+
+  Interest i;
+  i.lazyWireDecode(interestBlock);
+  BOOST_CHECK_EQUAL(i.getName().toUri(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(i.getScope(), 1);
+
+  // resetting the wire must not lose deferred Selectors
+  i.setScope(2);
+  BOOST_CHECK_EQUAL(i.getMinSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i.getExclude().toUri(), "alex,xxxx,*,yyyy");
+  BOOST_CHECK_EQUAL(i.getChildSelector(), 1);
+
+  i.setScope(1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(Interest1, Interest1 + sizeof(Interest1),
+                                i.wireEncode().begin(), i.wireEncode().end());
+
+  Interest j;
+  j.lazyWireDecode(interestBlock);
+  j.setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(j.getMustBeFresh(), true);
+  BOOST_CHECK_EQUAL(j.getPublisherPublicKeyLocator().getName(), "ndn:/test/key/locator");
+
+  static const uint8_t MALFORMED_SELECTORS[] = {
+    0x05, 0x13,
+      0x07, 0x03, 0x08, 0x01, 0x41,
+      0x09, 0x06, 0x10, 0x04, 0x13, 0x00, 0x13, 0x00, // Exclude with <Any/><Any/>
+      0x0a, 0x04, 0x01, 0x00, 0x00, 0x00
+  };
+  Block malformed(MALFORMED_SELECTORS, sizeof(MALFORMED_SELECTORS));
+  BOOST_CHECK_THROW(Interest().wireDecode(malformed), tlv::Error);
+
+  Interest k;
+  BOOST_REQUIRE_NO_THROW(k.lazyWireDecode(malformed));
+  BOOST_CHECK_EQUAL(k.getName(), "/A");
+  BOOST_CHECK_THROW(k.getExclude(), tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(DecodeFromStream)
 {
   boost::iostreams::stream<boost::iostreams::array_source> is(
@@ -24,6 +24,7 @@
 #include "boost-test.hpp"
 #include <boost/tuple/tuple.hpp>
 #include <boost/mpl/vector.hpp>
+#include <sstream>
 #include <unordered_map>
 
 namespace ndn {
@@ -145,6 +146,72 @@ BOOST_AUTO_TEST_CASE(AppendsAndMultiEncode)
                                 TestName, TestName+sizeof(TestName));
 }
 
+BOOST_AUTO_TEST_CASE(AppendName)
+{
+  Name name("/local/ndn");
+  name.append(Name("/prefix"));
+  BOOST_CHECK_EQUAL_COLLECTIONS(name.wireEncode().begin(), name.wireEncode().end(),
+                                TestName, TestName+sizeof(TestName));
+
+  Name unencoded("/a");
+  unencoded.append("b");
+  BOOST_CHECK(!unencoded.hasWire());
+  name.append(unencoded);
+  BOOST_CHECK_EQUAL(name, Name("/local/ndn/prefix/a/b"));
+
+  name.append(name);
+  BOOST_CHECK_EQUAL(name, Name("/local/ndn/prefix/a/b/local/ndn/prefix/a/b"));
+
+  name.append(Name());
+  BOOST_CHECK_EQUAL(name.size(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(SubName)
+{
+  Name name("/local/ndn/prefix");
+  name.wireEncode();
+
+  Name prefix = name.getPrefix(-1);
+  BOOST_CHECK_EQUAL(prefix, Name("/local/ndn"));
+  BOOST_CHECK(prefix.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(prefix.wireEncode().begin(), prefix.wireEncode().end(),
+                                Name2, Name2 + sizeof(Name2));
+  // components reference the one buffer of the prefix
+  BOOST_CHECK(prefix[0].wire() + prefix[0].size() == prefix[1].wire());
+
+  BOOST_CHECK_EQUAL(name.getSubName(1, 1), Name("/ndn"));
+  BOOST_CHECK_EQUAL(name.getSubName(1), Name("/ndn/prefix"));
+  BOOST_CHECK_EQUAL(name.getSubName(0), name);
+  BOOST_CHECK_EQUAL(name.getSubName(3), Name());
+  BOOST_CHECK_EQUAL(name.getSubName(5, 2), Name());
+
+  Name unencoded("/local");
+  unencoded.append("ndn").append("prefix");
+  BOOST_CHECK_EQUAL(unencoded.getSubName(1, 1), Name("/ndn"));
+  BOOST_CHECK(unencoded.getPrefix(2).wireEncode() == prefix.wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(PrefixOf)
+{
+  Name name("/local/ndn/prefix");
+  Name unencoded("/local");
+  unencoded.append("ndn");
+
+  BOOST_CHECK(Name("/local/ndn").isPrefixOf(name));
+  BOOST_CHECK(unencoded.isPrefixOf(name));
+  BOOST_CHECK(Name().isPrefixOf(name));
+  BOOST_CHECK(name.isPrefixOf(name));
+  BOOST_CHECK(!Name("/local/nd").isPrefixOf(name));
+  BOOST_CHECK(!Name("/local/ndn/prefix/x").isPrefixOf(name));
+
+  // equal components behind a non-minimal TLV-LENGTH encoding
+  static const uint8_t NON_MINIMAL[] = {0x07, 0x09, 0x08, 0xfd, 0x00, 0x05,
+                                        0x6c, 0x6f, 0x63, 0x61, 0x6c};
+  Name nonMinimal(Block(NON_MINIMAL, sizeof(NON_MINIMAL)));
+  BOOST_CHECK(nonMinimal.isPrefixOf(name));
+  BOOST_CHECK_EQUAL(nonMinimal, Name("/local"));
+}
+
 BOOST_AUTO_TEST_CASE(ZeroLengthComponent)
 {
   static const uint8_t compOctets[] {0x08, 0x00};
@@ -345,6 +412,39 @@ BOOST_AUTO_TEST_CASE(UnorderedMap)
   BOOST_CHECK_EQUAL(map[name3], 3);
 }
 
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  std::hash<Name> hashName;
+
+  Name encoded("/local/ndn/prefix");
+  encoded.wireEncode();
+  Name unencoded("/local");
+  unencoded.append("ndn").append("prefix");
+  BOOST_CHECK_EQUAL(hashName(encoded), hashName(unencoded));
+  BOOST_CHECK_NE(hashName(encoded), hashName(Name("/local/ndn/prefiX")));
+  BOOST_CHECK_NE(hashName(Name("/a/b")), hashName(Name("/ab")));
+  BOOST_CHECK_NE(hashName(Name("/a/b")), hashName(Name("/b/a")));
+
+  std::hash<name::Component> hashComponent;
+  BOOST_CHECK_EQUAL(hashComponent(name::Component("0123456789")),
+                    hashComponent(name::Component(std::string("0123456789"))));
+  BOOST_CHECK_NE(hashComponent(name::Component("0123456789")),
+                 hashComponent(name::Component("0123456788")));
+  BOOST_CHECK_NE(hashComponent(name::Component("")),
+                 hashComponent(name::Component("0")));
+}
+
+BOOST_AUTO_TEST_CASE(PrefixHashes)
+{
+  Name name("/local/ndn/prefix/with/a/longer/name");
+  std::vector<size_t> hashes = name.getPrefixHashes();
+
+  BOOST_REQUIRE_EQUAL(hashes.size(), name.size() + 1);
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes[i], std::hash<Name>()(name.getPrefix(i)));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(ImplictSha256Digest)
 {
   Name n;
@@ -397,6 +497,78 @@ BOOST_AUTO_TEST_CASE(ImplictSha256Digest)
   BOOST_CHECK_NE(n.get(0), n2.get(1));
 }
 
+BOOST_AUTO_TEST_CASE(UriParsing)
+{
+  BOOST_CHECK_EQUAL(Name("ndn:/hello/world").toUri(), "/hello/world");
+  BOOST_CHECK_EQUAL(Name(" ndn: / hello / world / ").toUri(), "/hello/world");
+  BOOST_CHECK_EQUAL(Name("//authority/hello").toUri(), "/hello");
+  BOOST_CHECK_EQUAL(Name("ndn://authority").size(), 0);
+  BOOST_CHECK_EQUAL(Name("/a:b/c").toUri(), "/a%3Ab/c");
+  BOOST_CHECK_EQUAL(Name("").size(), 0);
+  BOOST_CHECK_EQUAL(Name("/").size(), 0);
+  BOOST_CHECK_THROW(Name("/hello//world"), name::Component::Error);
+
+  BOOST_CHECK_EQUAL(Name("/%41%2f%2F").get(0).toUri(), "A%2F%2F");
+  // invalid escapes are kept as they are
+  BOOST_CHECK_EQUAL(Name("/%G%41%4").get(0).toUri(), "%25G%2541%254");
+  BOOST_CHECK_EQUAL(Name("/.../....").toUri(), "/.../....");
+  BOOST_CHECK_EQUAL(Name("/...").get(0).value_size(), 0);
+  BOOST_CHECK_EQUAL(Name("/....").get(0).value_size(), 1);
+  BOOST_CHECK_THROW(Name("/hello/.."), name::Component::Error);
+  BOOST_CHECK_THROW(Name("/hello/./world"), name::Component::Error);
+
+  Name name("/local/ndn/prefix");
+  BOOST_CHECK(name.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(TestName, TestName + sizeof(TestName),
+                                name.wireEncode().begin(), name.wireEncode().end());
+
+  // long components need multi-octet TLV-LENGTH
+  std::string longValue(300, 'x');
+  Name longName("/" + longValue + "/%00");
+  BOOST_REQUIRE_EQUAL(longName.size(), 2);
+  BOOST_CHECK_EQUAL(longName.get(0).value_size(), 300);
+  BOOST_CHECK_EQUAL(longName.get(1).value_size(), 1);
+  BOOST_CHECK_EQUAL(longName.toUri(), "/" + longValue + "/%00");
+  BOOST_CHECK_EQUAL(Name(longName.wireEncode()), longName);
+}
+
+BOOST_AUTO_TEST_CASE(UriToBuffer)
+{
+  Name name("/hello/%00world");
+  std::string uri = name.toUri();
+  BOOST_CHECK_EQUAL(uri, "/hello/%00world");
+
+  char buffer[32];
+  BOOST_CHECK_EQUAL(name.toUri(buffer, sizeof(buffer)), uri.size());
+  BOOST_CHECK_EQUAL(std::string(buffer, uri.size()), uri);
+
+  // truncated output still reports the full length
+  std::fill(buffer, buffer + sizeof(buffer), '#');
+  BOOST_CHECK_EQUAL(name.toUri(buffer, 9), uri.size());
+  BOOST_CHECK_EQUAL(std::string(buffer, 10), "/hello/%0#");
+  BOOST_CHECK_EQUAL(name.toUri(nullptr, 0), uri.size());
+
+  BOOST_CHECK_EQUAL(Name().toUri(buffer, sizeof(buffer)), 1);
+  BOOST_CHECK_EQUAL(buffer[0], '/');
+
+  const name::Component& component = name.get(1);
+  BOOST_CHECK_EQUAL(component.toUri(buffer, 2), 8);
+  BOOST_CHECK_EQUAL(std::string(buffer, 2), "%0");
+
+  uint8_t value[16];
+  uint32_t type = 0;
+  BOOST_CHECK_EQUAL(name::Component::decodeUri("a%20b", 5, value, type), 3);
+  BOOST_CHECK_EQUAL(type, tlv::NameComponent);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<char*>(value), 3), "a b");
+
+  // a name longer than the stack buffer used by toUri() and operator<<
+  Name longName("/" + std::string(1000, 'x'));
+  std::ostringstream os;
+  os << longName;
+  BOOST_CHECK_EQUAL(os.str().size(), 1001);
+  BOOST_CHECK_EQUAL(longName.toUri(), os.str());
+}
+
 BOOST_AUTO_TEST_CASE(Compare)
 {
   BOOST_CHECK_EQUAL( 0, Name("/A")  .compare(Name("/A")));
@@ -409,6 +581,9 @@ BOOST_AUTO_TEST_CASE(Compare)
   BOOST_CHECK_EQUAL( 1, Name("/A/C").compare(Name("/A")));
 
   BOOST_CHECK_EQUAL( 0, Name("/Z/A/Y")  .compare(1, 1, Name("/A")));
+  BOOST_CHECK_EQUAL( 0, Name("/Z/A/Y")  .compare(3, 1, Name("/A"), 1));
+  BOOST_CHECK_THROW(Name("/Z/A/Y").compare(4, 1, Name("/A")), Name::Error);
+  BOOST_CHECK_THROW(Name("/Z/A/Y").compare(0, 1, Name("/A"), 2), Name::Error);
   BOOST_CHECK_EQUAL( 0, Name("/Z/A/Y")  .compare(1, 1, Name("/A")));
   BOOST_CHECK_EQUAL(-1, Name("/Z/A/Y")  .compare(1, 1, Name("/B")));
   BOOST_CHECK_EQUAL( 1, Name("/Z/B/Y")  .compare(1, 1, Name("/A")));
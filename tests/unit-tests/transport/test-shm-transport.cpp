@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "transport/shm-transport.hpp"
+#include "encoding/block-helpers.hpp"
+#include "util/monotonic_deadline_timer.hpp"
+
+#include "boost-test.hpp"
+
+#ifdef NDN_CXX_HAVE_SHM_TRANSPORT
+
+#include <boost/asio/io_service.hpp>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ndn {
+
+/**
+ * @brief Two connected ShmTransport endpoints that record what they receive
+ *
+ * The io_service stops once both endpoints have received the expected number of blocks,
+ * or fails the test case when they have not arrived within a deadline.
+ */
+class ShmTransportFixture
+{
+public:
+  ShmTransportFixture()
+    : nExpectedByFirst(0)
+    , nExpectedBySecond(0)
+  {
+  }
+
+  void
+  connect(const shared_ptr<ShmTransport>& first, const shared_ptr<ShmTransport>& second)
+  {
+    this->first = first;
+    this->second = second;
+    first->connect(io, bind(&ShmTransportFixture::onReceive, this, ref(receivedByFirst), _1));
+    second->connect(io, bind(&ShmTransportFixture::onReceive, this, ref(receivedBySecond), _1));
+  }
+
+  void
+  connectLoopback(size_t ringCapacity)
+  {
+    std::pair<shared_ptr<ShmTransport>, shared_ptr<ShmTransport>> endpoints =
+      ShmTransport::createLoopback(ringCapacity);
+    connect(endpoints.first, endpoints.second);
+  }
+
+  void
+  run(size_t nExpectedByFirst, size_t nExpectedBySecond)
+  {
+    this->nExpectedByFirst = nExpectedByFirst;
+    this->nExpectedBySecond = nExpectedBySecond;
+    stopIfDone();
+
+    // an endpoint that misses a wakeup would otherwise leave the io_service waiting forever
+    monotonic_deadline_timer timer(io);
+    timer.expires_from_now(time::seconds(5));
+    timer.async_wait([this] (const boost::system::error_code& error) {
+      if (error)
+        return;
+      BOOST_ERROR("io_service was not stopped within the deadline");
+      io.stop();
+    });
+    io.run();
+    io.reset();
+  }
+
+  static Block
+  makeBlock(size_t index, size_t size = 100)
+  {
+    std::vector<uint8_t> value(size, static_cast<uint8_t>(index));
+    std::memcpy(&value[0], &index, std::min(sizeof(index), size));
+    return dataBlock(tlv::Content, &value[0], value.size());
+  }
+
+private:
+  void
+  onReceive(std::vector<Block>& received, const Block& block)
+  {
+    received.push_back(block);
+    stopIfDone();
+  }
+
+  void
+  stopIfDone()
+  {
+    if (receivedByFirst.size() >= nExpectedByFirst &&
+        receivedBySecond.size() >= nExpectedBySecond)
+      io.stop();
+  }
+
+public:
+  boost::asio::io_service io;
+  shared_ptr<ShmTransport> first;
+  shared_ptr<ShmTransport> second;
+  std::vector<Block> receivedByFirst;
+  std::vector<Block> receivedBySecond;
+
+private:
+  size_t nExpectedByFirst;
+  size_t nExpectedBySecond;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TransportTestShmTransport, ShmTransportFixture)
+
+BOOST_AUTO_TEST_CASE(Loopback)
+{
+  connectLoopback(ShmTransport::DEFAULT_RING_CAPACITY);
+  BOOST_CHECK(first->isConnected());
+  BOOST_CHECK(first->isExpectingData());
+
+  first->send(makeBlock(1));
+  second->send(makeBlock(2));
+  second->send(makeBlock(3, 10), makeBlock(4, 20));
+  run(3, 1);
+
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), 1);
+  BOOST_CHECK(receivedBySecond[0] == makeBlock(1));
+
+  // header and payload travel in the same record, and are delivered as two blocks
+  BOOST_REQUIRE_EQUAL(receivedByFirst.size(), 3);
+  BOOST_CHECK(receivedByFirst[0] == makeBlock(2));
+  BOOST_CHECK(receivedByFirst[1] == makeBlock(3, 10));
+  BOOST_CHECK(receivedByFirst[2] == makeBlock(4, 20));
+
+  first->close();
+  second->close();
+  BOOST_CHECK(!first->isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(FullRing)
+{
+  // a 4 KiB ring holds only a few of these blocks, so the sender has to wait for the
+  // receiver repeatedly, and records wrap around the end of the ring many times
+  connectLoopback(4096);
+
+  static const size_t N_BLOCKS = 2000;
+  for (size_t i = 0; i < N_BLOCKS; ++i) {
+    first->send(makeBlock(i, 100 + (i * 37) % 1500));
+  }
+  run(0, N_BLOCKS);
+
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), N_BLOCKS);
+  for (size_t i = 0; i < N_BLOCKS; ++i) {
+    BOOST_CHECK(receivedBySecond[i] == makeBlock(i, 100 + (i * 37) % 1500));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SendBeforeConnect)
+{
+  std::pair<shared_ptr<ShmTransport>, shared_ptr<ShmTransport>> endpoints =
+    ShmTransport::createLoopback(4096);
+  endpoints.first->send(makeBlock(1));
+
+  connect(endpoints.first, endpoints.second);
+  run(0, 1);
+
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), 1);
+  BOOST_CHECK(receivedBySecond[0] == makeBlock(1));
+}
+
+BOOST_AUTO_TEST_CASE(PauseResume)
+{
+  connectLoopback(4096);
+
+  second->pause();
+  BOOST_CHECK(!second->isExpectingData());
+  first->send(makeBlock(1));
+  io.poll();
+  io.reset();
+  BOOST_CHECK_EQUAL(receivedBySecond.size(), 0);
+
+  second->resume();
+  run(0, 1);
+  BOOST_CHECK_EQUAL(receivedBySecond.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Reconnect)
+{
+  connectLoopback(4096);
+  first->send(makeBlock(1));
+  run(0, 1);
+
+  // the read on the eventfd that was pending when the transport was closed is cancelled,
+  // but its handler runs only after the transport is connected again
+  second->close();
+  BOOST_CHECK(!second->isConnected());
+  second->connect(io, [this] (const Block& block) {
+    receivedBySecond.push_back(block);
+    io.stop();
+  });
+  BOOST_CHECK(second->isConnected());
+
+  io.poll();
+  io.reset();
+  first->send(makeBlock(2));
+  run(0, 2);
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), 2);
+  BOOST_CHECK(receivedBySecond[1] == makeBlock(2));
+}
+
+BOOST_AUTO_TEST_CASE(TooLarge)
+{
+  connectLoopback(4096);
+
+  BOOST_CHECK_THROW(first->send(makeBlock(1, 4096)), Transport::Error);
+  BOOST_CHECK_NO_THROW(first->send(makeBlock(1, 1024)));
+}
+
+BOOST_AUTO_TEST_CASE(NamedSegment)
+{
+  std::string segmentName = "/ndn-cxx-test-shm-" + std::to_string(::getpid());
+  int firstEventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  int secondEventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  BOOST_REQUIRE(firstEventFd >= 0 && secondEventFd >= 0);
+
+  shared_ptr<ShmTransport> creator = ShmTransport::create(segmentName, 10000,
+                                                          firstEventFd, secondEventFd);
+  BOOST_CHECK_THROW(ShmTransport::create(segmentName, 10000, firstEventFd, secondEventFd),
+                    Transport::Error);
+  shared_ptr<ShmTransport> opener = ShmTransport::open(segmentName, secondEventFd, firstEventFd);
+
+  // the transports have their own copies of the eventfds
+  ::close(firstEventFd);
+  ::close(secondEventFd);
+
+  connect(creator, opener);
+  creator->send(makeBlock(1));
+  opener->send(makeBlock(2));
+  run(1, 1);
+  BOOST_REQUIRE_EQUAL(receivedByFirst.size(), 1);
+  BOOST_CHECK(receivedByFirst[0] == makeBlock(2));
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), 1);
+  BOOST_CHECK(receivedBySecond[0] == makeBlock(1));
+
+  // closing the creator unlinks the segment name
+  creator->close();
+  int fd = ::shm_open(segmentName.c_str(), O_RDONLY, 0);
+  BOOST_CHECK_LT(fd, 0);
+  if (fd >= 0)
+    ::close(fd);
+}
+
+BOOST_AUTO_TEST_CASE(OpenInvalid)
+{
+  int eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  BOOST_REQUIRE(eventFd >= 0);
+
+  std::string segmentName = "/ndn-cxx-test-shm-invalid-" + std::to_string(::getpid());
+  BOOST_CHECK_THROW(ShmTransport::open(segmentName, eventFd, eventFd), Transport::Error);
+
+  int fd = ::shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  BOOST_REQUIRE(fd >= 0);
+  BOOST_REQUIRE_EQUAL(::ftruncate(fd, 65536), 0);
+  ::close(fd);
+  BOOST_CHECK_THROW(ShmTransport::open(segmentName, eventFd, eventFd), Transport::Error);
+
+  ::shm_unlink(segmentName.c_str());
+  ::close(eventFd);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+
+#endif // NDN_CXX_HAVE_SHM_TRANSPORT
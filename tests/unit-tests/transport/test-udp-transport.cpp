@@ -0,0 +1,371 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "transport/udp-transport.hpp"
+#include "encoding/block-helpers.hpp"
+#include "encoding/encoding-buffer.hpp"
+#include "util/monotonic_deadline_timer.hpp"
+#include "transport-fixture.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/multicast.hpp>
+#include <boost/asio/ip/udp.hpp>
+
+#include <poll.h>
+
+namespace ndn {
+
+namespace ip = boost::asio::ip;
+
+/**
+ * @brief Two UdpTransport endpoints that record what they receive
+ *
+ * The io_service stops once both endpoints have received the expected number of blocks,
+ * or fails the test case when they have not arrived within a deadline.
+ */
+class UdpTransportFixture
+{
+public:
+  UdpTransportFixture()
+    : nExpectedByFirst(0)
+    , nExpectedBySecond(0)
+  {
+  }
+
+  void
+  connect(const shared_ptr<UdpTransport>& first, const shared_ptr<UdpTransport>& second)
+  {
+    this->first = first;
+    this->second = second;
+    first->connect(io, bind(&UdpTransportFixture::onReceive, this, ref(receivedByFirst), _1));
+    second->connect(io, bind(&UdpTransportFixture::onReceive, this, ref(receivedBySecond), _1));
+  }
+
+  void
+  connectLoopback()
+  {
+    std::pair<shared_ptr<UdpTransport>, shared_ptr<UdpTransport>> endpoints =
+      UdpTransport::createLoopback();
+    connect(endpoints.first, endpoints.second);
+  }
+
+  void
+  run(size_t nExpectedByFirst, size_t nExpectedBySecond)
+  {
+    this->nExpectedByFirst = nExpectedByFirst;
+    this->nExpectedBySecond = nExpectedBySecond;
+    stopIfDone();
+    runUntilStopped();
+  }
+
+  /** @brief runs the io_service until a handler stops it
+   *
+   *  A datagram lost on the way would otherwise leave the io_service waiting forever.
+   */
+  void
+  runUntilStopped()
+  {
+    monotonic_deadline_timer timer(io);
+    timer.expires_from_now(time::seconds(5));
+    timer.async_wait([this] (const boost::system::error_code& error) {
+      if (error)
+        return;
+      BOOST_ERROR("io_service was not stopped within the deadline");
+      io.stop();
+    });
+    io.run();
+    io.reset();
+  }
+
+  /** @brief joins @p group on the loopback interface with an ephemeral port
+   *
+   *  @p socket keeps the port while it is open, and members that bind to it as well need
+   *  SO_REUSEADDR.
+   *
+   *  @return the port, or 0 if a datagram sent to the group over the loopback interface
+   *          does not come back, e.g. because that interface does not support multicast
+   */
+  uint16_t
+  joinLoopbackGroup(ip::udp::socket& socket, const ip::address_v4& group)
+  {
+    try {
+      socket.open(ip::udp::v4());
+      socket.set_option(ip::udp::socket::reuse_address(true));
+      socket.bind(ip::udp::endpoint(group, 0));
+      socket.set_option(ip::multicast::join_group(group, ip::address_v4::loopback()));
+      uint16_t port = socket.local_endpoint().port();
+
+      ip::udp::socket sender(io, ip::udp::v4());
+      sender.set_option(ip::multicast::outbound_interface(ip::address_v4::loopback()));
+      sender.set_option(ip::multicast::enable_loopback(true));
+      static const uint8_t PROBE[] = {0x00};
+      sender.send_to(boost::asio::buffer(PROBE), ip::udp::endpoint(group, port));
+
+      pollfd pfd = {socket.native_handle(), POLLIN, 0};
+      if (::poll(&pfd, 1, 1000) != 1)
+        return 0;
+      uint8_t buffer[sizeof(PROBE)];
+      socket.receive(boost::asio::buffer(buffer));
+      return port;
+    }
+    catch (const boost::system::system_error&) {
+      return 0;
+    }
+  }
+
+  static Block
+  makeBlock(size_t index, size_t size = 100)
+  {
+    std::vector<uint8_t> value(size, static_cast<uint8_t>(index));
+    std::memcpy(&value[0], &index, std::min(sizeof(index), size));
+    return dataBlock(tlv::Content, &value[0], value.size());
+  }
+
+private:
+  void
+  onReceive(std::vector<Block>& received, const Block& block)
+  {
+    received.push_back(block);
+    stopIfDone();
+  }
+
+  void
+  stopIfDone()
+  {
+    if (receivedByFirst.size() >= nExpectedByFirst &&
+        receivedBySecond.size() >= nExpectedBySecond)
+      io.stop();
+  }
+
+public:
+  boost::asio::io_service io;
+  shared_ptr<UdpTransport> first;
+  shared_ptr<UdpTransport> second;
+  std::vector<Block> receivedByFirst;
+  std::vector<Block> receivedBySecond;
+
+private:
+  size_t nExpectedByFirst;
+  size_t nExpectedBySecond;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TransportTestUdpTransport, UdpTransportFixture)
+
+BOOST_AUTO_TEST_CASE(Loopback)
+{
+  connectLoopback();
+  BOOST_CHECK(first->isConnected());
+  BOOST_CHECK(first->isExpectingData());
+
+  first->send(makeBlock(1));
+  first->send(makeBlock(2, 3000));
+
+  // the header is an outer TLV whose length covers the payload sent with it
+  Block payload = makeBlock(3);
+  EncodingBuffer encoder;
+  encoder.prependVarNumber(payload.size());
+  encoder.prependVarNumber(tlv::Content);
+  second->send(encoder.block(false), payload);
+  run(1, 2);
+
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), 2);
+  BOOST_CHECK(receivedBySecond[0] == makeBlock(1));
+  BOOST_CHECK(receivedBySecond[1] == makeBlock(2, 3000));
+
+  // header and payload travel in the same datagram
+  BOOST_REQUIRE_EQUAL(receivedByFirst.size(), 1);
+  BOOST_CHECK_EQUAL(receivedByFirst[0].type(), tlv::Content);
+  BOOST_CHECK_EQUAL(receivedByFirst[0].value_size(), payload.size());
+
+  first->close();
+  second->close();
+  BOOST_CHECK(!first->isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(ManyDatagrams)
+{
+  // more blocks than fit into one batch, all queued before the io_service runs
+  connectLoopback();
+
+  static const size_t N_BLOCKS = 100;
+  for (size_t i = 0; i < N_BLOCKS; ++i) {
+    first->send(makeBlock(i, 100 + (i * 37) % 900));
+  }
+  run(0, N_BLOCKS);
+
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), N_BLOCKS);
+  for (size_t i = 0; i < N_BLOCKS; ++i) {
+    BOOST_CHECK(receivedBySecond[i] == makeBlock(i, 100 + (i * 37) % 900));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SendBeforeConnect)
+{
+  std::pair<shared_ptr<UdpTransport>, shared_ptr<UdpTransport>> endpoints =
+    UdpTransport::createLoopback();
+  endpoints.first->send(makeBlock(1));
+
+  connect(endpoints.first, endpoints.second);
+  run(0, 1);
+
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), 1);
+  BOOST_CHECK(receivedBySecond[0] == makeBlock(1));
+}
+
+BOOST_AUTO_TEST_CASE(PauseResume)
+{
+  connectLoopback();
+
+  second->pause();
+  BOOST_CHECK(!second->isExpectingData());
+  first->send(makeBlock(1));
+  io.poll();
+  io.reset();
+  BOOST_CHECK_EQUAL(receivedBySecond.size(), 0);
+
+  second->resume();
+  run(0, 1);
+  BOOST_CHECK_EQUAL(receivedBySecond.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Reconnect)
+{
+  connectLoopback();
+  first->close();
+  first->connect(io, [this] (const Block& block) { receivedByFirst.push_back(block); });
+
+  first->send(makeBlock(1));
+  run(0, 1);
+  BOOST_CHECK_EQUAL(receivedBySecond.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TooLarge)
+{
+  connectLoopback();
+
+  BOOST_CHECK_THROW(first->send(makeBlock(1, MAX_NDN_PACKET_SIZE)), Transport::Error);
+  BOOST_CHECK_NO_THROW(first->send(makeBlock(1, MAX_NDN_PACKET_SIZE - 4)));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidDatagrams)
+{
+  ip::udp::socket peer(io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  UdpTransport transport("127.0.0.1", std::to_string(peer.local_endpoint().port()));
+  transport.connect(io, [this] (const Block& block) {
+    receivedByFirst.push_back(block);
+    io.stop();
+  });
+
+  // each block is sent as one datagram
+  transport.send(makeBlock(1));
+  io.run_one();
+  io.reset();
+  std::vector<uint8_t> buffer(MAX_NDN_PACKET_SIZE);
+  ip::udp::endpoint transportEndpoint;
+  size_t nOctets = peer.receive_from(boost::asio::buffer(buffer), transportEndpoint);
+  BOOST_CHECK(Block(&buffer[0], nOctets) == makeBlock(1));
+
+  // datagrams that are not exactly one block are dropped
+  static const uint8_t GARBAGE[] = {0xFF, 0xFF};
+  peer.send_to(boost::asio::buffer(GARBAGE), transportEndpoint);
+  Block block = makeBlock(2);
+  std::vector<uint8_t> twoBlocks(block.begin(), block.end());
+  twoBlocks.insert(twoBlocks.end(), block.begin(), block.end());
+  peer.send_to(boost::asio::buffer(twoBlocks), transportEndpoint);
+  peer.send_to(boost::asio::buffer(block.wire(), block.size() - 1), transportEndpoint);
+  peer.send_to(boost::asio::buffer(makeBlock(3).wire(), makeBlock(3).size()), transportEndpoint);
+  runUntilStopped();
+
+  BOOST_REQUIRE_EQUAL(receivedByFirst.size(), 1);
+  BOOST_CHECK(receivedByFirst[0] == makeBlock(3));
+}
+
+BOOST_AUTO_TEST_CASE(Multicast)
+{
+  ip::address_v4 group = ip::address_v4::from_string("239.255.70.77");
+  ip::udp::socket probe(io);
+  uint16_t groupPort = joinLoopbackGroup(probe, group);
+  if (groupPort == 0) {
+    BOOST_TEST_MESSAGE("Loopback interface does not support multicast, skipping the test case");
+    return;
+  }
+
+  std::string port = std::to_string(groupPort);
+  connect(make_shared<UdpTransport>("239.255.70.77", port, "127.0.0.1"),
+          make_shared<UdpTransport>("239.255.70.77", port, "127.0.0.1"));
+
+  first->send(makeBlock(1));
+  second->send(makeBlock(2));
+  run(1, 1);
+
+  // each member receives the datagrams of the other, but not its own
+  io.poll();
+  BOOST_REQUIRE_EQUAL(receivedByFirst.size(), 1);
+  BOOST_CHECK(receivedByFirst[0] == makeBlock(2));
+  BOOST_REQUIRE_EQUAL(receivedBySecond.size(), 1);
+  BOOST_CHECK(receivedBySecond[0] == makeBlock(1));
+}
+
+BOOST_AUTO_TEST_CASE(ConnectError)
+{
+  UdpTransport transport("127.0.0.1", "6363", "::1");
+  BOOST_CHECK_THROW(transport.connect(io, [] (const Block&) {}), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_FIXTURE_TEST_CASE(GetDefaultSocketHostAndPortOk, TransportFixture)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/udp-transport/ok");
+
+  const auto got = UdpTransport::getDefaultSocketHostAndPort(*m_config);
+
+  BOOST_CHECK_EQUAL(got.first, "127.0.0.1");
+  BOOST_CHECK_EQUAL(got.second, "6000");
+}
+
+BOOST_FIXTURE_TEST_CASE(GetDefaultSocketHostAndPortOkOmittedPort, TransportFixture)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/udp-transport/ok-omitted-port");
+
+  const auto got = UdpTransport::getDefaultSocketHostAndPort(*m_config);
+
+  BOOST_CHECK_EQUAL(got.first, "127.0.0.1");
+  BOOST_CHECK_EQUAL(got.second, "6363");
+}
+
+BOOST_FIXTURE_TEST_CASE(GetDefaultSocketHostAndPortBadWrongTransport, TransportFixture)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/udp-transport/bad-wrong-transport");
+
+  BOOST_CHECK_EXCEPTION(UdpTransport::getDefaultSocketHostAndPort(*m_config),
+                        Transport::Error,
+                        [] (const Transport::Error& error) {
+                          return error.what() == std::string("Cannot create UdpTransport "
+                                                             "from \"tcp\" URI");
+                        });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
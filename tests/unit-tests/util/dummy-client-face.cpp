@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "../test-make-interest-data.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(UtilDummyClientFace, ndn::tests::UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  shared_ptr<DummyClientFace> face = makeDummyClientFace(io, {false, false});
+
+  face->expressInterest(Interest("/A"), bind([] {}), bind([] {}));
+  face->expressInterest(Interest("/B"), bind([] {}), bind([] {}));
+  face->put(*makeData("/C"));
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(face->nSentInterests, 2);
+  BOOST_CHECK_EQUAL(face->nSentDatas, 1);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 0);
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PacketLogLimit)
+{
+  shared_ptr<DummyClientFace> face = makeDummyClientFace(io, {true, false, 4});
+
+  for (int i = 0; i < 10; ++i) {
+    face->put(*makeData(Name("/A").appendNumber(i)));
+  }
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(face->nSentDatas, 10);
+  BOOST_REQUIRE_LE(face->sentDatas.size(), 4);
+  BOOST_REQUIRE_GE(face->sentDatas.size(), 2);
+  BOOST_CHECK_EQUAL(face->sentDatas.back().getName(), Name("/A").appendNumber(9));
+  BOOST_CHECK_EQUAL(face->sentDatas.front().getName(),
+                    Name("/A").appendNumber(10 - face->sentDatas.size()));
+}
+
+BOOST_AUTO_TEST_CASE(Link)
+{
+  shared_ptr<DummyClientFace> consumer = makeDummyClientFace(io);
+  shared_ptr<DummyClientFace> producer = makeDummyClientFace(io);
+  consumer->linkTo(*producer);
+
+  int nInterests = 0;
+  producer->setInterestFilter("/", [&] (const InterestFilter&, const Interest& interest) {
+    ++nInterests;
+    producer->put(*makeData(Name(interest.getName()).append("data")));
+  });
+
+  int nData = 0;
+  consumer->expressInterest(Interest("/A/1"),
+                            [&] (const Interest&, const Data& data) {
+                              BOOST_CHECK_EQUAL(data.getName(), "/A/1/data");
+                              ++nData;
+                            },
+                            bind([] { BOOST_ERROR("Unexpected timeout"); }));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nInterests, 1);
+  BOOST_CHECK_EQUAL(nData, 1);
+  BOOST_CHECK_EQUAL(consumer->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(producer->sentDatas.size(), 1);
+
+  // Interests under /localhost, such as prefix registration commands, are not delivered
+  consumer->expressInterest(Interest("/localhost/nfd/rib/register", time::milliseconds(100)),
+                            bind([] { BOOST_ERROR("Unexpected data"); }),
+                            bind([] {}));
+  advanceClocks(time::milliseconds(10), 20);
+  BOOST_CHECK_EQUAL(consumer->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(nInterests, 1);
+
+  // packets are dropped after the other face is destroyed
+  producer.reset();
+  consumer->expressInterest(Interest("/A/2", time::milliseconds(100)),
+                            bind([] { BOOST_ERROR("Unexpected data"); }),
+                            bind([] {}));
+  advanceClocks(time::milliseconds(10), 20);
+  BOOST_CHECK_EQUAL(consumer->nSentInterests, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/latency-histogram.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(UtilLatencyHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMin(), time::nanoseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getMax(), time::nanoseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::nanoseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), time::nanoseconds::zero());
+}
+
+BOOST_AUTO_TEST_CASE(Samples)
+{
+  LatencyHistogram histogram;
+  for (int i = 1; i <= 100; ++i) {
+    histogram.add(time::microseconds(i));
+  }
+  histogram.add(time::nanoseconds(-5));
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 101);
+  BOOST_CHECK_EQUAL(histogram.getMin(), time::nanoseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getMax(), time::microseconds(100));
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::nanoseconds(5050000 / 101));
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(0), 1);
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(9), 1); // 1us
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(10), 1); // 2us
+
+  // a percentile is within a factor of two above the exact value
+  time::nanoseconds p50 = histogram.getPercentile(50);
+  BOOST_CHECK_GE(p50, time::microseconds(50));
+  BOOST_CHECK_LE(p50, time::microseconds(100));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(100), time::microseconds(100));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(0), time::nanoseconds(2)); // bucket 0 is [0, 2)
+
+  histogram.reset();
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(9), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Print)
+{
+  LatencyHistogram histogram;
+  histogram.add(time::nanoseconds(1000));
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(histogram),
+                    "count=1 min=1000ns mean=1000ns max=1000ns "
+                    "p50<=1000ns p90<=1000ns p99<=1000ns p99.9<=1000ns");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/load-generator.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+class LoadGeneratorFixture : public ndn::tests::UnitTestTimeFixture
+{
+public:
+  LoadGeneratorFixture()
+    : consumerFace(makeDummyClientFace(io, {false, false}))
+    , producerFace(makeDummyClientFace(io, {false, false}))
+    , options(LoadGenerator::DEFAULT_OPTIONS)
+    , nFinished(0)
+  {
+    consumerFace->linkTo(*producerFace);
+    options.interestRate = 10000;
+    options.nInterests = 100;
+    options.interestLifetime = time::milliseconds(100);
+    options.contentSize = 100;
+  }
+
+public:
+  shared_ptr<DummyClientFace> consumerFace;
+  shared_ptr<DummyClientFace> producerFace;
+  LoadGenerator::Options options;
+  int nFinished;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilLoadGenerator, LoadGeneratorFixture)
+
+BOOST_AUTO_TEST_CASE(Loopback)
+{
+  LoadGenerator generator(options);
+  generator.startProducer(*producerFace);
+  generator.startConsumer(*consumerFace, [this] { ++nFinished; });
+
+  // 10 Interests per millisecond
+  advanceClocks(time::microseconds(500), 1);
+  BOOST_CHECK_GE(generator.getNSentInterests(), 1);
+  BOOST_CHECK_LE(generator.getNSentInterests(), 11);
+
+  advanceClocks(time::milliseconds(1), 20);
+  BOOST_CHECK_EQUAL(nFinished, 1);
+  BOOST_CHECK_EQUAL(generator.getNSentInterests(), 100);
+  BOOST_CHECK_EQUAL(generator.getNServedInterests(), 100);
+  BOOST_CHECK_EQUAL(generator.getNReceivedData(), 100);
+  BOOST_CHECK_EQUAL(generator.getNTimeouts(), 0);
+  BOOST_CHECK_EQUAL(generator.getLatencies().getCount(), 100);
+  BOOST_CHECK_LE(generator.getLatencies().getMax(), time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(consumerFace->nSentInterests, 100);
+  BOOST_CHECK_EQUAL(producerFace->nSentDatas, 100);
+}
+
+BOOST_AUTO_TEST_CASE(Timeout)
+{
+  LoadGenerator generator(options);
+  generator.startConsumer(*consumerFace, [this] { ++nFinished; });
+
+  advanceClocks(time::milliseconds(10), 20);
+  BOOST_CHECK_EQUAL(nFinished, 1);
+  BOOST_CHECK_EQUAL(generator.getNReceivedData(), 0);
+  BOOST_CHECK_EQUAL(generator.getNTimeouts(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(Stop)
+{
+  options.nInterests = 0;
+  LoadGenerator generator(options);
+  generator.startProducer(*producerFace);
+  generator.startConsumer(*consumerFace);
+
+  advanceClocks(time::milliseconds(1), 10);
+  generator.stop();
+  uint64_t nSent = generator.getNSentInterests();
+  uint64_t nReceived = generator.getNReceivedData();
+  BOOST_CHECK_GT(nSent, 50);
+
+  advanceClocks(time::milliseconds(10), 20);
+  BOOST_CHECK_EQUAL(generator.getNSentInterests(), nSent);
+  BOOST_CHECK_EQUAL(generator.getNReceivedData(), nReceived);
+  BOOST_CHECK_EQUAL(generator.getNTimeouts(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidRate)
+{
+  options.interestRate = 0;
+  LoadGenerator generator(options);
+  BOOST_CHECK_THROW(generator.startConsumer(*consumerFace), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -62,19 +62,23 @@ BOOST_AUTO_TEST_SUITE(UtilNotificationSubscriber)
 class EndToEndFixture : public ndn::tests::UnitTestTimeFixture
 {
 public:
-  EndToEndFixture()
+  explicit
+  EndToEndFixture(size_t windowSize = 1)
     : streamPrefix("ndn:/NotificationSubscriberTest")
     , publisherFace(makeDummyClientFace(io))
     , notificationStream(*publisherFace, streamPrefix, publisherKeyChain)
     , subscriberFace(makeDummyClientFace(io))
-    , subscriber(*subscriberFace, streamPrefix, time::seconds(1))
+    , subscriber(*subscriberFace, streamPrefix, time::seconds(1), windowSize)
+    , lastDeliveredSeqNo(0)
+    , hasTimeout(false)
   {
   }
 
-  /** \brief post one notification and deliver to subscriber
+  /** \brief post one notification without delivering it to subscriber
+   *  \return Data packet carrying the notification
    */
-  void
-  deliverNotification(const std::string& msg)
+  Data
+  publishNotification(const std::string& msg)
   {
     publisherFace->sentDatas.clear();
     SimpleNotification notification(msg);
@@ -83,17 +87,33 @@ public:
     advanceClocks(time::milliseconds(1));
 
     BOOST_REQUIRE_EQUAL(publisherFace->sentDatas.size(), 1);
+    return publisherFace->sentDatas[0];
+  }
+
+  /** \brief post one notification and deliver to subscriber
+   */
+  void
+  deliverNotification(const std::string& msg)
+  {
+    Data data = this->publishNotification(msg);
 
-    lastDeliveredSeqNo = publisherFace->sentDatas[0].getName().at(-1).toSequenceNumber();
+    lastDeliveredSeqNo = data.getName().at(-1).toSequenceNumber();
 
     lastNotification.setMessage("");
-    subscriberFace->receive(publisherFace->sentDatas[0]);
+    subscriberFace->receive(data);
   }
 
   void
   afterNotification(const SimpleNotification& notification)
   {
     lastNotification = notification;
+    receivedMessages.push_back(notification.getMessage());
+  }
+
+  void
+  afterGap(uint64_t seqNo)
+  {
+    gaps.push_back(seqNo);
   }
 
   void
@@ -123,6 +143,20 @@ public:
            interest.getInterestLifetime() == subscriber.getInterestLifetime();
   }
 
+  /** \return sequence numbers of continuation requests sent from subscriberFace
+   */
+  std::set<uint64_t>
+  getRequestSeqNos() const
+  {
+    std::set<uint64_t> seqNos;
+    for (const Interest& interest : subscriberFace->sentInterests) {
+      const Name& name = interest.getName();
+      if (streamPrefix.isPrefixOf(name) && name.size() == streamPrefix.size() + 1)
+        seqNos.insert(name[-1].toSequenceNumber());
+    }
+    return seqNos;
+  }
+
   /** \return sequence number of the continuation request sent from subscriberFace
    *          or 0 if there's no such request as sole sent Interest
    */
@@ -154,6 +188,8 @@ protected:
   uint64_t lastDeliveredSeqNo;
 
   SimpleNotification lastNotification;
+  std::vector<std::string> receivedMessages;
+  std::vector<uint64_t> gaps;
   bool hasTimeout;
   Data lastDecodeErrorData;
 };
@@ -234,6 +270,103 @@ BOOST_FIXTURE_TEST_CASE(EndToEnd, EndToEndFixture)
   BOOST_CHECK_EQUAL(subscriberFace->sentInterests.size(), 0);
 }
 
+class PipelinedFixture : public EndToEndFixture
+{
+public:
+  PipelinedFixture()
+    : EndToEndFixture(3)
+  {
+    subscriber.onNotification.connect(bind(&EndToEndFixture::afterNotification, this, _1));
+    subscriber.onTimeout.connect(bind(&EndToEndFixture::afterTimeout, this));
+    subscriber.onGap.connect(bind(&EndToEndFixture::afterGap, this, _1));
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(Pipelined, PipelinedFixture)
+{
+  BOOST_CHECK_EQUAL(subscriber.getWindowSize(), 3);
+
+  subscriber.start();
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK(this->hasInitialRequest());
+
+  // reply to initial request opens the window
+  subscriberFace->sentInterests.clear();
+  this->deliverNotification("n0");
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(lastNotification.getMessage(), "n0");
+  BOOST_CHECK((this->getRequestSeqNos() ==
+               std::set<uint64_t>{lastDeliveredSeqNo + 1, lastDeliveredSeqNo + 2,
+                                  lastDeliveredSeqNo + 3}));
+
+  Data d1 = this->publishNotification("n1");
+  Data d2 = this->publishNotification("n2");
+  Data d3 = this->publishNotification("n3");
+
+  // out-of-order arrival is buffered
+  subscriberFace->sentInterests.clear();
+  receivedMessages.clear();
+  subscriberFace->receive(d2);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK(receivedMessages.empty());
+  BOOST_CHECK(subscriberFace->sentInterests.empty());
+
+  // in-order delivery once the missing notification arrives, window slides by two
+  subscriberFace->receive(d1);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK((receivedMessages == std::vector<std::string>{"n1", "n2"}));
+  BOOST_CHECK((this->getRequestSeqNos() ==
+               std::set<uint64_t>{lastDeliveredSeqNo + 4, lastDeliveredSeqNo + 5}));
+
+  // n3 is lost, n4 and n5 arrive: gap is reported when n3's Interest times out
+  Data d4 = this->publishNotification("n4");
+  Data d5 = this->publishNotification("n5");
+  subscriberFace->sentInterests.clear();
+  receivedMessages.clear();
+  subscriberFace->receive(d4);
+  subscriberFace->receive(d5);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK(receivedMessages.empty());
+  BOOST_CHECK(gaps.empty());
+
+  advanceClocks(time::milliseconds(100), 11);
+  BOOST_CHECK((receivedMessages == std::vector<std::string>{"n4", "n5"}));
+  BOOST_CHECK((gaps == std::vector<uint64_t>{d3.getName().at(-1).toSequenceNumber()}));
+  BOOST_CHECK_EQUAL(hasTimeout, false);
+}
+
+BOOST_FIXTURE_TEST_CASE(StartOverWithBufferedNotifications, PipelinedFixture)
+{
+  subscriber.start();
+  advanceClocks(time::milliseconds(1));
+  this->deliverNotification("n0");
+  advanceClocks(time::milliseconds(1));
+  uint64_t seqNo0 = lastDeliveredSeqNo;
+
+  Data d1 = this->publishNotification("n1");
+  Data d2 = this->publishNotification("n2");
+
+  // the reply to the Interest for n1 is named after n2, so the Interest for n1 is satisfied
+  // in the Face but remains outstanding in the subscriber, and n2 stays buffered
+  subscriberFace->receive(d2);
+  Name misnamed = d1.getName();
+  misnamed.appendSequenceNumber(seqNo0 + 2);
+  Data misnamedData(misnamed);
+  misnamedData.setContent(d2.getContent());
+  publisherKeyChain.sign(misnamedData);
+  subscriberFace->receive(misnamedData);
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(receivedMessages.size(), 1);
+
+  // the Interest for n3 times out, and buffered n2 is delivered before starting over
+  subscriberFace->sentInterests.clear();
+  advanceClocks(time::milliseconds(100), 11);
+  BOOST_CHECK((receivedMessages == std::vector<std::string>{"n0", "n2"}));
+  BOOST_CHECK((gaps == std::vector<uint64_t>{seqNo0 + 1}));
+  BOOST_CHECK_EQUAL(hasTimeout, true);
+  BOOST_CHECK(this->hasInitialRequest());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/sha256-backend.hpp"
+#include "util/crypto.hpp"
+#include "util/string-helper.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace crypto {
+namespace tests {
+
+using namespace ndn::crypto::detail;
+
+BOOST_AUTO_TEST_SUITE(UtilSha256Backend)
+
+typedef void (*HashFunction)(const uint8_t*, size_t, uint8_t*);
+
+static std::string
+hashToHex(HashFunction hash, const std::string& input)
+{
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  hash(reinterpret_cast<const uint8_t*>(input.data()), input.size(), digest);
+  return toHex(digest, sizeof(digest));
+}
+
+static void
+checkKnownVectors(HashFunction hash)
+{
+  // FIPS 180-2 test vectors
+  BOOST_CHECK_EQUAL(hashToHex(hash, ""),
+                    "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855");
+  BOOST_CHECK_EQUAL(hashToHex(hash, "abc"),
+                    "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD");
+  BOOST_CHECK_EQUAL(hashToHex(hash, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+                    "248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1");
+  BOOST_CHECK_EQUAL(hashToHex(hash, std::string(1000000, 'a')),
+                    "CDC76E5C9914FB9281A1C7E284D73E67F1809A48A497200E046D39CCC7112CD0");
+}
+
+/// @brief deterministic input with lengths that cover all cases of the padding
+class Sha256InputFixture
+{
+public:
+  Sha256InputFixture()
+    : buffer(4096)
+  {
+    for (size_t i = 0; i < buffer.size(); ++i) {
+      buffer[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+    }
+  }
+
+  std::vector<uint8_t>
+  expectedDigest(size_t offset, size_t length) const
+  {
+    std::vector<uint8_t> digest(SHA256_DIGEST_SIZE);
+    sha256Generic(&buffer[offset], length, &digest[0]);
+    return digest;
+  }
+
+  /**
+   * @brief hash @p nBuffers buffers of different offsets and lengths with @p hashMany,
+   *        and compare the results with the generic implementation
+   */
+  template<typename HashMany>
+  void
+  checkMultiBuffer(size_t nBuffers, const HashMany& hashMany)
+  {
+    std::vector<const uint8_t*> data(nBuffers);
+    std::vector<size_t> dataLength(nBuffers);
+    std::vector<std::vector<uint8_t>> digests(nBuffers, std::vector<uint8_t>(SHA256_DIGEST_SIZE));
+    std::vector<uint8_t*> digestPtrs(nBuffers);
+    for (size_t i = 0; i < nBuffers; ++i) {
+      data[i] = &buffer[i * 13];
+      dataLength[i] = (i * 389) % 1500;
+      digestPtrs[i] = &digests[i][0];
+    }
+
+    hashMany(nBuffers, data.data(), dataLength.data(), digestPtrs.data());
+
+    for (size_t i = 0; i < nBuffers; ++i) {
+      std::vector<uint8_t> expected = expectedDigest(i * 13, dataLength[i]);
+      BOOST_CHECK_EQUAL_COLLECTIONS(digests[i].begin(), digests[i].end(),
+                                    expected.begin(), expected.end());
+    }
+  }
+
+public:
+  std::vector<uint8_t> buffer;
+};
+
+BOOST_AUTO_TEST_CASE(Generic)
+{
+  checkKnownVectors(&sha256Generic);
+}
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  BOOST_TEST_MESSAGE("SHA-256 implementation: " << getSha256Implementation());
+  checkKnownVectors(&crypto::sha256);
+
+  ConstBufferPtr digest = crypto::sha256(reinterpret_cast<const uint8_t*>("abc"), 3);
+  BOOST_CHECK_EQUAL(toHex(digest->buf(), digest->size()),
+                    "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD");
+}
+
+BOOST_FIXTURE_TEST_CASE(ShaNi, Sha256InputFixture)
+{
+  if (!hasShaNi()) {
+    BOOST_TEST_MESSAGE("CPU does not support SHA-NI, skipping");
+    return;
+  }
+
+  checkKnownVectors(&sha256ShaNi);
+
+  for (size_t length = 0; length < 300; ++length) {
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256ShaNi(&buffer[length], length, digest);
+    std::vector<uint8_t> expected = expectedDigest(length, length);
+    BOOST_CHECK_EQUAL_COLLECTIONS(digest, digest + sizeof(digest),
+                                  expected.begin(), expected.end());
+  }
+
+  checkMultiBuffer(2, [] (size_t, const uint8_t* const* data, const size_t* dataLength,
+                          uint8_t* const* digests) {
+    sha256ShaNiX2(data, dataLength, digests);
+  });
+}
+
+BOOST_FIXTURE_TEST_CASE(Avx2, Sha256InputFixture)
+{
+  if (!hasAvx2()) {
+    BOOST_TEST_MESSAGE("CPU does not support AVX2, skipping");
+    return;
+  }
+
+  for (size_t nBuffers = 1; nBuffers <= SHA256_AVX2_LANES; ++nBuffers) {
+    checkMultiBuffer(nBuffers, &sha256Avx2);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(MultiBuffer, Sha256InputFixture)
+{
+  void (*hashMany)(size_t, const uint8_t* const*, const size_t*, uint8_t* const*) =
+    &crypto::sha256;
+
+  for (size_t nBuffers = 0; nBuffers <= 19; ++nBuffers) {
+    checkMultiBuffer(nBuffers, hashMany);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace crypto
+} // namespace ndn
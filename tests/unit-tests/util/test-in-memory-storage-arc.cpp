@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-arc.hpp"
+
+#include "boost-test.hpp"
+#include "../test-make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(Arc)
+
+static shared_ptr<Data>
+makeNumberedData(const std::string& prefix, int i)
+{
+  return makeData(Name(prefix).appendNumber(i));
+}
+
+BOOST_AUTO_TEST_CASE(RecencyAndFrequency)
+{
+  InMemoryStorageArc ims(4);
+
+  shared_ptr<Data> data1 = makeNumberedData("/a", 1);
+  shared_ptr<Data> data2 = makeNumberedData("/a", 2);
+  ims.insert(*data1);
+  ims.insert(*data2);
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::T1), 2);
+
+  // an access moves the packet to T2
+  ims.find(data1->getName());
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::T1), 1);
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::T2), 1);
+
+  // T1 is above its target size of 0, so its LRU packet is evicted and leaves a ghost in B1
+  BOOST_CHECK(ims.evictItem());
+  BOOST_CHECK(ims.find(data2->getName()) == nullptr);
+  BOOST_CHECK(ims.find(data1->getName()) != nullptr);
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::B1), 1);
+
+  // re-inserting the evicted packet enlarges T1, and puts the packet in T2
+  ims.insert(*data2);
+  BOOST_CHECK_EQUAL(ims.getTargetT1Size(), 1);
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::B1), 0);
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::T2), 2);
+
+  // erased packets leave no ghost
+  ims.erase(data2->getName());
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::T2), 1);
+  BOOST_CHECK_EQUAL(ims.getListSize(InMemoryStorageArc::B2), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  InMemoryStorageArc ims(10);
+
+  // a working set of 5 packets, each accessed twice
+  std::vector<shared_ptr<Data>> hot;
+  for (int i = 0; i < 5; ++i) {
+    hot.push_back(makeNumberedData("/hot", i));
+    ims.insert(*hot.back());
+    ims.find(hot.back()->getName());
+  }
+
+  // a scan of 100 packets that are never accessed again
+  for (int i = 0; i < 100; ++i) {
+    ims.insert(*makeNumberedData("/scan", i));
+  }
+
+  BOOST_CHECK_EQUAL(ims.size(), 10);
+  for (const shared_ptr<Data>& data : hot) {
+    BOOST_CHECK(ims.find(data->getName()) != nullptr);
+  }
+
+  // ghosts are bounded by the limit
+  BOOST_CHECK_LE(ims.getListSize(InMemoryStorageArc::T1) +
+                 ims.getListSize(InMemoryStorageArc::B1), 10);
+  BOOST_CHECK_LE(ims.size() + ims.getListSize(InMemoryStorageArc::B1) +
+                 ims.getListSize(InMemoryStorageArc::B2), 20);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptToRecency)
+{
+  InMemoryStorageArc ims(4);
+
+  // two packets in T2
+  for (int i = 0; i < 2; ++i) {
+    shared_ptr<Data> data = makeNumberedData("/frequent", i);
+    ims.insert(*data);
+    ims.find(data->getName());
+  }
+
+  // a loop that does not fit into the rest of the storage keeps hitting ghosts in B1
+  std::vector<shared_ptr<Data>> packets;
+  for (int i = 0; i < 4; ++i) {
+    packets.push_back(makeNumberedData("/loop", i));
+  }
+  for (int round = 0; round < 2; ++round) {
+    for (const shared_ptr<Data>& data : packets) {
+      if (ims.find(data->getName()) == nullptr)
+        ims.insert(*data);
+    }
+  }
+
+  BOOST_CHECK_GT(ims.getTargetT1Size(), 0);
+  BOOST_CHECK_LE(ims.getTargetT1Size(), 4);
+  BOOST_CHECK_EQUAL(ims.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(ByteLimitOnly)
+{
+  InMemoryStorageArc ims(std::numeric_limits<size_t>::max());
+  size_t packetSize = makeNumberedData("/scan", 999)->wireEncode().size();
+  ims.setByteLimit(10 * packetSize);
+
+  for (int i = 0; i < 1000; ++i) {
+    ims.insert(*makeNumberedData("/scan", i));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 10);
+
+  // ghosts are bounded by the resident packets, rather than by the unlimited packet limit
+  BOOST_CHECK_LE(ims.getListSize(InMemoryStorageArc::T1) +
+                 ims.getListSize(InMemoryStorageArc::B1), 10);
+  BOOST_CHECK_LE(ims.size() + ims.getListSize(InMemoryStorageArc::B1) +
+                 ims.getListSize(InMemoryStorageArc::B2), 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Arc
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace util
+} // namespace ndn
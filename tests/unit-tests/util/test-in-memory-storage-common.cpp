@@ -23,10 +23,12 @@
 #include "util/in-memory-storage-fifo.hpp"
 #include "util/in-memory-storage-lfu.hpp"
 #include "util/in-memory-storage-lru.hpp"
+#include "util/in-memory-storage-arc.hpp"
 #include "security/key-chain.hpp"
 
 #include "boost-test.hpp"
 #include "../test-make-interest-data.hpp"
+#include "../unit-test-time-fixture.hpp"
 
 #include <boost/mpl/list.hpp>
 
@@ -38,7 +40,7 @@ BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
 BOOST_AUTO_TEST_SUITE(Common)
 
 typedef boost::mpl::list<InMemoryStoragePersistent, InMemoryStorageFifo, InMemoryStorageLfu,
-                         InMemoryStorageLru> InMemoryStorages;
+                         InMemoryStorageLru, InMemoryStorageArc> InMemoryStorages;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(Insertion, T, InMemoryStorages)
 {
@@ -629,8 +631,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ExcludeSelector, T, InMemoryStorages)
   BOOST_CHECK_EQUAL(found3->getName(), "/c/a");
 }
 
-typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru>
-                         InMemoryStoragesLimited;
+typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru,
+                         InMemoryStorageArc> InMemoryStoragesLimited;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(setCapacity, T, InMemoryStoragesLimited)
 {
@@ -699,6 +701,189 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndEvict, T, InMemoryStoragesLimited)
   BOOST_CHECK(!static_cast<bool>(found));
 }
 
+static shared_ptr<Data>
+makeDataWithContent(const Name& name, size_t contentSize)
+{
+  shared_ptr<Data> data = make_shared<Data>(name);
+  std::vector<uint8_t> content(contentSize, 0xBB);
+  data->setContent(content.data(), content.size());
+  return signData(data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ByteLimit, T, InMemoryStoragesLimited)
+{
+  T ims;
+  BOOST_CHECK_EQUAL(ims.getByteLimit(), std::numeric_limits<size_t>::max());
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 0);
+
+  size_t packetSize = makeDataWithContent("/byte/0", 1000)->wireEncode().size();
+  ims.setByteLimit(3 * packetSize);
+
+  for (int i = 0; i < 5; ++i) {
+    ims.insert(*makeDataWithContent(Name("/byte").appendNumber(i), 1000));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 3 * packetSize);
+  BOOST_CHECK_EQUAL(ims.getPeakNBytes(), 3 * packetSize);
+  BOOST_CHECK_EQUAL(ims.getNEvictions(), 2);
+
+  // a larger packet evicts as many packets as needed
+  shared_ptr<Data> large = makeDataWithContent("/byte/large", 1500);
+  ims.insert(*large);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), packetSize + large->wireEncode().size());
+  BOOST_CHECK_EQUAL(ims.getNEvictions(), 4);
+
+  // a packet that can never fit is not inserted
+  ims.insert(*makeDataWithContent("/byte/huge", 4000));
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK(ims.find(Name("/byte/huge")) == nullptr);
+
+  ims.erase("/byte");
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 0);
+  BOOST_CHECK_EQUAL(ims.getPeakNBytes(), 3 * packetSize);
+  BOOST_CHECK_EQUAL(ims.getNEvictions(), 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ReduceByteLimit, T, InMemoryStoragesLimited)
+{
+  T ims;
+  for (int i = 0; i < 4; ++i) {
+    ims.insert(*makeDataWithContent(Name("/byte").appendNumber(i), 500));
+  }
+  size_t packetSize = ims.getNBytes() / 4;
+
+  ims.setByteLimit(2 * packetSize + 1);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 2 * packetSize);
+  BOOST_CHECK_EQUAL(ims.getNEvictions(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ByteLimitPersistent)
+{
+  InMemoryStoragePersistent ims;
+  shared_ptr<Data> data = makeDataWithContent("/byte/0", 1000);
+  ims.setByteLimit(data->wireEncode().size());
+
+  ims.insert(*data);
+  ims.insert(*makeDataWithContent("/byte/1", 1000));
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK(ims.find(Name("/byte/1")) == nullptr);
+
+  ims.erase("/byte/0");
+  ims.insert(*makeDataWithContent("/byte/1", 1000));
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK_EQUAL(ims.getNEvictions(), 0);
+}
+
+static shared_ptr<Data>
+makeDataWithFreshness(const Name& name, const time::milliseconds& freshnessPeriod)
+{
+  shared_ptr<Data> data = make_shared<Data>(name);
+  data->setFreshnessPeriod(freshnessPeriod);
+  return signData(data);
+}
+
+static shared_ptr<Interest>
+makeMustBeFreshInterest(const Name& name, int childSelector = 0)
+{
+  shared_ptr<Interest> interest = makeInterest(name);
+  interest->setMustBeFresh(true);
+  interest->setChildSelector(childSelector);
+  return interest;
+}
+
+BOOST_FIXTURE_TEST_SUITE(Freshness, ndn::tests::UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MustBeFresh, T, InMemoryStorages)
+{
+  T ims;
+
+  shared_ptr<Data> data1 = makeDataWithFreshness("/fresh/1", time::seconds(1));
+  ims.insert(*data1);
+  ims.insert(*makeData("/fresh/2")); // no FreshnessPeriod, never stale
+
+  BOOST_CHECK(ims.find(*makeMustBeFreshInterest("/fresh/1")) != nullptr);
+  BOOST_CHECK(ims.find(*makeMustBeFreshInterest(data1->getFullName())) != nullptr);
+
+  advanceClocks(time::milliseconds(1000));
+  BOOST_CHECK(ims.find(*makeMustBeFreshInterest("/fresh/1")) == nullptr);
+  BOOST_CHECK(ims.find(*makeMustBeFreshInterest(data1->getFullName())) == nullptr);
+  BOOST_CHECK(ims.find(*makeInterest("/fresh/1")) != nullptr);
+  BOOST_CHECK(ims.find(*makeMustBeFreshInterest("/fresh/2")) != nullptr);
+
+  // a stale rightmost child is skipped
+  ims.insert(*makeDataWithFreshness("/fresh/3", time::milliseconds(10)));
+  advanceClocks(time::milliseconds(10));
+  shared_ptr<const Data> found = ims.find(*makeMustBeFreshInterest("/fresh", 1));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), "/fresh/2");
+  found = ims.find(makeInterest("/fresh")->setChildSelector(1));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), "/fresh/3");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(EvictStaleFirst, T, InMemoryStoragesLimited)
+{
+  T ims(3);
+
+  ims.insert(*makeDataWithFreshness("/stale", time::milliseconds(100)));
+  ims.insert(*makeData("/a"));
+  ims.insert(*makeData("/b"));
+  advanceClocks(time::milliseconds(100));
+
+  // the stale packet is the most recently and most frequently used,
+  // yet it is evicted before any packet chosen by the replacement policy
+  for (int i = 0; i < 3; ++i) {
+    ims.find(Name("/stale"));
+  }
+  ims.insert(*makeData("/c"));
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK(ims.find(Name("/stale")) == nullptr);
+  BOOST_CHECK_EQUAL(ims.getNStaleEvictions(), 1);
+  BOOST_CHECK_EQUAL(ims.getNEvictions(), 0);
+
+  ims.insert(*makeData("/d"));
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK_EQUAL(ims.getNStaleEvictions(), 1);
+  BOOST_CHECK_EQUAL(ims.getNEvictions(), 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(StaleSweep, T, InMemoryStoragesLimited)
+{
+  T ims(io, 10);
+
+  ims.insert(*makeDataWithFreshness("/stale", time::milliseconds(100)));
+  ims.insert(*makeDataWithFreshness("/fresh", time::seconds(10)));
+  ims.insert(*makeData("/a"));
+
+  advanceClocks(time::milliseconds(100), 9);
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+
+  advanceClocks(time::milliseconds(100));
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK(ims.find(Name("/stale")) == nullptr);
+  BOOST_CHECK_EQUAL(ims.getNStaleEvictions(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(PersistentEraseStale)
+{
+  InMemoryStoragePersistent ims;
+  ims.insert(*makeDataWithFreshness("/stale", time::milliseconds(100)));
+  ims.insert(*makeData("/a"));
+  advanceClocks(time::milliseconds(100));
+
+  // stale packets are not removed to make room
+  BOOST_CHECK_EQUAL(ims.evictStaleItem(), false);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+
+  ims.eraseStale();
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK(ims.find(Name("/a")) != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Freshness
+
 ///as Find function is implemented at the base case, therefore testing for one derived class is
 ///sufficient for all
 class FindFixture
@@ -0,0 +1,293 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-disk.hpp"
+
+#include "boost-test.hpp"
+#include "../test-make-interest-data.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+namespace ndn {
+namespace util {
+
+class InMemoryStorageDiskFixture
+{
+public:
+  InMemoryStorageDiskFixture()
+    : directory((boost::filesystem::temp_directory_path() /
+                 boost::filesystem::unique_path("ndn-cxx-ims-disk-%%%%-%%%%")).string())
+  {
+  }
+
+  ~InMemoryStorageDiskFixture()
+  {
+    boost::filesystem::remove_all(directory);
+  }
+
+  static shared_ptr<Data>
+  makeSegment(const Name& prefix, int segment, time::milliseconds freshnessPeriod)
+  {
+    shared_ptr<Data> data = make_shared<Data>(Name(prefix).appendSegment(segment));
+    std::vector<uint8_t> content(100 + segment, static_cast<uint8_t>(segment));
+    data->setContent(content.data(), content.size());
+    data->setFreshnessPeriod(freshnessPeriod);
+    return signData(data);
+  }
+
+public:
+  std::string directory;
+};
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_FIXTURE_TEST_SUITE(Disk, InMemoryStorageDiskFixture)
+
+BOOST_AUTO_TEST_CASE(SpillToDisk)
+{
+  InMemoryStorageDisk storage(directory, 2);
+
+  std::vector<shared_ptr<Data>> segments;
+  for (int i = 0; i < 10; ++i) {
+    segments.push_back(makeSegment("/video", i, time::milliseconds(-1)));
+    storage.insert(*segments.back());
+  }
+  storage.insert(*segments.front());
+
+  BOOST_CHECK_EQUAL(storage.size(), 10);
+  BOOST_CHECK_EQUAL(storage.getRamCache().size(), 2);
+
+  // segment 0 was dropped from RAM, and is read back from the segment log
+  shared_ptr<const Data> found = storage.find(Name("/video").appendSegment(0));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK(found->wireEncode() == segments[0]->wireEncode());
+  BOOST_CHECK_EQUAL(storage.getNDiskReads(), 1);
+
+  // and is cached in RAM again
+  storage.find(Name("/video").appendSegment(0));
+  BOOST_CHECK_EQUAL(storage.getNDiskReads(), 1);
+
+  BOOST_CHECK(storage.find(Name("/audio")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Selectors)
+{
+  InMemoryStorageDisk storage(directory, 1);
+
+  for (int i = 0; i < 5; ++i) {
+    storage.insert(*makeSegment("/a", i, time::milliseconds(-1)));
+    storage.insert(*makeSegment("/b", i, time::milliseconds(-1)));
+  }
+  storage.insert(*makeSegment(Name("/a").appendSegment(4), 0, time::milliseconds(-1)));
+
+  shared_ptr<const Data> found = storage.find(Interest("/a"));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), Name("/a").appendSegment(0));
+
+  // leftmost packet of the rightmost child
+  found = storage.find(Interest("/a").setChildSelector(1));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), Name("/a").appendSegment(4));
+
+  found = storage.find(Interest("/a").setChildSelector(1).setMaxSuffixComponents(2));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), Name("/a").appendSegment(4));
+
+  found = storage.find(Interest("/a").setChildSelector(1).setMinSuffixComponents(3));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), Name("/a").appendSegment(4).appendSegment(0));
+
+  found = storage.find(Interest("/").setChildSelector(1));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), Name("/b").appendSegment(0));
+
+  // exact match by full name
+  shared_ptr<Data> segment = makeSegment("/b", 2, time::milliseconds(-1));
+  found = storage.find(Interest(segment->getFullName()));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), segment->getName());
+
+  BOOST_CHECK(storage.find(Interest("/c")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(MustBeFresh)
+{
+  InMemoryStorageDisk storage(directory, 10);
+  storage.insert(*makeSegment("/a", 0, time::milliseconds(0)));
+  storage.insert(*makeSegment("/a", 1, time::milliseconds(100000)));
+
+  shared_ptr<const Data> found = storage.find(Interest("/a").setMustBeFresh(true));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), Name("/a").appendSegment(1));
+
+  found = storage.find(Interest("/a"));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), Name("/a").appendSegment(0));
+}
+
+BOOST_AUTO_TEST_CASE(Reopen)
+{
+  std::vector<shared_ptr<Data>> segments;
+  {
+    InMemoryStorageDisk storage(directory, 10);
+    for (int i = 0; i < 1000; ++i) {
+      segments.push_back(makeSegment("/video", i, time::milliseconds(i % 2 == 0 ? -1 : 100000)));
+      storage.insert(*segments.back());
+    }
+    storage.erase(segments[1]->getFullName(), false);
+    storage.erase(Name("/video").appendSegment(2));
+    storage.flush();
+    BOOST_CHECK_EQUAL(storage.size(), 998);
+  }
+
+  InMemoryStorageDisk storage(directory, 10);
+  BOOST_CHECK_EQUAL(storage.size(), 998);
+  BOOST_CHECK_EQUAL(storage.getRamCache().size(), 0);
+  BOOST_CHECK(storage.find(Name("/video").appendSegment(1)) == nullptr);
+  BOOST_CHECK(storage.find(Name("/video").appendSegment(2)) == nullptr);
+
+  for (int i = 3; i < 1000; i += 99) {
+    shared_ptr<const Data> found = storage.find(Interest(Name("/video").appendSegment(i))
+                                                  .setMustBeFresh(true));
+    BOOST_REQUIRE(found != nullptr);
+    BOOST_CHECK(found->wireEncode() == segments[i]->wireEncode());
+  }
+
+  // appending continues after the packets of the previous session
+  uint64_t logSize = storage.getLogSize();
+  storage.insert(*makeSegment("/audio", 0, time::milliseconds(-1)));
+  BOOST_CHECK_GT(storage.getLogSize(), logSize);
+  BOOST_CHECK(storage.find(Name("/video").appendSegment(999))->wireEncode() ==
+              segments[999]->wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedIndex)
+{
+  shared_ptr<Data> last = makeSegment("/a", 1, time::milliseconds(-1));
+  {
+    InMemoryStorageDisk storage(directory, 10);
+    storage.insert(*makeSegment("/a", 0, time::milliseconds(-1)));
+    storage.insert(*last);
+  }
+
+  // the last index record was written only partially
+  boost::filesystem::path index = boost::filesystem::path(directory) /
+                                  InMemoryStorageDisk::INDEX_FILENAME;
+  boost::filesystem::resize_file(index, boost::filesystem::file_size(index) - 3);
+
+  {
+    InMemoryStorageDisk storage(directory, 10);
+    BOOST_CHECK_EQUAL(storage.size(), 1);
+    BOOST_CHECK(storage.find(last->getName()) == nullptr);
+    storage.insert(*last);
+  }
+
+  InMemoryStorageDisk storage(directory, 10);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_REQUIRE(storage.find(last->getName()) != nullptr);
+  BOOST_CHECK(storage.find(last->getName())->wireEncode() == last->wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(ZeroedLogTail)
+{
+  shared_ptr<Data> last = makeSegment("/a", 2, time::milliseconds(-1));
+  {
+    InMemoryStorageDisk storage(directory, 10);
+    storage.insert(*makeSegment("/a", 0, time::milliseconds(-1)));
+    storage.insert(*makeSegment("/a", 1, time::milliseconds(-1)));
+    storage.insert(*last);
+  }
+
+  // the index records reached the disk, but the last packet did not,
+  // and the segment log had been extended ahead of its content
+  boost::filesystem::path log = boost::filesystem::path(directory) /
+                                InMemoryStorageDisk::LOG_FILENAME;
+  uintmax_t logSize = boost::filesystem::file_size(log);
+  boost::filesystem::resize_file(log, logSize - last->wireEncode().size());
+  boost::filesystem::resize_file(log, logSize + 4096);
+
+  {
+    InMemoryStorageDisk storage(directory, 10);
+    BOOST_CHECK_EQUAL(storage.size(), 3);
+    BOOST_CHECK(storage.find(Interest(last->getName())) == nullptr);
+    BOOST_CHECK_EQUAL(storage.size(), 2);
+    BOOST_CHECK(storage.find(last->getName()) == nullptr);
+
+    shared_ptr<const Data> found = storage.find(Interest("/a").setChildSelector(1));
+    BOOST_REQUIRE(found != nullptr);
+    BOOST_CHECK_EQUAL(found->getName(), Name("/a").appendSegment(1));
+  }
+
+  InMemoryStorageDisk storage(directory, 10);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK(storage.find(last->getName()) == nullptr);
+  BOOST_CHECK(storage.find(Name("/a").appendSegment(0)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CorruptedContent)
+{
+  shared_ptr<Data> segment = makeSegment("/a", 1, time::milliseconds(-1));
+  {
+    InMemoryStorageDisk storage(directory, 10);
+    storage.insert(*makeSegment("/a", 0, time::milliseconds(-1)));
+    storage.insert(*segment);
+  }
+
+  // one octet of the content of segment 1 did not reach the disk, but the packet still decodes
+  boost::filesystem::path log = boost::filesystem::path(directory) /
+                                InMemoryStorageDisk::LOG_FILENAME;
+  std::vector<uint8_t> octets(boost::filesystem::file_size(log));
+  {
+    std::ifstream is(log.string(), std::ios::binary);
+    is.read(reinterpret_cast<char*>(octets.data()), octets.size());
+  }
+  const Block& content = segment->getContent();
+  std::vector<uint8_t>::iterator found = std::search(octets.begin(), octets.end(),
+                                                  content.value_begin(), content.value_end());
+  BOOST_REQUIRE(found != octets.end());
+  found[content.value_size() / 2] ^= 0x40;
+  {
+    std::ofstream os(log.string(), std::ios::binary | std::ios::in);
+    os.write(reinterpret_cast<const char*>(octets.data()), octets.size());
+  }
+
+  InMemoryStorageDisk storage(directory, 10);
+  BOOST_CHECK(storage.find(segment->getName()) == nullptr);
+  BOOST_CHECK(storage.find(Interest(segment->getName())) == nullptr);
+  BOOST_CHECK_EQUAL(storage.size(), 1);
+  BOOST_CHECK(storage.find(Name("/a").appendSegment(0)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(OpenError)
+{
+  boost::filesystem::create_directories(directory);
+  boost::filesystem::create_directory(boost::filesystem::path(directory) /
+                                      InMemoryStorageDisk::LOG_FILENAME);
+  BOOST_CHECK_THROW(InMemoryStorageDisk storage(directory), InMemoryStorageDisk::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Disk
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace util
+} // namespace ndn
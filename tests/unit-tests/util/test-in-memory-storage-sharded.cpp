@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-sharded.hpp"
+#include "util/in-memory-storage-fifo.hpp"
+
+#include "boost-test.hpp"
+#include "../test-make-interest-data.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(Sharded)
+
+BOOST_AUTO_TEST_CASE(ShardByKey)
+{
+  InMemoryStorageSharded storage(2, std::numeric_limits<size_t>::max(), 8);
+  BOOST_CHECK_EQUAL(storage.getNShards(), 8);
+
+  // the components after the key do not change the shard
+  BOOST_CHECK_EQUAL(storage.getShardIndex("/a/b/c/d"), storage.getShardIndex("/a/b"));
+  BOOST_CHECK_EQUAL(storage.getShardIndex("/a/b/e"), storage.getShardIndex("/a/b"));
+
+  size_t shardIndex = 0;
+  BOOST_CHECK(storage.findShard("/a/b/c", shardIndex));
+  BOOST_CHECK_EQUAL(shardIndex, storage.getShardIndex("/a/b"));
+  BOOST_CHECK(!storage.findShard("/a", shardIndex));
+
+  // the Data packet named /a is in the shard of /a, even though its full name is longer
+  shared_ptr<Data> data = makeData("/a");
+  BOOST_CHECK(storage.findShard(data->getFullName(), shardIndex));
+  BOOST_CHECK_EQUAL(shardIndex, storage.getShardIndex("/a"));
+}
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  InMemoryStorageSharded storage(2, std::numeric_limits<size_t>::max(), 8);
+
+  std::vector<shared_ptr<Data>> packets;
+  for (int i = 0; i < 20; ++i) {
+    packets.push_back(makeData(Name("/a").appendNumber(i).appendSegment(0)));
+    storage.insert(*packets.back());
+  }
+  shared_ptr<Data> short1 = makeData("/a");
+  storage.insert(*short1);
+  BOOST_CHECK_EQUAL(storage.size(), 21);
+
+  for (const shared_ptr<Data>& data : packets) {
+    BOOST_CHECK_EQUAL(storage.find(data->getName()), data);
+    BOOST_CHECK_EQUAL(storage.find(Interest(data->getFullName())), data);
+  }
+  BOOST_CHECK_EQUAL(storage.find(Interest(short1->getFullName())), short1);
+
+  // lookups shorter than the key visit every shard
+  BOOST_CHECK_EQUAL(storage.find(Name("/a")), short1);
+  BOOST_CHECK_EQUAL(storage.find(Interest("/a")), short1);
+  BOOST_CHECK_EQUAL(storage.find(Interest("/a").setChildSelector(1)), packets[19]);
+  BOOST_CHECK_EQUAL(storage.find(Interest("/a").setMinSuffixComponents(3)), packets[0]);
+  BOOST_CHECK(storage.find(Interest("/b")) == nullptr);
+
+  storage.erase(Name("/a").appendNumber(3));
+  BOOST_CHECK(storage.find(packets[3]->getName()) == nullptr);
+  storage.erase(short1->getFullName(), false);
+  BOOST_CHECK_EQUAL(storage.find(Interest("/a")), packets[0]);
+  storage.erase("/a");
+  BOOST_CHECK_EQUAL(storage.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PerShardEviction)
+{
+  InMemoryStorageSharded storage(1, 8, 4, [] (size_t limit) {
+    return unique_ptr<InMemoryStorage>(new InMemoryStorageFifo(limit));
+  });
+
+  // every packet falls into the shard of /hot, which holds 2 packets
+  for (int i = 0; i < 10; ++i) {
+    storage.insert(*makeData(Name("/hot").appendSegment(i)));
+  }
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK(storage.find(Name("/hot").appendSegment(7)) == nullptr);
+  BOOST_CHECK(storage.find(Name("/hot").appendSegment(9)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(EraseStale)
+{
+  boost::asio::io_service io;
+  BOOST_CHECK_THROW(InMemoryStorageSharded(1, 8, 4, [&io] (size_t limit) {
+                      return unique_ptr<InMemoryStorage>(new InMemoryStorageFifo(io, limit));
+                    }),
+                    std::invalid_argument);
+
+  InMemoryStorageSharded storage(1);
+  for (int i = 0; i < 10; ++i) {
+    shared_ptr<Data> data = make_shared<Data>(Name("/a").appendNumber(i));
+    data->setFreshnessPeriod(time::milliseconds(i % 2 == 0 ? 0 : 100000));
+    storage.insert(*signData(data));
+  }
+  BOOST_CHECK_EQUAL(storage.size(), 10);
+
+  storage.eraseStale();
+  BOOST_CHECK_EQUAL(storage.size(), 5);
+  BOOST_CHECK(storage.find(Name("/a").appendNumber(0)) == nullptr);
+  BOOST_CHECK(storage.find(Name("/a").appendNumber(1)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Concurrent)
+{
+  static const int N_THREADS = 4;
+  static const int N_PACKETS = 500;
+
+  InMemoryStorageSharded storage(2);
+
+  std::vector<std::vector<shared_ptr<Data>>> packets(N_THREADS);
+  for (int t = 0; t < N_THREADS; ++t) {
+    for (int i = 0; i < N_PACKETS; ++i) {
+      packets[t].push_back(makeData(Name("/producer").appendNumber(t * N_PACKETS + i)
+                                                     .appendSegment(0)));
+      packets[t].back()->getFullName();
+    }
+  }
+
+  std::vector<int> nFound(N_THREADS, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < N_THREADS; ++t) {
+    threads.push_back(std::thread([&, t] {
+      for (const shared_ptr<Data>& data : packets[t]) {
+        storage.insert(*data);
+        nFound[t] += storage.find(Interest(data->getName())) == data;
+      }
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(storage.size(), N_THREADS * N_PACKETS);
+  for (int t = 0; t < N_THREADS; ++t) {
+    BOOST_CHECK_EQUAL(nFound[t], N_PACKETS);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Sharded
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace util
+} // namespace ndn
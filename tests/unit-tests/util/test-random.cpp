@@ -25,6 +25,8 @@
 #include <boost/mpl/vector.hpp>
 
 #include <cmath>
+#include <set>
+#include <thread>
 
 namespace ndn {
 
@@ -50,6 +52,30 @@ public:
   }
 };
 
+class PseudoRandomWords32
+{
+public:
+  static uint32_t
+  generate()
+  {
+    uint32_t words[3];
+    random::generateWords32(words, 3);
+    return words[2];
+  }
+};
+
+class PseudoRandomWords64
+{
+public:
+  static uint64_t
+  generate()
+  {
+    uint64_t words[3];
+    random::generateWords64(words, 3);
+    return words[2];
+  }
+};
+
 class SecureRandomWord32
 {
 public:
@@ -72,6 +98,8 @@ public:
 
 typedef boost::mpl::vector<PseudoRandomWord32,
                            PseudoRandomWord64,
+                           PseudoRandomWords32,
+                           PseudoRandomWords64,
                            SecureRandomWord32,
                            SecureRandomWord64> RandomGenerators;
 
@@ -106,6 +134,24 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GoodnessOfFit, RandomGenerator, RandomGenerators)
   BOOST_WARN_LE(t, 0.230);
 }
 
+BOOST_AUTO_TEST_CASE(PerThreadState)
+{
+  const size_t N_WORDS = 64;
+  std::vector<uint64_t> words1(N_WORDS);
+  std::vector<uint64_t> words2(N_WORDS);
+
+  std::thread thread1([&words1] { random::generateWords64(words1.data(), words1.size()); });
+  std::thread thread2([&words2] { random::generateWords64(words2.data(), words2.size()); });
+  thread1.join();
+  thread2.join();
+
+  // threads are seeded independently
+  BOOST_CHECK(words1 != words2);
+
+  std::set<uint64_t> uniqueWords(words1.begin(), words1.end());
+  BOOST_CHECK_EQUAL(uniqueWords.size(), N_WORDS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -47,10 +47,7 @@ printCertificate(ndn::KeyChain& keyChain,
 }
 
 void
-printKey(ndn::KeyChain& keyChain,
-         const ndn::Name& keyName,
-         bool isDefault,
-         int verboseLevel)
+printKey(const ndn::Name& keyName, bool isDefault)
 {
   if (isDefault)
     std::cout << "  +->* ";
@@ -58,26 +55,10 @@ printKey(ndn::KeyChain& keyChain,
     std::cout << "  +->  ";
 
   std::cout << keyName << std::endl;
-
-  if (verboseLevel >= 2) {
-    std::vector<ndn::Name> defaultCertificates;
-    keyChain.getAllCertificateNamesOfKey(keyName, defaultCertificates, true);
-
-    for (const auto& certName : defaultCertificates)
-      printCertificate(keyChain, certName, true, verboseLevel);
-
-    std::vector<ndn::Name> otherCertificates;
-    keyChain.getAllCertificateNamesOfKey(keyName, otherCertificates, false);
-    for (const auto& certName : otherCertificates)
-      printCertificate(keyChain, certName, false, verboseLevel);
-  }
 }
 
 void
-printIdentity(ndn::KeyChain& keyChain,
-              const ndn::Name& identity,
-              bool isDefault,
-              int verboseLevel)
+printIdentity(const ndn::Name& identity, bool isDefault)
 {
   if (isDefault)
     std::cout << "* ";
@@ -85,21 +66,6 @@ printIdentity(ndn::KeyChain& keyChain,
     std::cout << "  ";
 
   std::cout << identity << std::endl;
-
-  if (verboseLevel >= 1) {
-    std::vector<ndn::Name> defaultKeys;
-    keyChain.getAllKeyNamesOfIdentity(identity, defaultKeys, true);
-    for (const auto& keyName : defaultKeys)
-      printKey(keyChain, keyName, true, verboseLevel);
-
-    std::vector<ndn::Name> otherKeys;
-    keyChain.getAllKeyNamesOfIdentity(identity, otherKeys, false);
-    for (const auto& keyName : otherKeys) {
-      printKey(keyChain, keyName, false, verboseLevel);
-    }
-
-    std::cout << std::endl;
-  }
 }
 
 int
@@ -156,18 +122,52 @@ ndnsec_list(int argc, char** argv)
 
   KeyChain keyChain;
 
-  std::vector<Name> defaultIdentities;
-  keyChain.getAllIdentities(defaultIdentities, true);
-  for (const auto& identity : defaultIdentities) {
-    printIdentity(keyChain, identity, true, verboseLevel);
-  }
+  if (verboseLevel == 0) {
+    // identity names alone do not need the join over keys and certificates
+    std::vector<Name> defaultIdentities;
+    keyChain.getAllIdentities(defaultIdentities, true);
+    for (const auto& identity : defaultIdentities) {
+      printIdentity(identity, true);
+    }
 
-  std::vector<Name> otherIdentities;
-  keyChain.getAllIdentities(otherIdentities, false);
-  for (const auto& identity : otherIdentities) {
-    printIdentity(keyChain, identity, false, verboseLevel);
+    std::vector<Name> otherIdentities;
+    keyChain.getAllIdentities(otherIdentities, false);
+    for (const auto& identity : otherIdentities) {
+      printIdentity(identity, false);
+    }
+    return 0;
   }
 
+  // the PIB is read in a single pass, in which the entries of each identity and of each key
+  // are consecutive, and defaults come first
+  Name identity;
+  Name keyName;
+  bool hasIdentity = false;
+  keyChain.enumerateAll([&] (const SecPublicInfo::PibEntry& entry) {
+    if (!hasIdentity || entry.identity != identity) {
+      if (hasIdentity)
+        std::cout << std::endl;
+      identity = entry.identity;
+      keyName.clear();
+      hasIdentity = true;
+      printIdentity(identity, entry.isDefaultIdentity);
+    }
+
+    if (entry.keyName.empty())
+      return;
+    if (entry.keyName != keyName) {
+      keyName = entry.keyName;
+      printKey(keyName, entry.isDefaultKey);
+    }
+
+    if (verboseLevel < 2 || entry.certificateName.empty())
+      return;
+    printCertificate(keyChain, entry.certificateName, entry.isDefaultCertificate, verboseLevel);
+  });
+
+  if (hasIdentity)
+    std::cout << std::endl;
+
   return 0;
 }
 
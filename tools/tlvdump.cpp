@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2014 Regents of the University of California.
+ * Copyright (c) 2013-2015 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -23,11 +23,21 @@
 
 #include "face.hpp"
 #include "encoding/block.hpp"
+#include "encoding/block-stream-reader.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <fstream>
 #include <map>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace ndn {
 
 std::map<uint32_t, std::string> TLV_DICT = {
@@ -59,27 +69,36 @@ std::map<uint32_t, std::string> TLV_DICT = {
   {tlv::KeyDigest                    , "KeyDigest"},
 };
 
-void
-printTypeInfo(uint32_t type)
+const std::string&
+getTypeName(uint32_t type)
 {
-  std::cout << type << " (";
+  static const std::string RESERVED_1("RESERVED_1");
+  static const std::string APP_TAG_1("APP_TAG_1");
+  static const std::string RESERVED_3("RESERVED_3");
+  static const std::string APP_TAG_3("APP_TAG_3");
 
-  if (TLV_DICT.count(type) != 0) {
-    std::cout << TLV_DICT[type];
+  std::map<uint32_t, std::string>::const_iterator entry = TLV_DICT.find(type);
+  if (entry != TLV_DICT.end()) {
+    return entry->second;
   }
   else if (type < tlv::AppPrivateBlock1) {
-    std::cout << "RESERVED_1";
+    return RESERVED_1;
   }
   else if (tlv::AppPrivateBlock1 <= type && type < 253) {
-    std::cout << "APP_TAG_1";
+    return APP_TAG_1;
   }
   else if (253 <= type && type < tlv::AppPrivateBlock2) {
-    std::cout << "RESERVED_3";
+    return RESERVED_3;
   }
   else {
-    std::cout << "APP_TAG_3";
+    return APP_TAG_3;
   }
-  std::cout << ")";
+}
+
+void
+printTypeInfo(uint32_t type)
+{
+  std::cout << type << " (" << getTypeName(type) << ")";
 }
 
 
@@ -155,33 +174,575 @@ HexPrinter(const Block& block, const std::string& indent = "")
 void
 parseBlocksFromStream(std::istream& is)
 {
-  while (is.peek() != std::char_traits<char>::eof()) {
-    try {
-      Block block = Block::fromStream(is);
+  BlockStreamReader reader(is);
+  try {
+    Block block;
+    while (reader.read(block)) {
       BlockPrinter(block, "");
       // HexPrinter(block, "");
     }
-    catch (std::exception& e) {
-      std::cerr << "ERROR: " << e.what() << std::endl;
+  }
+  catch (std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief The whole input, mapped into memory or, if it cannot be mapped (e.g., standard
+ *        input or a pipe), read into a buffer
+ */
+class InputBuffer : noncopyable
+{
+public:
+  /**
+   * @param fileName name of the input file, or "-" for standard input
+   * @throw std::runtime_error the input cannot be opened or read
+   */
+  explicit
+  InputBuffer(const std::string& fileName)
+    : m_begin(nullptr)
+    , m_size(0)
+    , m_isMapped(false)
+  {
+    int fd = STDIN_FILENO;
+    if (fileName != "-") {
+      fd = ::open(fileName.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw std::runtime_error("cannot open " + fileName + ": " + std::strerror(errno));
     }
+
+    struct stat status;
+    if (::fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+      void* address = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED) {
+        ::madvise(address, status.st_size, MADV_SEQUENTIAL);
+        m_begin = reinterpret_cast<const uint8_t*>(address);
+        m_size = status.st_size;
+        m_isMapped = true;
+      }
+    }
+
+    if (!m_isMapped) {
+      try {
+        readAll(fd);
+      }
+      catch (const std::runtime_error&) {
+        if (fd != STDIN_FILENO)
+          ::close(fd);
+        throw;
+      }
+    }
+
+    if (fd != STDIN_FILENO)
+      ::close(fd);
+  }
+
+  ~InputBuffer()
+  {
+    if (m_isMapped)
+      ::munmap(const_cast<uint8_t*>(m_begin), m_size);
+  }
+
+  const uint8_t*
+  begin() const
+  {
+    return m_begin;
+  }
+
+  const uint8_t*
+  end() const
+  {
+    return m_begin + m_size;
+  }
+
+private:
+  void
+  readAll(int fd)
+  {
+    static const size_t CHUNK_SIZE = 1 << 20;
+    for (;;) {
+      m_buffer.resize(m_size + CHUNK_SIZE);
+      ssize_t nRead = ::read(fd, &m_buffer[m_size], CHUNK_SIZE);
+      if (nRead < 0 && errno == EINTR)
+        continue;
+      if (nRead < 0)
+        throw std::runtime_error(std::string("cannot read input: ") + std::strerror(errno));
+      if (nRead == 0)
+        break;
+      m_size += nRead;
+    }
+    m_buffer.resize(m_size);
+    m_begin = m_buffer.data();
+  }
+
+private:
+  const uint8_t* m_begin;
+  size_t m_size;
+  bool m_isMapped;
+  std::vector<uint8_t> m_buffer;
+};
+
+/**
+ * @brief Output collected in a large buffer and written to a file with few system calls
+ */
+class OutputBuffer : noncopyable
+{
+public:
+  explicit
+  OutputBuffer(std::FILE* file, size_t capacity = 1 << 20)
+    : m_file(file)
+  {
+    m_buffer.reserve(capacity);
   }
 
+  ~OutputBuffer()
+  {
+    flush();
+  }
+
+  void
+  append(const char* data, size_t size)
+  {
+    if (m_buffer.size() + size > m_buffer.capacity())
+      flush();
+    m_buffer.append(data, size);
+  }
+
+  void
+  append(const std::string& str)
+  {
+    append(str.data(), str.size());
+  }
+
+  void
+  append(char c)
+  {
+    if (m_buffer.size() == m_buffer.capacity())
+      flush();
+    m_buffer.push_back(c);
+  }
+
+  void
+  appendNumber(uint64_t number)
+  {
+    char digits[20];
+    size_t nDigits = 0;
+    do {
+      digits[sizeof(digits) - ++nDigits] = static_cast<char>('0' + number % 10);
+      number /= 10;
+    } while (number != 0);
+    append(digits + sizeof(digits) - nDigits, nDigits);
+  }
+
+  /**
+   * @brief Append @p value escaped as in name::Component::toUri
+   */
+  void
+  appendEscaped(const uint8_t* value, size_t size)
+  {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    if (std::find_if(value, value + size, [] (uint8_t x) { return x != '.'; }) == value + size) {
+      // zero or more periods are written with three additional periods
+      append("...", 3);
+      for (size_t i = 0; i < size; ++i)
+        append('.');
+      return;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+      uint8_t x = value[i];
+      if ((x >= '0' && x <= '9') || (x >= 'A' && x <= 'Z') || (x >= 'a' && x <= 'z') ||
+          x == '+' || x == '-' || x == '.' || x == '_') {
+        append(static_cast<char>(x));
+      }
+      else {
+        char escaped[] = {'%', HEX_DIGITS[x >> 4], HEX_DIGITS[x & 0xF]};
+        append(escaped, sizeof(escaped));
+      }
+    }
+  }
+
+  void
+  flush()
+  {
+    if (!m_buffer.empty()) {
+      std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+      m_buffer.clear();
+    }
+    std::fflush(m_file);
+  }
+
+private:
+  std::FILE* m_file;
+  std::string m_buffer;
+};
+
+/**
+ * @brief Position of one TLV element in the input
+ */
+struct Element
+{
+  uint32_t type;
+  const uint8_t* begin;
+  const uint8_t* valueBegin;
+  const uint8_t* end;
+};
+
+/**
+ * @brief Decode the TLV element that starts at @p begin, without throwing
+ * @return false if no complete TLV element starts at @p begin
+ */
+inline bool
+readElement(const uint8_t* begin, const uint8_t* end, Element& element)
+{
+  element.begin = begin;
+  uint64_t length = 0;
+  if (!tlv::readType(begin, end, element.type) ||
+      !tlv::readVarNumber(begin, end, length) ||
+      length > static_cast<uint64_t>(end - begin))
+    return false;
+
+  element.valueBegin = begin;
+  element.end = begin + length;
+  return true;
 }
 
-} // namespace ndn
+/**
+ * @brief Check whether [@p begin, @p end) is a non-empty sequence of complete TLV elements
+ *
+ * Values that are not are printed as leaves.  BlockPrinter differs only when Block::parse
+ * fails in the middle of a value, as it then prints the elements decoded before the failure.
+ */
+inline bool
+isElementSequence(const uint8_t* begin, const uint8_t* end)
+{
+  if (begin == end)
+    return false;
 
-int main(int argc, const char *argv[])
+  Element element;
+  while (begin != end) {
+    if (!readElement(begin, end, element))
+      return false;
+    begin = element.end;
+  }
+  return true;
+}
+
+inline void
+reportMalformed(const uint8_t* inputBegin, const uint8_t* position)
 {
-  if (argc == 1 ||
-      (argc == 2 && std::string(argv[1]) == "-"))
-    {
-      ndn::parseBlocksFromStream(std::cin);
+  std::cerr << "ERROR: malformed or truncated TLV element at offset "
+            << (position - inputBegin) << std::endl;
+}
+
+/**
+ * @brief Print the same dump as BlockPrinter, decoding the input in place and iteratively
+ * @return false if the input ends with an incomplete or malformed top-level element
+ */
+bool
+fastDump(const InputBuffer& input)
+{
+  static const std::string INDENT = "  ";
+
+  OutputBuffer output(stdout);
+  Element element;
+  // value ranges of the elements being printed, one per nesting level
+  std::vector<std::pair<const uint8_t*, const uint8_t*>> stack;
+  stack.push_back(std::make_pair(input.begin(), input.end()));
+
+  while (!stack.empty()) {
+    std::pair<const uint8_t*, const uint8_t*>& range = stack.back();
+    if (range.first == range.second) {
+      stack.pop_back();
+      continue;
     }
-  else
-    {
-      std::ifstream file(argv[1]);
-      ndn::parseBlocksFromStream(file);
+
+    // only the top-level range can contain malformed elements, nested ones have been checked
+    if (!readElement(range.first, range.second, element)) {
+      output.flush();
+      reportMalformed(input.begin(), range.first);
+      return false;
+    }
+    range.first = element.end;
+
+    size_t depth = stack.size() - 1;
+    for (size_t i = 0; i < depth; ++i)
+      output.append(INDENT);
+    output.appendNumber(element.type);
+    output.append(" (", 2);
+    output.append(getTypeName(element.type));
+    output.append(") (size: ", 9);
+    output.appendNumber(element.end - element.valueBegin);
+    output.append(')');
+
+    if (isElementSequence(element.valueBegin, element.end)) {
+      output.append('\n');
+      stack.push_back(std::make_pair(element.valueBegin, element.end));
+    }
+    else {
+      output.append(" [[", 3);
+      output.appendEscaped(element.valueBegin, element.end - element.valueBegin);
+      output.append("]]\n", 3);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Sizes of all elements of one TLV type
+ */
+struct TypeStatistics
+{
+  TypeStatistics()
+    : nElements(0)
+    , nOctets(0)
+    , minValueSize(std::numeric_limits<uint64_t>::max())
+    , maxValueSize(0)
+  {
+  }
+
+  void
+  add(const Element& element)
+  {
+    uint64_t valueSize = element.end - element.valueBegin;
+    ++nElements;
+    nOctets += element.end - element.begin;
+    minValueSize = std::min(minValueSize, valueSize);
+    maxValueSize = std::max(maxValueSize, valueSize);
+  }
+
+  uint64_t nElements;
+  uint64_t nOctets; ///< total size of the elements, including type and length
+  uint64_t minValueSize;
+  uint64_t maxValueSize;
+};
+
+/**
+ * @brief Statistics collected in one pass over the input
+ *
+ * Unlike the dump, which tries to decode every value as nested elements, statistics only
+ * descend into the types that are known to contain elements, so that octets of Content or
+ * SignatureValue are never mistaken for elements.
+ */
+class Statistics
+{
+public:
+  Statistics()
+    : m_nPackets(0)
+    , m_byType(N_DIRECT_TYPES)
+  {
+  }
+
+  /**
+   * @return false if the input ends with an incomplete or malformed element
+   */
+  bool
+  collect(const InputBuffer& input)
+  {
+    Element element;
+    std::vector<std::pair<const uint8_t*, const uint8_t*>> stack;
+    stack.push_back(std::make_pair(input.begin(), input.end()));
+
+    while (!stack.empty()) {
+      std::pair<const uint8_t*, const uint8_t*>& range = stack.back();
+      if (range.first == range.second) {
+        stack.pop_back();
+        continue;
+      }
+
+      if (!readElement(range.first, range.second, element)) {
+        reportMalformed(input.begin(), range.first);
+        return false;
+      }
+      range.first = element.end;
+
+      if (stack.size() == 1)
+        ++m_nPackets;
+      getTypeStatistics(element.type).add(element);
+      if (element.type == tlv::Name)
+        addName(element);
+      if (isContainer(element.type))
+        stack.push_back(std::make_pair(element.valueBegin, element.end));
+    }
+    return true;
+  }
+
+  void
+  print(OutputBuffer& output) const
+  {
+    output.append("packets: ");
+    output.appendNumber(m_nPackets);
+    output.append("\n\ntype: count, octets, min/max value size\n");
+    for (size_t type = 0; type < m_byType.size(); ++type)
+      printType(output, type, m_byType[type]);
+    for (const auto& entry : m_byOtherType)
+      printType(output, entry.first, entry.second);
+
+    output.append("\nname length in components: count\n");
+    for (const auto& entry : m_nameComponents) {
+      output.append("  ");
+      output.appendNumber(entry.first);
+      output.append(": ");
+      output.appendNumber(entry.second);
+      output.append('\n');
+    }
+
+    output.append("\nname length in octets: count\n");
+    for (const auto& entry : m_nameOctets) {
+      output.append("  [");
+      output.appendNumber(entry.first == 0 ? 0 : uint64_t(1) << (entry.first - 1));
+      output.append(", ");
+      output.appendNumber(uint64_t(1) << entry.first);
+      output.append("): ");
+      output.appendNumber(entry.second);
+      output.append('\n');
+    }
+  }
+
+private:
+  static bool
+  isContainer(uint32_t type)
+  {
+    switch (type) {
+      case tlv::Interest:
+      case tlv::Data:
+      case tlv::Name:
+      case tlv::Selectors:
+      case tlv::PublisherPublicKeyLocator:
+      case tlv::Exclude:
+      case tlv::MetaInfo:
+      case tlv::FinalBlockId:
+      case tlv::SignatureInfo:
+      case tlv::KeyLocator:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  TypeStatistics&
+  getTypeStatistics(uint32_t type)
+  {
+    if (type < N_DIRECT_TYPES)
+      return m_byType[type];
+    return m_byOtherType[type];
+  }
+
+  void
+  addName(const Element& name)
+  {
+    size_t nComponents = 0;
+    Element component;
+    for (const uint8_t* i = name.valueBegin; i != name.end && readElement(i, name.end, component);
+         i = component.end)
+      ++nComponents;
+    ++m_nameComponents[nComponents];
+
+    // bucket i holds the names of [2^(i-1), 2^i) octets, bucket 0 the empty ones
+    size_t bucket = 0;
+    for (uint64_t size = name.end - name.begin; size != 0; size >>= 1)
+      ++bucket;
+    ++m_nameOctets[bucket];
+  }
+
+  static void
+  printType(OutputBuffer& output, uint32_t type, const TypeStatistics& statistics)
+  {
+    if (statistics.nElements == 0)
+      return;
+
+    output.appendNumber(type);
+    output.append(" (");
+    output.append(getTypeName(type));
+    output.append("): ");
+    output.appendNumber(statistics.nElements);
+    output.append(", ");
+    output.appendNumber(statistics.nOctets);
+    output.append(", ");
+    output.appendNumber(statistics.minValueSize);
+    output.append('/');
+    output.appendNumber(statistics.maxValueSize);
+    output.append('\n');
+  }
+
+private:
+  /// types below this value are counted in a vector rather than a map
+  static const size_t N_DIRECT_TYPES = 256;
+
+  uint64_t m_nPackets;
+  std::vector<TypeStatistics> m_byType;
+  std::map<uint32_t, TypeStatistics> m_byOtherType;
+  std::map<size_t, uint64_t> m_nameComponents;
+  std::map<size_t, uint64_t> m_nameOctets;
+};
+
+int
+usage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-f] [-s] [FILE]\n"
+            << "Dump the TLV elements in FILE, or standard input if FILE is - or omitted\n\n"
+            << "  -f  fast mode: map the input into memory and buffer the output\n"
+            << "  -s  print per-type statistics and name length histograms instead of a dump\n"
+            << std::endl;
+  return 2;
+}
+
+int
+main(int argc, char** argv)
+{
+  bool isFast = false;
+  bool wantStatistics = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "fsh")) != -1) {
+    switch (opt) {
+      case 'f':
+        isFast = true;
+        break;
+      case 's':
+        wantStatistics = true;
+        break;
+      default:
+        return usage(argv[0]);
+    }
+  }
+
+  if (argc - optind > 1)
+    return usage(argv[0]);
+  std::string fileName = optind < argc ? argv[optind] : "-";
+
+  if (!isFast && !wantStatistics) {
+    if (fileName == "-") {
+      parseBlocksFromStream(std::cin);
+    }
+    else {
+      std::ifstream file(fileName.c_str(), std::ios::binary);
+      parseBlocksFromStream(file);
     }
+    return 0;
+  }
+
+  try {
+    InputBuffer input(fileName);
+    if (!wantStatistics)
+      return fastDump(input) ? 0 : 1;
+
+    Statistics statistics;
+    bool isOk = statistics.collect(input);
+    OutputBuffer output(stdout);
+    statistics.print(output);
+    return isOk ? 0 : 1;
+  }
+  catch (const std::runtime_error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+}
 
-  return 0;
+} // namespace ndn
+
+int
+main(int argc, char** argv)
+{
+  return ndn::main(argc, argv);
 }